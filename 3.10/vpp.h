@@ -33,9 +33,15 @@
 
 // Standard includes
 #include <exception>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
+#if __cplusplus >= 201103L
+#	include <atomic>
+#	include <cstring>
+#endif
+
 #ifdef VPP_VERBOSE
 #	include <iostream>
 #	define VPP_VERBOSE_MESSAGE(_MSG) std::cout << __FILE__ << ":" << __LINE__ << " (" << __FUNCTION__ << ")" << ": " << _MSG << std::endl
@@ -43,8 +49,39 @@
 #	define VPP_VERBOSE_MESSAGE(_MSG)
 #endif
 
-#ifndef VPP_DISABLE_ERROR_CHECK
-#	include <sstream>
+/* Error modes: by default, failed calls throw VirtuoseAPIError. Define
+   VPP_RESULT_ERROR_CHECK to have them return a VirtuoseResult instead
+   (no exceptions, no allocation), or VPP_DISABLE_ERROR_CHECK to just
+   return the raw code. The try* methods return a VirtuoseResult in
+   every mode. */
+#if defined(VPP_DISABLE_ERROR_CHECK) && defined(VPP_RESULT_ERROR_CHECK)
+#	error "Define at most one of VPP_DISABLE_ERROR_CHECK and VPP_RESULT_ERROR_CHECK"
+#endif
+
+#if !defined(VPP_DISABLE_ERROR_CHECK) && !defined(VPP_RESULT_ERROR_CHECK)
+#	define VPP_THROWING_ERROR_CHECK
+#endif
+
+/* Branch hints and attributes used to keep the error-handling path out of
+   the (hot) inline body of every wrapped method. */
+#if defined(__GNUC__)
+#	define VPP_UNLIKELY(_EXPR) __builtin_expect(!!(_EXPR), 0)
+#	define VPP_COLD __attribute__((noinline, cold))
+#	define VPP_NORETURN __attribute__((noreturn))
+#	define VPP_ALIGNED(_BYTES) __attribute__((aligned(_BYTES)))
+#	define VPP_WEAK __attribute__((weak))
+#elif defined(_MSC_VER)
+#	define VPP_UNLIKELY(_EXPR) (_EXPR)
+#	define VPP_COLD __declspec(noinline)
+#	define VPP_NORETURN __declspec(noreturn)
+#	define VPP_ALIGNED(_BYTES) __declspec(align(_BYTES))
+#	define VPP_WEAK
+#else
+#	define VPP_UNLIKELY(_EXPR) (_EXPR)
+#	define VPP_COLD
+#	define VPP_NORETURN
+#	define VPP_ALIGNED(_BYTES)
+#	define VPP_WEAK
 #endif
 
 /** @brief Preprocessor definition containing an integer version of the
@@ -58,71 +95,1111 @@
 */
 #define VIRTUOSEAPI_VERSION_CHECK(MAJOR, MINOR) (VIRTUOSEAPI_VERSION >= (MAJOR * 1000 + MINOR))
 
-/** @brief Object representing a VirtuoseAPI device.
+#ifdef VPP_DIRECT_DISPATCH
+/** @brief Generic function pointer type for a backend's direct entry points.
+*/
+typedef void (*VirtuoseEntryPoint)(void);
+
+/** @brief Optional backend extension, not part of the vendor library:
+	returns a function with the same signature as the VirtuoseAPI's
+	inline wrapper for @a function (e.g. virtGetPosition() for
+	GETPOSITION) that does the same thing without going through the
+	variadic virtCallDLL(), or NULL if there is none.
+
+	With VPP_DIRECT_DISPATCH defined, the hot methods (getPosition(),
+	setForce(), readState() and so on) look these up once, when the
+	first Virtuose is constructed, and call them directly. The mock
+	backend provides it; with GCC/Clang it is a weak symbol, so other
+	backends just fall back to virtCallDLL().
+*/
+extern "C" VirtuoseEntryPoint virtGetEntryPoint(int function) VPP_WEAK;
 
-	It encapsulates and manages the lifetime of the VirtContext,
-	and provides methods with names and signatures similar to the
-	C API (generated from it, with minor automated modifications).
+/** @brief Size of the direct entry point table: must exceed the largest
+	virtDLLFunction value. Define before including this header to change it.
+*/
+#	ifndef VPP_ENTRY_POINT_COUNT
+#		define VPP_ENTRY_POINT_COUNT 256
+#	endif
+#endif
 
-	This object is non-copyable and non-assignable: you may manage it
-	with a scoped_ptr or shared_ptr and allocate it on the heap if
-	those restrictions are a problem for you.
+/** @brief Error codes below this have their message copied by
+	VirtuoseMethods::getErrorMessageText() on the first lookup, and the
+	copy returned after that (in C++11). Define before including this
+	header to change it.
 */
+#ifndef VPP_ERROR_MESSAGE_CACHE_SIZE
+#	define VPP_ERROR_MESSAGE_CACHE_SIZE 64
+#endif
 
-class Virtuose {
-	public:
+/** @brief Storage for each copied message, terminator included; longer
+	messages are truncated. Define before including this header to
+	change it.
+*/
+#ifndef VPP_ERROR_MESSAGE_LENGTH
+#	define VPP_ERROR_MESSAGE_LENGTH 128
+#endif
+
+/** @brief Capacity of VirtuoseArticularVector: must be at least the
+	number of joints of the device, since the VirtuoseAPI fills one value
+	per joint. Define before including this header to change it.
+*/
+#ifndef VPP_MAX_ARTICULAR_AXES
+#	define VPP_MAX_ARTICULAR_AXES 8
+#endif
+
+/** @brief Fixed-size array of floats as passed to and from the
+	VirtuoseAPI, returned by value from the overloads of getters like
+	Virtuose::getPosition() that take no arguments.
+
+	This is a plain aggregate (trivially copyable, no constructor) aligned
+	to 16 bytes, so it can be kept in registers or loaded into SIMD lanes,
+	and returning one costs nothing more than the raw C call writing into
+	a local array. The Tag parameter just keeps, for instance, twists and
+	wrenches from being mixed up.
+*/
+template<int N, typename Tag>
+struct VPP_ALIGNED(16) VirtuoseFloatArray {
+	enum { size = N };
+
+	float data[N];
+
+	float & operator[](int i) {
+		return data[i];
+	}
+
+	float const& operator[](int i) const {
+		return data[i];
+	}
+};
+
+struct VirtuoseDisplacementTag;
+struct VirtuoseTwistTag;
+struct VirtuoseWrenchTag;
+struct VirtuoseArticularTag;
+
+/// @brief Position and orientation: x, y, z, then quaternion qx, qy, qz, qw.
+typedef VirtuoseFloatArray<7, VirtuoseDisplacementTag> VirtuoseDisplacement;
+
+/// @brief Linear then angular velocity.
+typedef VirtuoseFloatArray<6, VirtuoseTwistTag> VirtuoseTwist;
+
+/// @brief Force then torque.
+typedef VirtuoseFloatArray<6, VirtuoseWrenchTag> VirtuoseWrench;
+
+/// @brief One value per joint; only the device's joint count are meaningful.
+typedef VirtuoseFloatArray<VPP_MAX_ARTICULAR_AXES, VirtuoseArticularTag> VirtuoseArticularVector;
+
+/** @brief Default number of buttons sampled by Virtuose::readState().
+	Define before including this header to change it.
+*/
+#ifndef VPP_STATE_BUTTON_COUNT
+#	define VPP_STATE_BUTTON_COUNT 3
+#endif
+
+/** @brief Snapshot of the device state a servo tick usually needs,
+	filled by Virtuose::readState().
+*/
+struct VirtuoseState {
+	VirtuoseDisplacement position;
+	VirtuoseTwist speed;
+	/// Bit i is set if button i is pressed.
+	unsigned int buttons;
+	int deadMan;
+	int emergencyStop;
+	int powerOn;
+	unsigned int timeLastUpdate;
+
+	bool button(int i) const {
+		return ((buttons >> i) & 1u) != 0;
+	}
+};
+
+/** @brief Per-tick command, sent by Virtuose::writeCommand(). Only the
+	members flagged in @a fields are sent.
+*/
+struct VirtuoseCommand {
+	enum Field {
+		Force = 1,
+		Position = 2,
+		Speed = 4
+	};
+
+	/// Bitwise or of Field values.
+	unsigned int fields;
+	VirtuoseWrench force;
+	VirtuoseDisplacement position;
+	VirtuoseTwist speed;
+};
+
+/** @brief Outcome of a wrapped call, reporting an error by value instead
+	of by exception.
+
+	Returned by the try* variant of every wrapped method (for instance
+	Virtuose::tryGetPosition()), and by the methods themselves when
+	VPP_RESULT_ERROR_CHECK is defined. Nothing is allocated: the error
+	code is only fetched, with virtGetErrorCode(), when the call failed,
+	and only turned into a string if you pass it to
+	VirtuoseMethods::getErrorMessage(int).
+*/
+struct VirtuoseResult {
+	/// What the VirtuoseAPI function returned: 0 on success.
+	int returnValue;
+	/// VIRT_E_NO_ERROR on success, otherwise the device's error code.
+	int errorCode;
+
+	bool ok() const {
+		return returnValue == 0;
+	}
+
+	/// @brief So code written against the int-returning methods still compiles.
+	operator int() const {
+		return returnValue;
+	}
+};
+
+/** @brief A value from a by-value getter together with the VirtuoseResult
+	of the call, as returned by for instance Virtuose::tryGetPosition().
+
+	It derives from the value type, so it can be used (or sliced) as one;
+	the value is unspecified unless ok() is true.
+*/
+template<typename T>
+struct VirtuoseExpected : T, VirtuoseResult {
+	T & value() {
+		return *this;
+	}
+
+	T const& value() const {
+		return *this;
+	}
+};
+
+/// @brief What wrapped methods that return an error code return in this error mode.
+#ifdef VPP_RESULT_ERROR_CHECK
+typedef VirtuoseResult VirtuoseStatus;
+#else
+typedef int VirtuoseStatus;
+#endif
 
-#ifndef VPP_DISABLE_ERROR_CHECK
-#	define VPP_CHECKED_CALL(_CALL) _checkReturnCode(_CALL, #_CALL, __FILE__, __LINE__, __FUNCTION__)
+/// @brief What by-value getters return for a T in this error mode.
+template<typename T>
+struct VirtuoseValue {
+#ifdef VPP_RESULT_ERROR_CHECK
+	typedef VirtuoseExpected<T> type;
 #else
-#	define VPP_CHECKED_CALL(_CALL)
+	typedef T type;
 #endif
+};
 
-		struct VirtuoseAPIError : public std::runtime_error {
-			VirtuoseAPIError(std::string const& what) : std::runtime_error(what) {}
+#if defined(VPP_PROFILE) || defined(VPP_TRACE)
+/// @brief The names VPP_PROFILE and VPP_TRACE give the wrapped methods,
+/// and periodicTick for a periodic function set by BasicVirtuose.
+namespace vpp_profile {
+	enum Method {
+		APIVersion,
+		attachVO,
+		attachQSVO,
+		attachVOAvatar,
+		detachVO,
+		detachVOAvatar,
+		displayHardwareStatus,
+		getBaseFrame,
+		getButton,
+		getCommandType,
+		getDeadMan,
+		getEmergencyStop,
+		getError,
+		getErrorCode,
+		getForce,
+		getForceFactor,
+		getIndexingMode,
+		getLimitTorque,
+		getObservationFrame,
+		getPosition,
+		getPowerOn,
+		getSpeed,
+		getSpeedFactor,
+		getTimeLastUpdate,
+		getTimeoutValue,
+		setBaseFrame,
+		setCommandType,
+		setDebugFlags,
+		setForce,
+		setForceFactor,
+		setIndexingMode,
+		setLimitTorque,
+		setObservationFrame,
+		setObservationFrameSpeed,
+		setOutputFile,
+		setPeriodicFunction,
+		setPosition,
+		setPowerOn,
+		setSpeed,
+		setSpeedFactor,
+		setTexture,
+		setTextureForce,
+		setTimeStep,
+		setTimeoutValue,
+		startLoop,
+		stopLoop,
+		waitForSynch,
+		trajRecordStart,
+		trajRecordStop,
+		trajSetSamplingTimeStep,
+		vmStartTrajSampling,
+		vmGetTrajSamples,
+		vmSetType,
+		vmSetParameter,
+		vmActivate,
+		vmDeactivate,
+		vmSetBaseFrame,
+		vmSetMaxArtiBounds,
+		vmSetMinArtiBounds,
+		getPhysicalPosition,
+		getAvatarPosition,
+		saturateTorque,
+		vmSetDefaultToTransparentMode,
+		vmSetDefaultToCartesianPosition,
+		vmSetBaseFrameToCurrentFrame,
+		convertRGBToGrayscale,
+		vmGetBaseFrame,
+		waitPressButton,
+		getTimeStep,
+		vmSetRobotMode,
+		vmSaveCurrentSpline,
+		vmLoadSpline,
+		vmDeleteSpline,
+		vmWaitUpperBound,
+		disableControlConnexion,
+		isInBounds,
+		getAlarm,
+		getCatchFrame,
+		setCatchFrame,
+		activeSpeedControl,
+		deactiveSpeedControl,
+		isInShiftPosition,
+		setFrictionForce,
+		getMouseState,
+		generateDebugFile,
+		getCenterSphere,
+		getAxisOfRotation,
+		getADC,
+		convertDisplacementToTransformMatrix,
+		convertTransformMatrixToDisplacement,
+		getTrackball,
+		getTrackballButton,
+		setAbsolutePosition,
+		beepOnLimit,
+		enableForceFeedback,
+		getPhysicalSpeed,
+		forceShiftButton,
+		addForce,
+		readState,
+		writeCommand,
+		periodicTick,
+		methodCount
+	};
+
+	inline const char * methodName(int method) {
+		static const char * const names[] = {
+			"APIVersion",
+			"attachVO",
+			"attachQSVO",
+			"attachVOAvatar",
+			"detachVO",
+			"detachVOAvatar",
+			"displayHardwareStatus",
+			"getBaseFrame",
+			"getButton",
+			"getCommandType",
+			"getDeadMan",
+			"getEmergencyStop",
+			"getError",
+			"getErrorCode",
+			"getForce",
+			"getForceFactor",
+			"getIndexingMode",
+			"getLimitTorque",
+			"getObservationFrame",
+			"getPosition",
+			"getPowerOn",
+			"getSpeed",
+			"getSpeedFactor",
+			"getTimeLastUpdate",
+			"getTimeoutValue",
+			"setBaseFrame",
+			"setCommandType",
+			"setDebugFlags",
+			"setForce",
+			"setForceFactor",
+			"setIndexingMode",
+			"setLimitTorque",
+			"setObservationFrame",
+			"setObservationFrameSpeed",
+			"setOutputFile",
+			"setPeriodicFunction",
+			"setPosition",
+			"setPowerOn",
+			"setSpeed",
+			"setSpeedFactor",
+			"setTexture",
+			"setTextureForce",
+			"setTimeStep",
+			"setTimeoutValue",
+			"startLoop",
+			"stopLoop",
+			"waitForSynch",
+			"trajRecordStart",
+			"trajRecordStop",
+			"trajSetSamplingTimeStep",
+			"vmStartTrajSampling",
+			"vmGetTrajSamples",
+			"vmSetType",
+			"vmSetParameter",
+			"vmActivate",
+			"vmDeactivate",
+			"vmSetBaseFrame",
+			"vmSetMaxArtiBounds",
+			"vmSetMinArtiBounds",
+			"getPhysicalPosition",
+			"getAvatarPosition",
+			"saturateTorque",
+			"vmSetDefaultToTransparentMode",
+			"vmSetDefaultToCartesianPosition",
+			"vmSetBaseFrameToCurrentFrame",
+			"convertRGBToGrayscale",
+			"vmGetBaseFrame",
+			"waitPressButton",
+			"getTimeStep",
+			"vmSetRobotMode",
+			"vmSaveCurrentSpline",
+			"vmLoadSpline",
+			"vmDeleteSpline",
+			"vmWaitUpperBound",
+			"disableControlConnexion",
+			"isInBounds",
+			"getAlarm",
+			"getCatchFrame",
+			"setCatchFrame",
+			"activeSpeedControl",
+			"deactiveSpeedControl",
+			"isInShiftPosition",
+			"setFrictionForce",
+			"getMouseState",
+			"generateDebugFile",
+			"getCenterSphere",
+			"getAxisOfRotation",
+			"getADC",
+			"convertDisplacementToTransformMatrix",
+			"convertTransformMatrixToDisplacement",
+			"getTrackball",
+			"getTrackballButton",
+			"setAbsolutePosition",
+			"beepOnLimit",
+			"enableForceFeedback",
+			"getPhysicalSpeed",
+			"forceShiftButton",
+			"addForce",
+			"readState",
+			"writeCommand",
+			"periodicTick"
 		};
+		return names[method];
+	}
+} // end of namespace vpp_profile
+#endif
 
-		/** @brief constructor
+#ifdef VPP_PROFILE
+#	include <algorithm>
+#	include <cstdlib>
+#	include <cstring>
+#	include <iomanip>
+#	include <ostream>
+#	include <stdint.h>
+#	if !defined(VPP_PROFILE_CLOCK_GETTIME) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#		define VPP_PROFILE_RDTSC
+#		ifdef _MSC_VER
+#			include <intrin.h>
+#		else
+#			include <x86intrin.h>
+#		endif
+#	endif
+#	if defined(_MSC_VER) || __cplusplus >= 201103L
+#		include <chrono>
+#	endif
+#	ifndef _MSC_VER
+#		include <time.h>
+#	endif
+#	if __cplusplus >= 201103L
+#		define VPP_THREAD_LOCAL thread_local
+#	elif defined(_MSC_VER)
+#		define VPP_THREAD_LOCAL __declspec(thread)
+#	else
+#		define VPP_THREAD_LOCAL __thread
+#	endif
+
+/** @brief Most threads whose calls VPP_PROFILE records; calls from
+	threads past this many are left out (and counted as such). Define
+	before including this header to change it.
+*/
+#	ifndef VPP_PROFILE_MAX_THREADS
+#		define VPP_PROFILE_MAX_THREADS 16
+#	endif
+
+/** @brief Call counters and latency histograms for every wrapped method,
+	compiled in only when VPP_PROFILE is defined.
+
+	Each wrapped method (and its try* variant) times its VirtuoseAPI call
+	with the timestamp counter on x86 (not serialized: fine for ranking
+	calls, not for timing a few instructions), or clock_gettime()
+	elsewhere or with VPP_PROFILE_CLOCK_GETTIME defined. The count, total,
+	maximum and a power-of-two histogram of the times go to the calling
+	thread's own slot, padded to a cache line, so threads never share
+	one: recording is a few adds, with no lock or atomic operation.
+
+	report() adds up every thread's slots and prints a table, busiest
+	method first:
+
+	@code
+	vpp_profile::report(std::cerr);
+	@endcode
+
+	Slots are never freed, so the report includes threads that exited.
+	Reading them while profiled calls are being made gives counts that
+	may be a few calls off.
+*/
+namespace vpp_profile {
+	/// @brief Histogram buckets: bucket b counts times of b significant bits.
+	enum { bucketCount = 32 };
+
+	/// @brief One thread's counters for one method.
+	struct VPP_ALIGNED(64) Slot {
+		uint64_t calls;
+		uint64_t totalTicks;
+		uint64_t maxTicks;
+		uint64_t buckets[bucketCount];
+	};
+
+	struct ThreadSlots {
+		Slot methods[methodCount];
+	};
+
+	/// @brief Counters of a method, added up over every thread.
+	struct Totals {
+		uint64_t calls;
+		uint64_t totalTicks;
+		uint64_t maxTicks;
+		uint64_t buckets[bucketCount];
+	};
+
+	inline uint64_t now() {
+#	ifdef VPP_PROFILE_RDTSC
+		return __rdtsc();
+#	else
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+#	endif
+	}
 
-			Opens a new VirtContext upon construction.
+	/// @brief Wall-clock time, to calibrate the timestamp counter against.
+	inline double _wallSeconds() {
+#	if defined(_MSC_VER) || __cplusplus >= 201103L
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#	else
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+#	endif
+	}
 
-			@param name Name of Virtuose device to connect to.
+#	ifdef VPP_PROFILE_RDTSC
+	/// @brief Measures the rate of now() over 20 ms.
+	inline double _measureTicksPerSecond() {
+		double start = _wallSeconds();
+		uint64_t ticks = now();
+		double end;
+		do {
+			end = _wallSeconds();
+		} while (end - start < 0.02);
+		return static_cast<double>(now() - ticks) / (end - start);
+	}
+#	endif
+
+	/// @brief Rate of now(), measured the first time.
+	inline double ticksPerSecond() {
+#	ifdef VPP_PROFILE_RDTSC
+		// Initialized once, even if several threads report at once.
+		static const double rate = _measureTicksPerSecond();
+		return rate;
+#	else
+		return 1e9;
+#	endif
+	}
 
-			@throws VirtuoseAPIError if opening the device failed.
-		*/
-		Virtuose(const std::string & name)
-			: vc_(virtOpen(name.c_str()))
-			, name_(name)
-			, own_(true) {
-			VPP_VERBOSE_MESSAGE("Constructing a new Virtuose object, device named " << name_ << ", VirtContext=" << vc_);
-			if (!vc_) {
-				throw VirtuoseAPIError("Failed opening Virtuose " + name_ + ": " +  getErrorMessage());
+	/// @brief Registered threads' slots, and how many threads were left out.
+	struct Registry {
+#	if __cplusplus >= 201103L
+		std::atomic<ThreadSlots *> threads[VPP_PROFILE_MAX_THREADS];
+		std::atomic<unsigned int> claimed;
+#	else
+		ThreadSlots * volatile threads[VPP_PROFILE_MAX_THREADS];
+		unsigned int volatile claimed;
+#	endif
+	};
+
+	/// @brief Zero-initialized, so there's no initialization to race on.
+	inline Registry & registry() {
+		static Registry r;
+		return r;
+	}
+
+	/// @brief Slots of the @a index th registered thread, or NULL if it
+	/// hasn't finished registering.
+	inline ThreadSlots * _slots(unsigned int index) {
+#	if __cplusplus >= 201103L
+		return registry().threads[index].load(std::memory_order_acquire);
+#	else
+		return registry().threads[index];
+#	endif
+	}
+
+	inline unsigned int _claimIndex() {
+#	if __cplusplus >= 201103L
+		return registry().claimed.fetch_add(1);
+#	elif defined(_MSC_VER)
+		return static_cast<unsigned int>(_InterlockedIncrement(reinterpret_cast<long volatile *>(&registry().claimed))) - 1;
+#	else
+		return __sync_fetch_and_add(&registry().claimed, 1u);
+#	endif
+	}
+
+	inline ThreadSlots * _registerThread() {
+		unsigned int index = _claimIndex();
+		if (index >= VPP_PROFILE_MAX_THREADS) {
+			return NULL;
+		}
+		// Never freed: the report includes threads that exited.
+		void * raw = std::malloc(sizeof(ThreadSlots) + 64);
+		if (!raw) {
+			return NULL;
+		}
+		ThreadSlots * slots = reinterpret_cast<ThreadSlots *>((reinterpret_cast<std::size_t>(raw) + 64) & ~static_cast<std::size_t>(63));
+		std::memset(slots, 0, sizeof(ThreadSlots));
+#	if __cplusplus >= 201103L
+		registry().threads[index].store(slots, std::memory_order_release);
+#	else
+		registry().threads[index] = slots;
+#	endif
+		return slots;
+	}
+
+	/// @brief The calling thread's slots, or NULL if it was left out.
+	inline ThreadSlots * threadSlots() {
+		static VPP_THREAD_LOCAL ThreadSlots * mine = NULL;
+		static VPP_THREAD_LOCAL bool registered = false;
+		if (VPP_UNLIKELY(!registered)) {
+			registered = true;
+			mine = _registerThread();
+		}
+		return mine;
+	}
+
+	inline unsigned int bucket(uint64_t ticks) {
+#	ifdef __GNUC__
+		unsigned int bits = ticks ? 64u - static_cast<unsigned int>(__builtin_clzll(ticks)) : 0u;
+#	else
+		unsigned int bits = 0;
+		while (ticks >> bits) {
+			++bits;
+		}
+#	endif
+		return bits < bucketCount ? bits : bucketCount - 1;
+	}
+
+	inline void record(int method, uint64_t ticks) {
+		ThreadSlots * slots = threadSlots();
+		if (!slots) {
+			return;
+		}
+		Slot & s = slots->methods[method];
+		++s.calls;
+		s.totalTicks += ticks;
+		if (ticks > s.maxTicks) {
+			s.maxTicks = ticks;
+		}
+		++s.buckets[bucket(ticks)];
+	}
+
+	inline unsigned int threadCount() {
+		unsigned int claimed = registry().claimed;
+		return claimed < VPP_PROFILE_MAX_THREADS ? claimed : VPP_PROFILE_MAX_THREADS;
+	}
+
+	/// @brief Threads whose calls were left out: VPP_PROFILE_MAX_THREADS is too low.
+	inline unsigned int droppedThreadCount() {
+		unsigned int claimed = registry().claimed;
+		return claimed > VPP_PROFILE_MAX_THREADS ? claimed - VPP_PROFILE_MAX_THREADS : 0;
+	}
+
+	inline Totals totals(int method) {
+		Totals t;
+		std::memset(&t, 0, sizeof(t));
+		for (unsigned int i = 0; i < threadCount(); ++i) {
+			ThreadSlots * slots = _slots(i);
+			if (!slots) {
+				continue;
+			}
+			Slot const& s = slots->methods[method];
+			t.calls += s.calls;
+			t.totalTicks += s.totalTicks;
+			t.maxTicks = std::max(t.maxTicks, s.maxTicks);
+			for (int b = 0; b < bucketCount; ++b) {
+				t.buckets[b] += s.buckets[b];
 			}
 		}
+		return t;
+	}
 
-		/** @brief constructor from existing VirtContext
+	/// @brief Upper bound of the bucket holding the @a p th percentile, in ticks.
+	inline uint64_t percentileTicks(Totals const& t, double p) {
+		uint64_t rank = static_cast<uint64_t>(p / 100. * static_cast<double>(t.calls) + 0.5);
+		uint64_t seen = 0;
+		for (int b = 0; b < bucketCount; ++b) {
+			seen += t.buckets[b];
+			if (seen >= rank && seen > 0) {
+				return std::min(b == 0 ? 0 : (static_cast<uint64_t>(1) << b) - 1, t.maxTicks);
+			}
+		}
+		return t.maxTicks;
+	}
 
-			Does not open new VirtContext. Intended for use inside a
-			periodic callback function.
+	/// @brief Zeroes every thread's counters. Only while no thread is
+	/// making profiled calls: a call being recorded would be torn.
+	inline void reset() {
+		for (unsigned int i = 0; i < threadCount(); ++i) {
+			if (ThreadSlots * slots = _slots(i)) {
+				std::memset(slots, 0, sizeof(ThreadSlots));
+			}
+		}
+	}
 
-			@param name Name of Virtuose device to connect to.
+	struct _ByTotalTicks {
+		Totals const * totals;
+		bool operator()(int a, int b) const {
+			return totals[a].totalTicks > totals[b].totalTicks;
+		}
+	};
+
+	/// @brief Prints the methods called so far, busiest first.
+	inline void report(std::ostream & os) {
+		Totals all[methodCount];
+		int order[methodCount];
+		int called = 0;
+		for (int m = 0; m < methodCount; ++m) {
+			all[m] = totals(m);
+			if (all[m].calls) {
+				order[called++] = m;
+			}
+		}
+		_ByTotalTicks byTotal = {all};
+		std::sort(order, order + called, byTotal);
+		double nsPerTick = 1e9 / ticksPerSecond();
+		std::ios::fmtflags flags = os.flags();
+		os << "VirtuoseAPI calls from " << threadCount() << " thread(s)";
+		if (droppedThreadCount()) {
+			os << ", " << droppedThreadCount() << " more left out";
+		}
+		os << "; percentiles are bucket upper bounds\n"
+		   << std::left << std::setw(36) << "method" << std::right
+		   << std::setw(12) << "calls" << std::setw(12) << "total ms" << std::setw(10) << "mean ns"
+		   << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(12) << "max ns" << "\n"
+		   << std::fixed;
+		for (int i = 0; i < called; ++i) {
+			Totals const& t = all[order[i]];
+			os << std::left << std::setw(36) << methodName(order[i]) << std::right
+			   << std::setw(12) << t.calls
+			   << std::setw(12) << std::setprecision(3) << t.totalTicks * nsPerTick * 1e-6
+			   << std::setw(10) << std::setprecision(1) << t.totalTicks * nsPerTick / t.calls
+			   << std::setw(10) << std::setprecision(0) << percentileTicks(t, 50) * nsPerTick
+			   << std::setw(10) << percentileTicks(t, 99) * nsPerTick
+			   << std::setw(12) << t.maxTicks * nsPerTick << "\n";
+		}
+		os.flags(flags);
+	}
+} // end of namespace vpp_profile
+#endif
 
-			@throws VirtuoseAPIError if opening the device failed.
-		*/
-		Virtuose(VirtContext vc)
-			: vc_(vc)
-			, name_("unknown - from VirtContext")
-			, own_(false) {
-			VPP_VERBOSE_MESSAGE("Borrowing a Virtuose object with VirtContext=" << vc_);
-			if (!vc_) {
-				throw VirtuoseAPIError("Can't borrow a null VirtContext!");
+#ifdef VPP_TRACE
+#	if __cplusplus < 201103L && !defined(_MSC_VER)
+#		error "VPP_TRACE requires C++11"
+#	endif
+#	include <atomic>
+#	include <chrono>
+#	include <stdint.h>
+
+/** @brief Hands the start and end of every wrapped method's VirtuoseAPI
+	call, and of every tick of a periodic function set through
+	BasicVirtuose::setPeriodicFunction(), to a sink; compiled in only
+	when VPP_TRACE is defined (for every file including this header).
+
+	VirtuoseTraceWriter, in extras/vpp-trace.h, installs a sink queuing
+	the calls for a Chrome trace file. With no sink installed, tracing
+	costs a call one atomic load.
+*/
+namespace vpp_trace {
+	/// @brief Receives a vpp_profile::Method and its steady_clock
+	/// times in nanoseconds, on the calling thread.
+	typedef void (*Sink)(int method, int64_t beginNs, int64_t endNs);
+
+	/// @brief The installed sink, or NULL.
+	inline std::atomic<Sink> & sink() {
+		static std::atomic<Sink> s(NULL);
+		return s;
+	}
+
+	inline int64_t nowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+} // end of namespace vpp_trace
+#endif
+
+#if defined(VPP_PROFILE) || defined(VPP_TRACE)
+namespace vpp_profile {
+	/// @brief Times the VirtuoseAPI call made while it exists, for
+	/// VPP_PROFILE, VPP_TRACE or both.
+	class Scope {
+		public:
+			explicit Scope(int method) : method_(method)
+#	ifdef VPP_TRACE
+				, sink_(::vpp_trace::sink().load(std::memory_order_acquire))
+				, beginNs_(sink_ ? ::vpp_trace::nowNs() : 0)
+#	endif
+#	ifdef VPP_PROFILE
+				, start_(now())
+#	endif
+			{}
+
+			~Scope() {
+#	ifdef VPP_PROFILE
+				record(method_, now() - start_);
+#	endif
+#	ifdef VPP_TRACE
+				if (sink_) {
+					sink_(method_, beginNs_, ::vpp_trace::nowNs());
+				}
+#	endif
 			}
+
+		private:
+			int method_;
+#	ifdef VPP_TRACE
+			::vpp_trace::Sink sink_;
+			int64_t beginNs_;
+#	endif
+#	ifdef VPP_PROFILE
+			uint64_t start_;
+#	endif
+	};
+} // end of namespace vpp_profile
+
+#	define VPP_PROFILE_CALL(_METHOD, _CALL) (::vpp_profile::Scope(::vpp_profile::_METHOD), (_CALL))
+#else
+#	define VPP_PROFILE_CALL(_METHOD, _CALL) (_CALL)
+#endif
+
+/** @brief The backend of Virtuose: the functions of the VirtuoseAPI
+	header, as static member functions with the same names.
+
+	BasicVirtuose, BasicVirtuoseRef and BasicVirtuoseMethods take their
+	backend as a template parameter and call it as, for instance,
+	Backend::virtGetPosition(vc, pos): the call is resolved at compile
+	time, so a backend adds no virtual call or function pointer to the
+	wrapper. Virtuose, VirtuoseRef and VirtuoseMethods use this one.
+
+	Another backend only needs the functions that actually get called,
+	plus virtOpen(), virtClose(), virtGetErrorCode() and
+	virtGetErrorMessage(). The easiest way to write one is to derive from
+	this struct and hide the functions to replace:
+
+	@code
+	struct CountingBackend : VirtuoseAPIBackend {
+		static int virtSetForce(VirtContext VC, float *force) {
+			++forcesSent;
+			return VirtuoseAPIBackend::virtSetForce(VC, force);
 		}
+		static unsigned long forcesSent;
+	};
+	typedef BasicVirtuose<CountingBackend> CountingVirtuose;
+	@endcode
+*/
+struct VirtuoseAPIBackend {
+	/** @brief Opens a device. With VPP_DIRECT_DISPATCH, also looks up
+		the direct entry points, the first time it is called.
+	*/
+	static VirtContext virtOpen(const char *nom) {
+#ifdef VPP_DIRECT_DISPATCH
+		resolveEntryPoints();
+#endif
+		return ::virtOpen(nom);
+	}
 
-		/** @brief destructor that closes the connection to the Virtuose
-			device if we opened it.
+	static int virtAPIVersion(int *major, int *minor);
+	static int virtAttachVO(VirtContext VC, float mass, float *mxmymz);
+	static int virtAttachQSVO(VirtContext VC, float *Ks, float *Bs);
+	static int virtAttachVOAvatar(VirtContext VC, float mass, float *mxmymz);
+	static int virtClose(VirtContext VC);
+	static int virtDetachVO(VirtContext VC);
+	static int virtDetachVOAvatar(VirtContext VC);
+	static int virtDisplayHardwareStatus(VirtContext VC, FILE *fh);
+	static int virtGetBaseFrame(VirtContext VC, float *base);
+	static int virtGetButton(VirtContext VC, int button_number, int *state);
+	static int virtGetCommandType(VirtContext VC, VirtCommandType *type);
+	static int virtGetDeadMan(VirtContext VC, int *dead_man);
+	static int virtGetEmergencyStop(VirtContext VC, int *emergency_stop);
+	static int virtGetError(VirtContext VC, int *error);
+	static int virtGetErrorCode(VirtContext VC);
+	static char * virtGetErrorMessage(int code);
+	static int virtGetForce(VirtContext VC, float *force);
+	static int virtGetForceFactor(VirtContext VC, float *force_factor);
+	static int virtGetIndexingMode(VirtContext VC, VirtIndexingType *indexing_mode);
+	static int virtGetLimitTorque(VirtContext VC, float *torque);
+	static int virtGetObservationFrame(VirtContext VC, float *obs);
+	static int virtGetPosition(VirtContext VC, float *pos);
+	static int virtGetPowerOn(VirtContext VC, int *power);
+	static int virtGetSpeed(VirtContext VC, float *speed);
+	static int virtGetSpeedFactor(VirtContext VC, float *speed_factor);
+	static int virtGetTimeLastUpdate(VirtContext VC, unsigned int *time);
+	static int virtGetTimeoutValue(VirtContext VC, float *time_value);
+	static int virtSetBaseFrame(VirtContext VC, float *base);
+	static int virtSetCommandType(VirtContext VC, VirtCommandType type);
+	static int virtSetDebugFlags(VirtContext VC, unsigned short flag);
+	static int virtSetForce(VirtContext VC, float *force);
+	static int virtSetForceFactor(VirtContext VC, float force_factor);
+	static int virtSetIndexingMode(VirtContext VC, VirtIndexingType indexing_mode);
+	static int virtSetLimitTorque(VirtContext VC, float torque);
+	static int virtSetObservationFrame(VirtContext VC, float *obs);
+	static int virtSetObservationFrameSpeed(VirtContext VC, float *speed);
+	static int virtSetOutputFile(VirtContext VC, char *name);
+	static int virtSetPeriodicFunction(VirtContext VC, void (*fn)(VirtContext, void *), float *period, void *arg);
+	static int virtSetPosition(VirtContext VC, float *pos);
+	static int virtSetPowerOn(VirtContext VC, int power);
+	static int virtSetSpeed(VirtContext VC, float *speed);
+	static int virtSetSpeedFactor(VirtContext VC, float speed_factor);
+	static int virtSetTexture(VirtContext VC, float *position, float *intensity, int reinit);
+	static int virtSetTextureForce(VirtContext VC, float *texture_force);
+	static int virtSetTimeStep(VirtContext VC, float step);
+	static int virtSetTimeoutValue(VirtContext VC, float time_value);
+	static int virtStartLoop(VirtContext VC);
+	static int virtStopLoop(VirtContext VC);
+	static int virtWaitForSynch(VirtContext VC);
+	static int virtTrajRecordStart(VirtContext VC);
+	static int virtTrajRecordStop(VirtContext VC);
+	static int virtTrajSetSamplingTimeStep(VirtContext VC, float timeStep, unsigned int *recordTime);
+	static int virtVmStartTrajSampling(VirtContext VC, unsigned int nbSamples);
+	static int virtVmGetTrajSamples(VirtContext VC, float *samples);
+	static int virtVmSetType(VirtContext VC, VirtVmType type);
+	static int virtVmSetParameter(VirtContext VC, VirtVmParameter *param);
+	static int virtVmActivate(VirtContext VC);
+	static int virtVmDeactivate(VirtContext VC);
+	static int virtVmSetBaseFrame(VirtContext VC, float *base);
+	static int virtVmSetMaxArtiBounds(VirtContext VC, float *bounds);
+	static int virtVmSetMinArtiBounds(VirtContext VC, float *bounds);
+	static int virtGetPhysicalPosition(VirtContext VC, float *pos);
+	static int virtGetAvatarPosition(VirtContext VC, float *pos);
+	static int virtSaturateTorque(VirtContext VC, float forceThreshold, float momentThreshold);
+	static int virtVmSetDefaultToTransparentMode(VirtContext VC);
+	static int virtVmSetDefaultToCartesianPosition(VirtContext VC);
+	static int virtVmSetBaseFrameToCurrentFrame(VirtContext VC);
+	static int virtConvertRGBToGrayscale(VirtContext VC, float *rgb, float *gray);
+	static int virtVmGetBaseFrame(VirtContext VC, float *base);
+	static int virtWaitPressButton(VirtContext VC, int button_number);
+	static int virtGetTimeStep(VirtContext VC, float *step);
+	static int virtVmSetRobotMode(VirtContext VC, int OnOff);
+	static int virtVmSaveCurrentSpline(VirtContext VC, char *file_name);
+	static int virtVmLoadSpline(VirtContext VC, char *file_name);
+	static int virtVmDeleteSpline(VirtContext VC, char *file_name);
+	static int virtVmWaitUpperBound(VirtContext VC);
+	static int virtDisableControlConnexion(VirtContext VC, int disable);
+	static int virtIsInBounds(VirtContext VC, unsigned int *bounds);
+	static int virtGetAlarm(VirtContext VC, unsigned int *alarm);
+	static int virtGetCatchFrame(VirtContext VC, float *frame);
+	static int virtSetCatchFrame(VirtContext VC, float *frame);
+	static int virtActiveSpeedControl(VirtContext VC, float radius, float speedFactor);
+	static int virtDeactiveSpeedControl(VirtContext VC);
+	static int virtIsInShiftPosition(VirtContext VC, int *shift);
+	static int virtSetFrictionForce(VirtContext VC, float fx, float fy, float fz);
+	static int virtGetMouseState(VirtContext VC, int *active, int *left_click, int *right_click);
+	static int virtGenerateDebugFile(VirtContext VC);
+	static int virtGetCenterSphere(VirtContext VC, float *pos);
+	static int virtGetAxisOfRotation(VirtContext VC, float *axis);
+	static int virtGetADC(VirtContext VC, int line, float *adc);
+	static int virtConvertDeplToHomogeneMatrix(VirtContext VC, float *d, float *m);
+	static int virtConvertHomogeneMatrixToDepl(VirtContext VC, float *d, float *m);
+	static int virtGetTrackball(VirtContext VC, int *x_move, int *y_move);
+	static int virtGetTrackballButton(VirtContext VC, int *active, int *left_btn, int *middle_btn, int *right_btn);
+	static int virtSetAbsolutePosition(VirtContext VC, float *pos);
+	static int virtBeepOnLimit(VirtContext VC, int enable);
+	static int virtEnableForceFeedback(VirtContext VC, int enable);
+	static int virtGetPhysicalSpeed(VirtContext VC, float *speed);
+	static int virtForceShiftButton(VirtContext VC, int forceShiftButton);
+	static int virtAddForce(VirtContext VC, float *force);
+
+#ifdef VPP_DIRECT_DISPATCH
+	/** @brief Fills the direct entry point table, the first time only.
+
+		virtOpen() calls it: call it yourself before using a VirtContext
+		opened some other way, or its hot calls go through virtCallDLL().
+	*/
+	static void resolveEntryPoints() {
+		static bool const resolved = _fillEntryPoints();
+		(void) resolved;
+	}
+
+	/// @brief Direct entry points, indexed by virtDLLFunction.
+	static VirtuoseEntryPoint * _entryPoints() {
+		static VirtuoseEntryPoint table[VPP_ENTRY_POINT_COUNT];
+		return table;
+	}
+
+	static bool _fillEntryPoints() {
+		if (virtGetEntryPoint) {
+			for (int i = 0; i < VPP_ENTRY_POINT_COUNT; ++i) {
+				_entryPoints()[i] = virtGetEntryPoint(i);
+			}
+		}
+		return true;
+	}
+#endif
+};
+
+/** @brief Exception thrown by the wrapped methods when a call fails,
+	also available as Virtuose::VirtuoseAPIError.
+
+	Throwing one from a failed call records only the error code
+	and the call, file and function names (pointers to string
+	literals) and the line: the message returned by what() is
+	formatted the first time it is asked for, so bursts of errors
+	that are caught and counted but not printed don't pay for it.
+	That first what() call is not synchronized, so don't make it
+	concurrently from several threads on the same object.
+*/
+class VirtuoseAPIError : public std::runtime_error {
+	public:
+		/// @brief Error with a preformatted message.
+		explicit VirtuoseAPIError(std::string const& what)
+			: std::runtime_error(what)
+			, code_(VIRT_E_NO_ERROR)
+			, call_(NULL)
+			, file_("")
+			, line_(-1)
+			, func_("")
+			, messageText_(NULL) {}
+
+		/** @brief Error from a failed call, formatted on demand.
+
+			@param messageText Looks up the message for @a code when
+			formatting what(): the getErrorMessageText() of the wrapper
+			for the backend that failed. If NULL, the code is shown.
 		*/
-		~Virtuose();
+		VirtuoseAPIError(int code, const char * call, const char * file,
+		                 int line, const char * func,
+		                 const char * (*messageText)(int) = NULL)
+			: std::runtime_error(std::string())
+			, code_(code)
+			, call_(call)
+			, file_(file)
+			, line_(line)
+			, func_(func)
+			, messageText_(messageText) {}
+
+		virtual ~VirtuoseAPIError() throw() {}
+
+		virtual const char * what() const throw() {
+			if (!call_) {
+				return std::runtime_error::what();
+			}
+			if (what_.empty()) {
+				try {
+					std::ostringstream s;
+					s << "VirtuoseAPI Error (in call '" << call_ << "' in " << func_ << "@" << file_ << ":" << line_ << "): ";
+					if (messageText_) {
+						s << messageText_(code_);
+					} else {
+						s << "error code " << code_;
+					}
+					what_ = s.str();
+				} catch (...) {
+					return call_;
+				}
+			}
+			return what_.c_str();
+		}
+
+		/// @brief VirtuoseAPI error code, or VIRT_E_NO_ERROR if not from a failed call.
+		int code() const {
+			return code_;
+		}
+
+		/// @brief The failed call, or NULL if not from a failed call.
+		const char * call() const {
+			return call_;
+		}
+
+		const char * file() const {
+			return file_;
+		}
+
+		int line() const {
+			return line_;
+		}
+
+		const char * function() const {
+			return func_;
+		}
+
+	private:
+		int code_;
+		const char * call_;
+		const char * file_;
+		int line_;
+		const char * func_;
+		const char * (*messageText_)(int);
+		mutable std::string what_;
+};
+
+/** @brief The wrapped VirtuoseAPI methods, operating on a VirtContext
+	through the given backend (see VirtuoseAPIBackend).
+
+	This is the shared base of BasicVirtuose, which owns its VirtContext,
+	and BasicVirtuoseRef, which doesn't: use one of those (or Virtuose and
+	VirtuoseRef) rather than this class directly. It holds nothing but the
+	VirtContext.
+*/
+template<typename Backend>
+class BasicVirtuoseMethods {
+	public:
+		typedef ::VirtuoseAPIError VirtuoseAPIError;
+
+
+#ifdef VPP_THROWING_ERROR_CHECK
+#	define VPP_CHECK_RETURN(_RET, _DESC) \
+	do { \
+		if (VPP_UNLIKELY((_RET) != 0)) { \
+			this->_throwCallError(_DESC, __FILE__, __LINE__, __FUNCTION__); \
+		} \
+	} while (0)
+#else
+	// Still evaluated, so a call passed to VPP_CHECKED_CALL is still made.
+#	define VPP_CHECK_RETURN(_RET, _DESC) ((void)(_RET))
+#endif
+#define VPP_CHECKED_CALL(_CALL) VPP_CHECK_RETURN(_CALL, #_CALL)
+
+#ifdef VPP_RESULT_ERROR_CHECK
+#	define VPP_STATUS(_RET) _result(_RET)
+#else
+#	define VPP_STATUS(_RET) (_RET)
+#endif
 
 		/** @brief Conversion operator to type VirtContext.
 		*/
@@ -136,109 +1213,252 @@ class Virtuose {
 			return vc_;
 		}
 
-		/** @brief Retrieve name used to create device context, if available.
+		/** @brief Reads position, speed, buttons, dead man, emergency stop,
+			power and update time in one pass, with a single error check
+			at the end instead of one per call.
+
+			@param state Snapshot to fill.
+			@param buttonCount Number of buttons to sample (at most 32).
+			@returns 0, or nonzero if any call failed and error checking
+			is disabled or VPP_RESULT_ERROR_CHECK is defined.
+
+			@throws VirtuoseAPIError if any of the underlying calls failed.
 		*/
-		std::string const& getName() const {
-			return name_;
-		}
+		VirtuoseStatus readState(VirtuoseState & state, int buttonCount = VPP_STATE_BUTTON_COUNT);
+
+		/// @overload
+		VirtuoseValue<VirtuoseState>::type readState(int buttonCount = VPP_STATE_BUTTON_COUNT);
+
+		/// @brief readState() reporting errors by value in every error mode.
+		VirtuoseResult tryReadState(VirtuoseState & state, int buttonCount = VPP_STATE_BUTTON_COUNT);
+
+		/// @overload
+		VirtuoseExpected<VirtuoseState> tryReadState(int buttonCount = VPP_STATE_BUTTON_COUNT);
+
+		/** @brief Sends the flagged members of a command (force, position,
+			speed) with a single error check at the end.
 
-		int attachVO(float mass, float *mxmymz);
-		int attachQSVO(float *Ks, float *Bs);
-		int attachVOAvatar(float mass, float *mxmymz);
-		int detachVO();
-		int detachVOAvatar();
-		int displayHardwareStatus(FILE *fh);
-		int getBaseFrame(float *base);
-		int getButton(int button_number, int *state);
-		int getCommandType(VirtCommandType *type);
-		int getDeadMan(int *dead_man);
-		int getEmergencyStop(int *emergency_stop);
-		int getError(int *error);
-		int getErrorCode();
-		int getForce(float *force);
-		int getForceFactor(float *force_factor);
-		int getIndexingMode(VirtIndexingType *indexing_mode);
-		int getLimitTorque(float *torque);
-		int getObservationFrame(float *obs);
-		int getPosition(float *pos);
-		int getPowerOn(int *power);
-		int getSpeed(float *speed);
-		int getSpeedFactor(float *speed_factor);
-		int getTimeLastUpdate(unsigned int *time);
-		int getTimeoutValue(float *time_value);
-		int setBaseFrame(float *base);
-		int setCommandType(VirtCommandType type);
-		int setDebugFlags(unsigned short flag);
-		int setForce(float *force);
-		int setForceFactor(float force_factor);
-		int setIndexingMode(VirtIndexingType indexing_mode);
-		int setLimitTorque(float torque);
-		int setObservationFrame(float *obs);
-		int setObservationFrameSpeed(float *speed);
-		int setOutputFile(char *name);
-		int setPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg);
-		int setPosition(float *pos);
-		int setPowerOn(int power);
-		int setSpeed(float *speed);
-		int setSpeedFactor(float speed_factor);
-		int setTexture(float *position, float *intensity, int reinit);
-		int setTextureForce(float *texture_force);
-		int setTimeStep(float step);
-		int setTimeoutValue(float time_value);
-		int startLoop();
-		int stopLoop();
-		int waitForSynch();
-		int trajRecordStart();
-		int trajRecordStop();
-		int trajSetSamplingTimeStep(float timeStep, unsigned int *recordTime);
-		int vmStartTrajSampling(unsigned int nbSamples);
-		int vmGetTrajSamples(float *samples);
-		int vmSetType(VirtVmType type);
-		int vmSetParameter(VirtVmParameter *param);
-		int vmActivate();
-		int vmDeactivate();
-		int vmSetBaseFrame(float *base);
-		int vmSetMaxArtiBounds(float *bounds);
-		int vmSetMinArtiBounds(float *bounds);
-		int getPhysicalPosition(float *pos);
-		int getAvatarPosition(float *pos);
-		int saturateTorque(float forceThreshold, float momentThreshold);
-		int vmSetDefaultToTransparentMode();
-		int vmSetDefaultToCartesianPosition();
-		int vmSetBaseFrameToCurrentFrame();
-		int convertRGBToGrayscale(float *rgb, float *gray);
-		int vmGetBaseFrame(float *base);
-		int waitPressButton(int button_number);
-		int getTimeStep(float *step);
-		int vmSetRobotMode(int OnOff);
-		int vmSaveCurrentSpline(char *file_name);
-		int vmLoadSpline(char *file_name);
-		int vmDeleteSpline(char *file_name);
-		int vmWaitUpperBound();
-		int disableControlConnexion(int disable);
-		int isInBounds(unsigned int *bounds);
-		int getAlarm(unsigned int *alarm);
-		int getCatchFrame(float *frame);
-		int setCatchFrame(float *frame);
-		int activeSpeedControl(float radius, float speedFactor);
-		int deactiveSpeedControl();
-		int isInShiftPosition(int *shift);
-		int setFrictionForce(float fx, float fy, float fz);
-		int getMouseState(int *active, int *left_click, int *right_click);
-		int generateDebugFile();
-		int getCenterSphere(float *pos);
-		int getAxisOfRotation(float *axis);
-		int getADC(int line, float *adc);
-		int convertDisplacementToTransformMatrix(float *d, float *m);
-		int convertTransformMatrixToDisplacement(float *d, float *m);
-		int getTrackball(int *x_move, int *y_move);
-		int getTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn);
-		int setAbsolutePosition(float *pos);
-		int beepOnLimit(int enable);
-		int enableForceFeedback(int enable);
-		int getPhysicalSpeed(float *speed);
-		int forceShiftButton(int forceShiftButton);
-		int addForce(float *force);
+			@throws VirtuoseAPIError if any of the underlying calls failed.
+		*/
+		VirtuoseStatus writeCommand(VirtuoseCommand const& command);
+
+		/// @brief writeCommand() reporting errors by value in every error mode.
+		VirtuoseResult tryWriteCommand(VirtuoseCommand const& command);
+
+		VirtuoseStatus attachVO(float mass, float *mxmymz);
+		VirtuoseResult tryAttachVO(float mass, float *mxmymz);
+		VirtuoseStatus attachQSVO(float *Ks, float *Bs);
+		VirtuoseResult tryAttachQSVO(float *Ks, float *Bs);
+		VirtuoseStatus attachVOAvatar(float mass, float *mxmymz);
+		VirtuoseResult tryAttachVOAvatar(float mass, float *mxmymz);
+		VirtuoseStatus detachVO();
+		VirtuoseResult tryDetachVO();
+		VirtuoseStatus detachVOAvatar();
+		VirtuoseResult tryDetachVOAvatar();
+		VirtuoseStatus displayHardwareStatus(FILE *fh);
+		VirtuoseResult tryDisplayHardwareStatus(FILE *fh);
+		VirtuoseStatus getBaseFrame(float *base);
+		VirtuoseResult tryGetBaseFrame(float *base);
+		VirtuoseValue<VirtuoseDisplacement>::type getBaseFrame();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetBaseFrame();
+		VirtuoseStatus getButton(int button_number, int *state);
+		VirtuoseResult tryGetButton(int button_number, int *state);
+		VirtuoseStatus getCommandType(VirtCommandType *type);
+		VirtuoseResult tryGetCommandType(VirtCommandType *type);
+		VirtuoseStatus getDeadMan(int *dead_man);
+		VirtuoseResult tryGetDeadMan(int *dead_man);
+		VirtuoseStatus getEmergencyStop(int *emergency_stop);
+		VirtuoseResult tryGetEmergencyStop(int *emergency_stop);
+		VirtuoseStatus getError(int *error);
+		VirtuoseResult tryGetError(int *error);
+		VirtuoseStatus getErrorCode();
+		VirtuoseResult tryGetErrorCode();
+		VirtuoseStatus getForce(float *force);
+		VirtuoseResult tryGetForce(float *force);
+		VirtuoseValue<VirtuoseWrench>::type getForce();
+		VirtuoseExpected<VirtuoseWrench> tryGetForce();
+		VirtuoseStatus getForceFactor(float *force_factor);
+		VirtuoseResult tryGetForceFactor(float *force_factor);
+		VirtuoseStatus getIndexingMode(VirtIndexingType *indexing_mode);
+		VirtuoseResult tryGetIndexingMode(VirtIndexingType *indexing_mode);
+		VirtuoseStatus getLimitTorque(float *torque);
+		VirtuoseResult tryGetLimitTorque(float *torque);
+		VirtuoseStatus getObservationFrame(float *obs);
+		VirtuoseResult tryGetObservationFrame(float *obs);
+		VirtuoseValue<VirtuoseDisplacement>::type getObservationFrame();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetObservationFrame();
+		VirtuoseStatus getPosition(float *pos);
+		VirtuoseResult tryGetPosition(float *pos);
+		VirtuoseValue<VirtuoseDisplacement>::type getPosition();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetPosition();
+		VirtuoseStatus getPowerOn(int *power);
+		VirtuoseResult tryGetPowerOn(int *power);
+		VirtuoseStatus getSpeed(float *speed);
+		VirtuoseResult tryGetSpeed(float *speed);
+		VirtuoseValue<VirtuoseTwist>::type getSpeed();
+		VirtuoseExpected<VirtuoseTwist> tryGetSpeed();
+		VirtuoseStatus getSpeedFactor(float *speed_factor);
+		VirtuoseResult tryGetSpeedFactor(float *speed_factor);
+		VirtuoseStatus getTimeLastUpdate(unsigned int *time);
+		VirtuoseResult tryGetTimeLastUpdate(unsigned int *time);
+		VirtuoseStatus getTimeoutValue(float *time_value);
+		VirtuoseResult tryGetTimeoutValue(float *time_value);
+		VirtuoseStatus setBaseFrame(float *base);
+		VirtuoseResult trySetBaseFrame(float *base);
+		VirtuoseStatus setCommandType(VirtCommandType type);
+		VirtuoseResult trySetCommandType(VirtCommandType type);
+		VirtuoseStatus setDebugFlags(unsigned short flag);
+		VirtuoseResult trySetDebugFlags(unsigned short flag);
+		VirtuoseStatus setForce(float *force);
+		VirtuoseResult trySetForce(float *force);
+		VirtuoseStatus setForceFactor(float force_factor);
+		VirtuoseResult trySetForceFactor(float force_factor);
+		VirtuoseStatus setIndexingMode(VirtIndexingType indexing_mode);
+		VirtuoseResult trySetIndexingMode(VirtIndexingType indexing_mode);
+		VirtuoseStatus setLimitTorque(float torque);
+		VirtuoseResult trySetLimitTorque(float torque);
+		VirtuoseStatus setObservationFrame(float *obs);
+		VirtuoseResult trySetObservationFrame(float *obs);
+		VirtuoseStatus setObservationFrameSpeed(float *speed);
+		VirtuoseResult trySetObservationFrameSpeed(float *speed);
+		VirtuoseStatus setOutputFile(char *name);
+		VirtuoseResult trySetOutputFile(char *name);
+		VirtuoseStatus setPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg);
+		VirtuoseResult trySetPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg);
+		VirtuoseStatus setPosition(float *pos);
+		VirtuoseResult trySetPosition(float *pos);
+		VirtuoseStatus setPowerOn(int power);
+		VirtuoseResult trySetPowerOn(int power);
+		VirtuoseStatus setSpeed(float *speed);
+		VirtuoseResult trySetSpeed(float *speed);
+		VirtuoseStatus setSpeedFactor(float speed_factor);
+		VirtuoseResult trySetSpeedFactor(float speed_factor);
+		VirtuoseStatus setTexture(float *position, float *intensity, int reinit);
+		VirtuoseResult trySetTexture(float *position, float *intensity, int reinit);
+		VirtuoseStatus setTextureForce(float *texture_force);
+		VirtuoseResult trySetTextureForce(float *texture_force);
+		VirtuoseStatus setTimeStep(float step);
+		VirtuoseResult trySetTimeStep(float step);
+		VirtuoseStatus setTimeoutValue(float time_value);
+		VirtuoseResult trySetTimeoutValue(float time_value);
+		VirtuoseStatus startLoop();
+		VirtuoseResult tryStartLoop();
+		VirtuoseStatus stopLoop();
+		VirtuoseResult tryStopLoop();
+		VirtuoseStatus waitForSynch();
+		VirtuoseResult tryWaitForSynch();
+		VirtuoseStatus trajRecordStart();
+		VirtuoseResult tryTrajRecordStart();
+		VirtuoseStatus trajRecordStop();
+		VirtuoseResult tryTrajRecordStop();
+		VirtuoseStatus trajSetSamplingTimeStep(float timeStep, unsigned int *recordTime);
+		VirtuoseResult tryTrajSetSamplingTimeStep(float timeStep, unsigned int *recordTime);
+		VirtuoseStatus vmStartTrajSampling(unsigned int nbSamples);
+		VirtuoseResult tryVmStartTrajSampling(unsigned int nbSamples);
+		VirtuoseStatus vmGetTrajSamples(float *samples);
+		VirtuoseResult tryVmGetTrajSamples(float *samples);
+		VirtuoseStatus vmSetType(VirtVmType type);
+		VirtuoseResult tryVmSetType(VirtVmType type);
+		VirtuoseStatus vmSetParameter(VirtVmParameter *param);
+		VirtuoseResult tryVmSetParameter(VirtVmParameter *param);
+		VirtuoseStatus vmActivate();
+		VirtuoseResult tryVmActivate();
+		VirtuoseStatus vmDeactivate();
+		VirtuoseResult tryVmDeactivate();
+		VirtuoseStatus vmSetBaseFrame(float *base);
+		VirtuoseResult tryVmSetBaseFrame(float *base);
+		VirtuoseStatus vmSetMaxArtiBounds(float *bounds);
+		VirtuoseResult tryVmSetMaxArtiBounds(float *bounds);
+		VirtuoseStatus vmSetMinArtiBounds(float *bounds);
+		VirtuoseResult tryVmSetMinArtiBounds(float *bounds);
+		VirtuoseStatus getPhysicalPosition(float *pos);
+		VirtuoseResult tryGetPhysicalPosition(float *pos);
+		VirtuoseValue<VirtuoseDisplacement>::type getPhysicalPosition();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetPhysicalPosition();
+		VirtuoseStatus getAvatarPosition(float *pos);
+		VirtuoseResult tryGetAvatarPosition(float *pos);
+		VirtuoseValue<VirtuoseDisplacement>::type getAvatarPosition();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetAvatarPosition();
+		VirtuoseStatus saturateTorque(float forceThreshold, float momentThreshold);
+		VirtuoseResult trySaturateTorque(float forceThreshold, float momentThreshold);
+		VirtuoseStatus vmSetDefaultToTransparentMode();
+		VirtuoseResult tryVmSetDefaultToTransparentMode();
+		VirtuoseStatus vmSetDefaultToCartesianPosition();
+		VirtuoseResult tryVmSetDefaultToCartesianPosition();
+		VirtuoseStatus vmSetBaseFrameToCurrentFrame();
+		VirtuoseResult tryVmSetBaseFrameToCurrentFrame();
+		VirtuoseStatus convertRGBToGrayscale(float *rgb, float *gray);
+		VirtuoseResult tryConvertRGBToGrayscale(float *rgb, float *gray);
+		VirtuoseStatus vmGetBaseFrame(float *base);
+		VirtuoseResult tryVmGetBaseFrame(float *base);
+		VirtuoseValue<VirtuoseDisplacement>::type vmGetBaseFrame();
+		VirtuoseExpected<VirtuoseDisplacement> tryVmGetBaseFrame();
+		VirtuoseStatus waitPressButton(int button_number);
+		VirtuoseResult tryWaitPressButton(int button_number);
+		VirtuoseStatus getTimeStep(float *step);
+		VirtuoseResult tryGetTimeStep(float *step);
+		VirtuoseStatus vmSetRobotMode(int OnOff);
+		VirtuoseResult tryVmSetRobotMode(int OnOff);
+		VirtuoseStatus vmSaveCurrentSpline(char *file_name);
+		VirtuoseResult tryVmSaveCurrentSpline(char *file_name);
+		VirtuoseStatus vmLoadSpline(char *file_name);
+		VirtuoseResult tryVmLoadSpline(char *file_name);
+		VirtuoseStatus vmDeleteSpline(char *file_name);
+		VirtuoseResult tryVmDeleteSpline(char *file_name);
+		VirtuoseStatus vmWaitUpperBound();
+		VirtuoseResult tryVmWaitUpperBound();
+		VirtuoseStatus disableControlConnexion(int disable);
+		VirtuoseResult tryDisableControlConnexion(int disable);
+		VirtuoseStatus isInBounds(unsigned int *bounds);
+		VirtuoseResult tryIsInBounds(unsigned int *bounds);
+		VirtuoseStatus getAlarm(unsigned int *alarm);
+		VirtuoseResult tryGetAlarm(unsigned int *alarm);
+		VirtuoseStatus getCatchFrame(float *frame);
+		VirtuoseResult tryGetCatchFrame(float *frame);
+		VirtuoseValue<VirtuoseDisplacement>::type getCatchFrame();
+		VirtuoseExpected<VirtuoseDisplacement> tryGetCatchFrame();
+		VirtuoseStatus setCatchFrame(float *frame);
+		VirtuoseResult trySetCatchFrame(float *frame);
+		VirtuoseStatus activeSpeedControl(float radius, float speedFactor);
+		VirtuoseResult tryActiveSpeedControl(float radius, float speedFactor);
+		VirtuoseStatus deactiveSpeedControl();
+		VirtuoseResult tryDeactiveSpeedControl();
+		VirtuoseStatus isInShiftPosition(int *shift);
+		VirtuoseResult tryIsInShiftPosition(int *shift);
+		VirtuoseStatus setFrictionForce(float fx, float fy, float fz);
+		VirtuoseResult trySetFrictionForce(float fx, float fy, float fz);
+		VirtuoseStatus getMouseState(int *active, int *left_click, int *right_click);
+		VirtuoseResult tryGetMouseState(int *active, int *left_click, int *right_click);
+		VirtuoseStatus generateDebugFile();
+		VirtuoseResult tryGenerateDebugFile();
+		VirtuoseStatus getCenterSphere(float *pos);
+		VirtuoseResult tryGetCenterSphere(float *pos);
+		VirtuoseStatus getAxisOfRotation(float *axis);
+		VirtuoseResult tryGetAxisOfRotation(float *axis);
+		VirtuoseStatus getADC(int line, float *adc);
+		VirtuoseResult tryGetADC(int line, float *adc);
+		VirtuoseStatus convertDisplacementToTransformMatrix(float *d, float *m);
+		VirtuoseResult tryConvertDisplacementToTransformMatrix(float *d, float *m);
+		VirtuoseStatus convertTransformMatrixToDisplacement(float *d, float *m);
+		VirtuoseResult tryConvertTransformMatrixToDisplacement(float *d, float *m);
+		VirtuoseStatus getTrackball(int *x_move, int *y_move);
+		VirtuoseResult tryGetTrackball(int *x_move, int *y_move);
+		VirtuoseStatus getTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn);
+		VirtuoseResult tryGetTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn);
+		VirtuoseStatus setAbsolutePosition(float *pos);
+		VirtuoseResult trySetAbsolutePosition(float *pos);
+		VirtuoseStatus beepOnLimit(int enable);
+		VirtuoseResult tryBeepOnLimit(int enable);
+		VirtuoseStatus enableForceFeedback(int enable);
+		VirtuoseResult tryEnableForceFeedback(int enable);
+		VirtuoseStatus getPhysicalSpeed(float *speed);
+		VirtuoseResult tryGetPhysicalSpeed(float *speed);
+		VirtuoseValue<VirtuoseTwist>::type getPhysicalSpeed();
+		VirtuoseExpected<VirtuoseTwist> tryGetPhysicalSpeed();
+		VirtuoseStatus forceShiftButton(int forceShiftButton);
+		VirtuoseResult tryForceShiftButton(int forceShiftButton);
+		VirtuoseStatus addForce(float *force);
+		VirtuoseResult tryAddForce(float *force);
 		/* Static Methods */
 		static int APIVersion(int *major, int *minor);
 
@@ -263,787 +1483,2338 @@ class Virtuose {
 		*/
 		static std::string getErrorMessage(int code);
 
-	private:
+		/** @brief Converts an error code into the VirtuoseAPI's own
+			message string, without allocating.
+
+			In C++11, the string returned by virtGetErrorMessage() is
+			copied on the first lookup of a code below
+			VPP_ERROR_MESSAGE_CACHE_SIZE, and that copy, valid until
+			exit, returned after that. Otherwise, the VirtuoseAPI's own
+			string is returned: copy it before the next call.
+		*/
+		static const char * getErrorMessageText(int code);
+
+	protected:
+		explicit BasicVirtuoseMethods(VirtContext vc) : vc_(vc) {}
+
 		VirtContext vc_;
-		std::string const name_;
-		bool const own_;
 
-		/// @brief Copy constructor forbidden
-		Virtuose(Virtuose const&);
+		/// @brief Wraps a return code, fetching the error code if it failed.
+		VirtuoseResult _result(int ret) const {
+			VirtuoseResult r;
+			r.returnValue = ret;
+			r.errorCode = VPP_UNLIKELY(ret != 0) ? Backend::virtGetErrorCode(vc_) : VIRT_E_NO_ERROR;
+			return r;
+		}
 
-		/// @brief Assignment operator forbidden
-		Virtuose & operator=(Virtuose const&);
-
-#ifndef VPP_DISABLE_ERROR_CHECK
-		void _checkReturnCode(int returnValue, const char * call, const char * file,
-		                      int const line, const char * func = "") {
-			if (returnValue != 0) {
-				std::ostringstream s;
-				s << "VirtuoseAPI Error (in call '" << call << "' in " << func << "@" << file << ":" << line << "): " << getErrorMessage();
-				throw VirtuoseAPIError(s.str());
-			}
+		/// @brief Attaches a call's status to a by-value getter's result:
+		/// nothing to do unless it's a VirtuoseExpected.
+		template<typename T>
+		static void _setStatus(T &, int) {}
+
+		template<typename T>
+		static void _setStatus(VirtuoseExpected<T> & value, VirtuoseResult status) {
+			static_cast<VirtuoseResult &>(value) = status;
+		}
+
+		int _readState(VirtuoseState & state, int buttonCount);
+		int _writeCommand(VirtuoseCommand const& command);
+
+#ifdef VPP_THROWING_ERROR_CHECK
+		/** @brief Throws the exception for a failed call.
+
+			Deliberately kept out of line and marked cold, so that the
+			only code VPP_CHECKED_CALL leaves at each call site is a
+			compare and a (predicted not-taken) branch to this function.
+		*/
+		VPP_COLD VPP_NORETURN void _throwCallError(const char * call, const char * file,
+		        int const line, const char * func) {
+			throw VirtuoseAPIError(Backend::virtGetErrorCode(vc_), call, file, line, func, &getErrorMessageText);
 		}
 #endif
 };
 
-inline 	Virtuose::~Virtuose() {
-	VPP_VERBOSE_MESSAGE("In destructor for device named " << name_ << ", VirtContext=" << vc_);
-	if (vc_ && own_) {
-		try {
-			VPP_CHECKED_CALL(virtClose(vc_));
-		} catch (VirtuoseAPIError & e) {
-			(void) e; // silence warning if not in verbose mode.
-			VPP_VERBOSE_MESSAGE("Exception in destructor, ignoring: " << e.what());
+/** @brief Object representing a device of the given backend; use
+	Virtuose, for the VirtuoseAPI.
+
+	It encapsulates and manages the lifetime of the VirtContext,
+	and provides methods with names and signatures similar to the
+	C API (generated from it, with minor automated modifications).
+
+	This object is non-copyable and non-assignable: you may manage it
+	with a scoped_ptr or shared_ptr and allocate it on the heap if
+	those restrictions are a problem for you.
+*/
+template<typename Backend>
+class BasicVirtuose : public BasicVirtuoseMethods<Backend> {
+	public:
+		/** @brief constructor
+
+			Opens a new VirtContext upon construction.
+
+			@param name Name of Virtuose device to connect to.
+
+			@throws VirtuoseAPIError if opening the device failed.
+		*/
+		BasicVirtuose(const std::string & name)
+			: BasicVirtuoseMethods<Backend>(Backend::virtOpen(name.c_str()))
+			, name_(name)
+			, own_(true) {
+			periodicTarget_.object = NULL;
+			VPP_VERBOSE_MESSAGE("Constructing a new Virtuose object, device named " << name_ << ", VirtContext=" << this->vc_);
+			if (!this->vc_) {
+				throw VirtuoseAPIError("Failed opening Virtuose " + name_ + ": " +  this->getErrorMessage());
+			}
 		}
-	}
-}
 
-inline bool Virtuose::checkForError(int returnValue, const char * file,
-                                    int const line, const char * func) {
-	if (returnValue == 0) {
-		// Silence unused variable warning when VPP_VERBOSE not defined
-		(void) file;
-		(void) line;
-		(void) func;
-		return false; // no error
-	} else {
-		VPP_VERBOSE_MESSAGE("Got error from Virtuose (in " << func << "@" << file << ":" << line << "): "  << getErrorMessage());
-		return true; // error
-	}
+		/** @brief constructor from existing VirtContext
+
+			Does not open new VirtContext. Prefer VirtuoseRef, which
+			does the same job without the cost of this object's name
+			string, inside a periodic callback function registered
+			through the C-style setPeriodicFunction(); the templated
+			overloads of setPeriodicFunction() avoid both by handing the
+			callback the registering object.
+
+			@param name Name of Virtuose device to connect to.
+
+			@throws VirtuoseAPIError if opening the device failed.
+		*/
+		BasicVirtuose(VirtContext vc)
+			: BasicVirtuoseMethods<Backend>(vc)
+			, name_("unknown - from VirtContext")
+			, own_(false) {
+			periodicTarget_.object = NULL;
+			VPP_VERBOSE_MESSAGE("Borrowing a Virtuose object with VirtContext=" << this->vc_);
+			if (!this->vc_) {
+				throw VirtuoseAPIError("Can't borrow a null VirtContext!");
+			}
+		}
+
+		/** @brief destructor that closes the connection to the Virtuose
+			device if we opened it.
+		*/
+		~BasicVirtuose();
+
+		/** @brief Retrieve name used to create device context, if available.
+		*/
+		std::string const& getName() const {
+			return name_;
+		}
+
+		using BasicVirtuoseMethods<Backend>::setPeriodicFunction;
+
+		/** @brief Registers any callable taking a BasicVirtuose & (a
+			Virtuose &, for Virtuose) as the
+			periodic function.
+
+			The callable is invoked with a reference to this object on
+			the VirtuoseAPI's thread, through a trampoline generated for
+			its type: no allocation or borrowed Virtuose construction
+			happens per tick. Only a pointer to @a callable is kept, so it
+			must outlive the loop. Call before startLoop().
+
+			@code
+			struct Servo {
+				void operator()(Virtuose & vpp) { ... }
+			} servo;
+			float period = 0.001f;
+			vpp.setPeriodicFunction(servo, &period);
+			@endcode
+		*/
+		template<typename F>
+		VirtuoseStatus setPeriodicFunction(F & callable, float * period) {
+			// F may be const: the trampoline casts back to F *.
+			periodicTarget_.object = const_cast<void *>(static_cast<const volatile void *>(&callable));
+			return setPeriodicFunction(&BasicVirtuose::_periodicCallableTrampoline<F>, period, this);
+		}
+
+		/// @overload for a plain function taking a BasicVirtuose &
+		VirtuoseStatus setPeriodicFunction(void (*fn)(BasicVirtuose &), float * period) {
+			periodicTarget_.function = fn;
+			return setPeriodicFunction(&BasicVirtuose::_periodicFunctionTrampoline, period, this);
+		}
+
+		/** @brief Registers a member function taking a BasicVirtuose & as the
+			periodic function, called on @a obj (which must outlive the
+			loop). The member is a template argument, so it can be
+			inlined into the trampoline:
+
+			@code
+			vpp.setPeriodicFunction<MyApp, &MyApp::servoTick>(app, &period);
+			@endcode
+		*/
+		template<typename T, void (T::*Method)(BasicVirtuose &)>
+		VirtuoseStatus setPeriodicFunction(T & obj, float * period) {
+			periodicTarget_.object = &obj;
+			return setPeriodicFunction(&BasicVirtuose::_periodicMethodTrampoline<T, Method>, period, this);
+		}
+
+	private:
+		std::string const name_;
+		bool const own_;
+
+		/// @brief What the templated setPeriodicFunction() overloads call.
+		union PeriodicTarget {
+			void * object;
+			void (*function)(BasicVirtuose &);
+		} periodicTarget_;
+
+		template<typename F>
+		static void _periodicCallableTrampoline(VirtContext, void * arg) {
+			BasicVirtuose & self = *static_cast<BasicVirtuose *>(arg);
+			VPP_PROFILE_CALL(periodicTick, (*static_cast<F *>(self.periodicTarget_.object))(self));
+		}
+
+		static void _periodicFunctionTrampoline(VirtContext, void * arg) {
+			BasicVirtuose & self = *static_cast<BasicVirtuose *>(arg);
+			VPP_PROFILE_CALL(periodicTick, self.periodicTarget_.function(self));
+		}
+
+		template<typename T, void (T::*Method)(BasicVirtuose &)>
+		static void _periodicMethodTrampoline(VirtContext, void * arg) {
+			BasicVirtuose & self = *static_cast<BasicVirtuose *>(arg);
+			VPP_PROFILE_CALL(periodicTick, (static_cast<T *>(self.periodicTarget_.object)->*Method)(self));
+		}
+
+		/// @brief Copy constructor forbidden
+		BasicVirtuose(BasicVirtuose const&);
+
+		/// @brief Assignment operator forbidden
+		BasicVirtuose & operator=(BasicVirtuose const&);
+};
+
+/** @brief Non-owning view of a VirtContext, with all the methods of
+	BasicVirtuose; use VirtuoseRef, for the VirtuoseAPI.
+
+	It is exactly one pointer in size, and trivially copyable and
+	destructible, so it can be created per tick inside a periodic
+	callback (or anywhere only a VirtContext is at hand) at no cost:
+
+	@code
+	void servoTick(VirtContext vc, void * arg) {
+		VirtuoseRef vpp(vc);
+		VirtuoseDisplacement pos = vpp.getPosition();
+		// ...
+	}
+	@endcode
+
+	Unlike the borrowing Virtuose constructor, it does not check for a
+	null VirtContext.
+*/
+template<typename Backend>
+class BasicVirtuoseRef : public BasicVirtuoseMethods<Backend> {
+	public:
+		explicit BasicVirtuoseRef(VirtContext vc) : BasicVirtuoseMethods<Backend>(vc) {}
+
+		/// @brief Views the context of an existing BasicVirtuose object.
+		BasicVirtuoseRef(BasicVirtuose<Backend> const& v) : BasicVirtuoseMethods<Backend>(v.getVirtContext()) {}
+};
+
+/// @brief The wrapped methods, for the VirtuoseAPI.
+typedef BasicVirtuoseMethods<VirtuoseAPIBackend> VirtuoseMethods;
+
+/// @brief A VirtuoseAPI device.
+typedef BasicVirtuose<VirtuoseAPIBackend> Virtuose;
+
+/// @brief Non-owning view of a VirtuoseAPI VirtContext.
+typedef BasicVirtuoseRef<VirtuoseAPIBackend> VirtuoseRef;
+
+#if __cplusplus >= 201103L
+static_assert(sizeof(VirtuoseRef) == sizeof(VirtContext), "VirtuoseRef should be a single pointer");
+#endif
+
+template<typename Backend>
+inline BasicVirtuose<Backend>::~BasicVirtuose() {
+	VPP_VERBOSE_MESSAGE("In destructor for device named " << name_ << ", VirtContext=" << this->vc_);
+	if (this->vc_ && own_) {
+		try {
+			VPP_CHECKED_CALL(Backend::virtClose(this->vc_));
+		} catch (VirtuoseAPIError & e) {
+			(void) e; // silence warning if not in verbose mode.
+			VPP_VERBOSE_MESSAGE("Exception in destructor, ignoring: " << e.what());
+		}
+	}
+}
+
+template<typename Backend>
+inline int BasicVirtuoseMethods<Backend>::_readState(VirtuoseState & state, int buttonCount) {
+	int failed = (Backend::virtGetPosition(vc_, state.position.data) != 0);
+	failed |= (Backend::virtGetSpeed(vc_, state.speed.data) != 0);
+	state.buttons = 0;
+	for (int i = 0; i < buttonCount; ++i) {
+		int pressed = 0;
+		failed |= (Backend::virtGetButton(vc_, i, &pressed) != 0);
+		state.buttons |= (pressed ? 1u : 0u) << i;
+	}
+	failed |= (Backend::virtGetDeadMan(vc_, &state.deadMan) != 0);
+	failed |= (Backend::virtGetEmergencyStop(vc_, &state.emergencyStop) != 0);
+	failed |= (Backend::virtGetPowerOn(vc_, &state.powerOn) != 0);
+	failed |= (Backend::virtGetTimeLastUpdate(vc_, &state.timeLastUpdate) != 0);
+	return failed;
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::readState(VirtuoseState & state, int buttonCount) {
+	int failed = VPP_PROFILE_CALL(readState, _readState(state, buttonCount));
+	VPP_CHECK_RETURN(failed, "readState");
+	return VPP_STATUS(failed);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryReadState(VirtuoseState & state, int buttonCount) {
+	return _result(VPP_PROFILE_CALL(readState, _readState(state, buttonCount)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseState>::type BasicVirtuoseMethods<Backend>::readState(int buttonCount) {
+	VirtuoseValue<VirtuoseState>::type ret;
+	_setStatus(ret, readState(ret, buttonCount));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseState> BasicVirtuoseMethods<Backend>::tryReadState(int buttonCount) {
+	VirtuoseExpected<VirtuoseState> ret;
+	_setStatus(ret, tryReadState(ret, buttonCount));
+	return ret;
+}
+
+template<typename Backend>
+inline int BasicVirtuoseMethods<Backend>::_writeCommand(VirtuoseCommand const& command) {
+	// The C API takes non-const pointers but does not write through them.
+	int failed = 0;
+	if (command.fields & VirtuoseCommand::Position) {
+		failed |= (Backend::virtSetPosition(vc_, const_cast<float *>(command.position.data)) != 0);
+	}
+	if (command.fields & VirtuoseCommand::Speed) {
+		failed |= (Backend::virtSetSpeed(vc_, const_cast<float *>(command.speed.data)) != 0);
+	}
+	if (command.fields & VirtuoseCommand::Force) {
+		failed |= (Backend::virtSetForce(vc_, const_cast<float *>(command.force.data)) != 0);
+	}
+	return failed;
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::writeCommand(VirtuoseCommand const& command) {
+	int failed = VPP_PROFILE_CALL(writeCommand, _writeCommand(command));
+	VPP_CHECK_RETURN(failed, "writeCommand");
+	return VPP_STATUS(failed);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryWriteCommand(VirtuoseCommand const& command) {
+	return _result(VPP_PROFILE_CALL(writeCommand, _writeCommand(command)));
+}
+
+template<typename Backend>
+inline bool BasicVirtuoseMethods<Backend>::checkForError(int returnValue, const char * file,
+                                    int const line, const char * func) {
+	if (returnValue == 0) {
+		// Silence unused variable warning when VPP_VERBOSE not defined
+		(void) file;
+		(void) line;
+		(void) func;
+		return false; // no error
+	} else {
+		VPP_VERBOSE_MESSAGE("Got error from Virtuose (in " << func << "@" << file << ":" << line << "): "  << getErrorMessage());
+		return true; // error
+	}
+}
+
+template<typename Backend>
+inline bool BasicVirtuoseMethods<Backend>::hasError() {
+	return (Backend::virtGetErrorCode(vc_) != VIRT_E_NO_ERROR);
+}
+
+template<typename Backend>
+inline std::string BasicVirtuoseMethods<Backend>::getErrorOrEmpty() {
+	std::string ret;
+	int code = Backend::virtGetErrorCode(vc_);
+	if (code != VIRT_E_NO_ERROR) {
+		ret = getErrorMessageText(code);
+	}
+	return ret;
+}
+
+/** @brief Returns the latest error message.
+*/
+template<typename Backend>
+inline std::string BasicVirtuoseMethods<Backend>::getErrorMessage() {
+	return getErrorMessage(Backend::virtGetErrorCode(vc_));
+}
+
+/** @brief Converts an error code into an error message string.
+*/
+template<typename Backend>
+inline std::string BasicVirtuoseMethods<Backend>::getErrorMessage(int code) {
+	return getErrorMessageText(code);
+}
+
+template<typename Backend>
+inline const char * BasicVirtuoseMethods<Backend>::getErrorMessageText(int code) {
+	if (code < 0 || code >= VPP_ERROR_MESSAGE_CACHE_SIZE) {
+		const char * msg = Backend::virtGetErrorMessage(code);
+		return msg ? msg : "";
+	}
+#if __cplusplus >= 201103L
+	// Copied rather than kept as is: the VirtuoseAPI may format
+	// messages into one shared buffer, or free them on virtClose().
+	struct Message {
+		/// 0 while empty, 1 while being copied, 2 once copied.
+		std::atomic<int> state;
+		char text[VPP_ERROR_MESSAGE_LENGTH];
+	};
+	static Message cache[VPP_ERROR_MESSAGE_CACHE_SIZE];
+	Message & m = cache[code];
+	if (m.state.load(std::memory_order_acquire) == 2) {
+		return m.text;
+	}
+	const char * msg = Backend::virtGetErrorMessage(code);
+	msg = msg ? msg : "";
+	int empty = 0;
+	if (m.state.compare_exchange_strong(empty, 1, std::memory_order_acquire)) {
+		std::strncpy(m.text, msg, VPP_ERROR_MESSAGE_LENGTH - 1);
+		m.text[VPP_ERROR_MESSAGE_LENGTH - 1] = '\0';
+		m.state.store(2, std::memory_order_release);
+		return m.text;
+	}
+	// Another thread is copying it.
+	return msg;
+#else
+	const char * msg = Backend::virtGetErrorMessage(code);
+	return msg ? msg : "";
+#endif
+}
+
+/// @brief Equality between a Virtuose or VirtuoseRef and a raw VirtContext.
+template<typename Backend>
+inline bool operator==(BasicVirtuoseMethods<Backend> const& v, VirtContext const vc) {
+	return (v.getVirtContext() == vc);
+}
+
+/// @brief Equality between a raw VirtContext and a Virtuose or VirtuoseRef.
+template<typename Backend>
+inline bool operator==(VirtContext const vc, BasicVirtuoseMethods<Backend> const& v) {
+	return (v.getVirtContext() == vc);
+}
+
+/** @brief Equality between Virtuose/VirtuoseRef objects - this should
+	always be false for two Virtuose objects, but a VirtuoseRef equals
+	the Virtuose it views.
+*/
+template<typename Backend>
+inline bool operator==(BasicVirtuoseMethods<Backend> const& v1, BasicVirtuoseMethods<Backend> const& v2) {
+	return (v1.getVirtContext() == v2.getVirtContext());
+}
+
+/// @brief Less-than comparison between Virtuose/VirtuoseRef objects
+template<typename Backend>
+inline bool operator<(BasicVirtuoseMethods<Backend> const& v1, BasicVirtuoseMethods<Backend> const& v2) {
+	return (v1.getVirtContext() < v2.getVirtContext());
+}
+
+/* Backend Implementation Details Follow */
+
+inline int VirtuoseAPIBackend::virtAPIVersion(int *major, int *minor) {
+	return ::virtAPIVersion(major, minor);
+}
+
+inline int VirtuoseAPIBackend::virtAttachVO(VirtContext VC, float mass, float *mxmymz) {
+	return ::virtAttachVO(VC, mass, mxmymz);
+}
+
+inline int VirtuoseAPIBackend::virtAttachQSVO(VirtContext VC, float *Ks, float *Bs) {
+	return ::virtAttachQSVO(VC, Ks, Bs);
+}
+
+inline int VirtuoseAPIBackend::virtAttachVOAvatar(VirtContext VC, float mass, float *mxmymz) {
+	return ::virtAttachVOAvatar(VC, mass, mxmymz);
+}
+
+inline int VirtuoseAPIBackend::virtClose(VirtContext VC) {
+	return ::virtClose(VC);
+}
+
+inline int VirtuoseAPIBackend::virtDetachVO(VirtContext VC) {
+	return ::virtDetachVO(VC);
+}
+
+inline int VirtuoseAPIBackend::virtDetachVOAvatar(VirtContext VC) {
+	return ::virtDetachVOAvatar(VC);
+}
+
+inline int VirtuoseAPIBackend::virtDisplayHardwareStatus(VirtContext VC, FILE *fh) {
+	return ::virtDisplayHardwareStatus(VC, fh);
+}
+
+inline int VirtuoseAPIBackend::virtGetBaseFrame(VirtContext VC, float *base) {
+	return ::virtGetBaseFrame(VC, base);
+}
+
+inline int VirtuoseAPIBackend::virtGetButton(VirtContext VC, int button_number, int *state) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, int button_number, int *state);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETBUTTON]);
+	if (direct) {
+		return direct(VC, button_number, state);
+	}
+#endif
+	return ::virtGetButton(VC, button_number, state);
+}
+
+inline int VirtuoseAPIBackend::virtGetCommandType(VirtContext VC, VirtCommandType *type) {
+	return ::virtGetCommandType(VC, type);
+}
+
+inline int VirtuoseAPIBackend::virtGetDeadMan(VirtContext VC, int *dead_man) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, int *dead_man);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETDEADMAN]);
+	if (direct) {
+		return direct(VC, dead_man);
+	}
+#endif
+	return ::virtGetDeadMan(VC, dead_man);
+}
+
+inline int VirtuoseAPIBackend::virtGetEmergencyStop(VirtContext VC, int *emergency_stop) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, int *emergency_stop);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETEMERGENCYSTOP]);
+	if (direct) {
+		return direct(VC, emergency_stop);
+	}
+#endif
+	return ::virtGetEmergencyStop(VC, emergency_stop);
+}
+
+inline int VirtuoseAPIBackend::virtGetError(VirtContext VC, int *error) {
+	return ::virtGetError(VC, error);
+}
+
+inline int VirtuoseAPIBackend::virtGetErrorCode(VirtContext VC) {
+	return ::virtGetErrorCode(VC);
+}
+
+inline char * VirtuoseAPIBackend::virtGetErrorMessage(int code) {
+	return ::virtGetErrorMessage(code);
+}
+
+inline int VirtuoseAPIBackend::virtGetForce(VirtContext VC, float *force) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *force);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETFORCE]);
+	if (direct) {
+		return direct(VC, force);
+	}
+#endif
+	return ::virtGetForce(VC, force);
+}
+
+inline int VirtuoseAPIBackend::virtGetForceFactor(VirtContext VC, float *force_factor) {
+	return ::virtGetForceFactor(VC, force_factor);
+}
+
+inline int VirtuoseAPIBackend::virtGetIndexingMode(VirtContext VC, VirtIndexingType *indexing_mode) {
+	return ::virtGetIndexingMode(VC, indexing_mode);
+}
+
+inline int VirtuoseAPIBackend::virtGetLimitTorque(VirtContext VC, float *torque) {
+	return ::virtGetLimitTorque(VC, torque);
+}
+
+inline int VirtuoseAPIBackend::virtGetObservationFrame(VirtContext VC, float *obs) {
+	return ::virtGetObservationFrame(VC, obs);
+}
+
+inline int VirtuoseAPIBackend::virtGetPosition(VirtContext VC, float *pos) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *pos);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETPOSITION]);
+	if (direct) {
+		return direct(VC, pos);
+	}
+#endif
+	return ::virtGetPosition(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtGetPowerOn(VirtContext VC, int *power) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, int *power);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETPOWERON]);
+	if (direct) {
+		return direct(VC, power);
+	}
+#endif
+	return ::virtGetPowerOn(VC, power);
+}
+
+inline int VirtuoseAPIBackend::virtGetSpeed(VirtContext VC, float *speed) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *speed);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETSPEED]);
+	if (direct) {
+		return direct(VC, speed);
+	}
+#endif
+	return ::virtGetSpeed(VC, speed);
+}
+
+inline int VirtuoseAPIBackend::virtGetSpeedFactor(VirtContext VC, float *speed_factor) {
+	return ::virtGetSpeedFactor(VC, speed_factor);
+}
+
+inline int VirtuoseAPIBackend::virtGetTimeLastUpdate(VirtContext VC, unsigned int *time) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, unsigned int *time);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[GETTIMELASTUPDATE]);
+	if (direct) {
+		return direct(VC, time);
+	}
+#endif
+	return ::virtGetTimeLastUpdate(VC, time);
+}
+
+inline int VirtuoseAPIBackend::virtGetTimeoutValue(VirtContext VC, float *time_value) {
+	return ::virtGetTimeoutValue(VC, time_value);
+}
+
+inline int VirtuoseAPIBackend::virtSetBaseFrame(VirtContext VC, float *base) {
+	return ::virtSetBaseFrame(VC, base);
+}
+
+inline int VirtuoseAPIBackend::virtSetCommandType(VirtContext VC, VirtCommandType type) {
+	return ::virtSetCommandType(VC, type);
+}
+
+inline int VirtuoseAPIBackend::virtSetDebugFlags(VirtContext VC, unsigned short flag) {
+	return ::virtSetDebugFlags(VC, flag);
+}
+
+inline int VirtuoseAPIBackend::virtSetForce(VirtContext VC, float *force) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *force);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[SETFORCE]);
+	if (direct) {
+		return direct(VC, force);
+	}
+#endif
+	return ::virtSetForce(VC, force);
+}
+
+inline int VirtuoseAPIBackend::virtSetForceFactor(VirtContext VC, float force_factor) {
+	return ::virtSetForceFactor(VC, force_factor);
+}
+
+inline int VirtuoseAPIBackend::virtSetIndexingMode(VirtContext VC, VirtIndexingType indexing_mode) {
+	return ::virtSetIndexingMode(VC, indexing_mode);
+}
+
+inline int VirtuoseAPIBackend::virtSetLimitTorque(VirtContext VC, float torque) {
+	return ::virtSetLimitTorque(VC, torque);
+}
+
+inline int VirtuoseAPIBackend::virtSetObservationFrame(VirtContext VC, float *obs) {
+	return ::virtSetObservationFrame(VC, obs);
+}
+
+inline int VirtuoseAPIBackend::virtSetObservationFrameSpeed(VirtContext VC, float *speed) {
+	return ::virtSetObservationFrameSpeed(VC, speed);
+}
+
+inline int VirtuoseAPIBackend::virtSetOutputFile(VirtContext VC, char *name) {
+	return ::virtSetOutputFile(VC, name);
+}
+
+inline int VirtuoseAPIBackend::virtSetPeriodicFunction(VirtContext VC, void (*fn)(VirtContext, void *), float *period, void *arg) {
+	return ::virtSetPeriodicFunction(VC, fn, period, arg);
+}
+
+inline int VirtuoseAPIBackend::virtSetPosition(VirtContext VC, float *pos) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *pos);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[SETPOSITION]);
+	if (direct) {
+		return direct(VC, pos);
+	}
+#endif
+	return ::virtSetPosition(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtSetPowerOn(VirtContext VC, int power) {
+	return ::virtSetPowerOn(VC, power);
+}
+
+inline int VirtuoseAPIBackend::virtSetSpeed(VirtContext VC, float *speed) {
+#ifdef VPP_DIRECT_DISPATCH
+	typedef int (*EntryPoint)(VirtContext VC, float *speed);
+	EntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[SETSPEED]);
+	if (direct) {
+		return direct(VC, speed);
+	}
+#endif
+	return ::virtSetSpeed(VC, speed);
+}
+
+inline int VirtuoseAPIBackend::virtSetSpeedFactor(VirtContext VC, float speed_factor) {
+	return ::virtSetSpeedFactor(VC, speed_factor);
+}
+
+inline int VirtuoseAPIBackend::virtSetTexture(VirtContext VC, float *position, float *intensity, int reinit) {
+	return ::virtSetTexture(VC, position, intensity, reinit);
+}
+
+inline int VirtuoseAPIBackend::virtSetTextureForce(VirtContext VC, float *texture_force) {
+	return ::virtSetTextureForce(VC, texture_force);
+}
+
+inline int VirtuoseAPIBackend::virtSetTimeStep(VirtContext VC, float step) {
+	return ::virtSetTimeStep(VC, step);
+}
+
+inline int VirtuoseAPIBackend::virtSetTimeoutValue(VirtContext VC, float time_value) {
+	return ::virtSetTimeoutValue(VC, time_value);
+}
+
+inline int VirtuoseAPIBackend::virtStartLoop(VirtContext VC) {
+	return ::virtStartLoop(VC);
+}
+
+inline int VirtuoseAPIBackend::virtStopLoop(VirtContext VC) {
+	return ::virtStopLoop(VC);
+}
+
+inline int VirtuoseAPIBackend::virtWaitForSynch(VirtContext VC) {
+	return ::virtWaitForSynch(VC);
+}
+
+inline int VirtuoseAPIBackend::virtTrajRecordStart(VirtContext VC) {
+	return ::virtTrajRecordStart(VC);
+}
+
+inline int VirtuoseAPIBackend::virtTrajRecordStop(VirtContext VC) {
+	return ::virtTrajRecordStop(VC);
+}
+
+inline int VirtuoseAPIBackend::virtTrajSetSamplingTimeStep(VirtContext VC, float timeStep, unsigned int *recordTime) {
+	return ::virtTrajSetSamplingTimeStep(VC, timeStep, recordTime);
+}
+
+inline int VirtuoseAPIBackend::virtVmStartTrajSampling(VirtContext VC, unsigned int nbSamples) {
+	return ::virtVmStartTrajSampling(VC, nbSamples);
+}
+
+inline int VirtuoseAPIBackend::virtVmGetTrajSamples(VirtContext VC, float *samples) {
+	return ::virtVmGetTrajSamples(VC, samples);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetType(VirtContext VC, VirtVmType type) {
+	return ::virtVmSetType(VC, type);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetParameter(VirtContext VC, VirtVmParameter *param) {
+	return ::virtVmSetParameter(VC, param);
+}
+
+inline int VirtuoseAPIBackend::virtVmActivate(VirtContext VC) {
+	return ::virtVmActivate(VC);
+}
+
+inline int VirtuoseAPIBackend::virtVmDeactivate(VirtContext VC) {
+	return ::virtVmDeactivate(VC);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetBaseFrame(VirtContext VC, float *base) {
+	return ::virtVmSetBaseFrame(VC, base);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetMaxArtiBounds(VirtContext VC, float *bounds) {
+	return ::virtVmSetMaxArtiBounds(VC, bounds);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetMinArtiBounds(VirtContext VC, float *bounds) {
+	return ::virtVmSetMinArtiBounds(VC, bounds);
+}
+
+inline int VirtuoseAPIBackend::virtGetPhysicalPosition(VirtContext VC, float *pos) {
+	return ::virtGetPhysicalPosition(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtGetAvatarPosition(VirtContext VC, float *pos) {
+	return ::virtGetAvatarPosition(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtSaturateTorque(VirtContext VC, float forceThreshold, float momentThreshold) {
+	return ::virtSaturateTorque(VC, forceThreshold, momentThreshold);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetDefaultToTransparentMode(VirtContext VC) {
+	return ::virtVmSetDefaultToTransparentMode(VC);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetDefaultToCartesianPosition(VirtContext VC) {
+	return ::virtVmSetDefaultToCartesianPosition(VC);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetBaseFrameToCurrentFrame(VirtContext VC) {
+	return ::virtVmSetBaseFrameToCurrentFrame(VC);
+}
+
+inline int VirtuoseAPIBackend::virtConvertRGBToGrayscale(VirtContext VC, float *rgb, float *gray) {
+	return ::virtConvertRGBToGrayscale(VC, rgb, gray);
+}
+
+inline int VirtuoseAPIBackend::virtVmGetBaseFrame(VirtContext VC, float *base) {
+	return ::virtVmGetBaseFrame(VC, base);
+}
+
+inline int VirtuoseAPIBackend::virtWaitPressButton(VirtContext VC, int button_number) {
+	return ::virtWaitPressButton(VC, button_number);
+}
+
+inline int VirtuoseAPIBackend::virtGetTimeStep(VirtContext VC, float *step) {
+	return ::virtGetTimeStep(VC, step);
+}
+
+inline int VirtuoseAPIBackend::virtVmSetRobotMode(VirtContext VC, int OnOff) {
+	return ::virtVmSetRobotMode(VC, OnOff);
+}
+
+inline int VirtuoseAPIBackend::virtVmSaveCurrentSpline(VirtContext VC, char *file_name) {
+	return ::virtVmSaveCurrentSpline(VC, file_name);
+}
+
+inline int VirtuoseAPIBackend::virtVmLoadSpline(VirtContext VC, char *file_name) {
+	return ::virtVmLoadSpline(VC, file_name);
+}
+
+inline int VirtuoseAPIBackend::virtVmDeleteSpline(VirtContext VC, char *file_name) {
+	return ::virtVmDeleteSpline(VC, file_name);
+}
+
+inline int VirtuoseAPIBackend::virtVmWaitUpperBound(VirtContext VC) {
+	return ::virtVmWaitUpperBound(VC);
+}
+
+inline int VirtuoseAPIBackend::virtDisableControlConnexion(VirtContext VC, int disable) {
+	return ::virtDisableControlConnexion(VC, disable);
+}
+
+inline int VirtuoseAPIBackend::virtIsInBounds(VirtContext VC, unsigned int *bounds) {
+	return ::virtIsInBounds(VC, bounds);
+}
+
+inline int VirtuoseAPIBackend::virtGetAlarm(VirtContext VC, unsigned int *alarm) {
+	return ::virtGetAlarm(VC, alarm);
+}
+
+inline int VirtuoseAPIBackend::virtGetCatchFrame(VirtContext VC, float *frame) {
+	return ::virtGetCatchFrame(VC, frame);
+}
+
+inline int VirtuoseAPIBackend::virtSetCatchFrame(VirtContext VC, float *frame) {
+	return ::virtSetCatchFrame(VC, frame);
+}
+
+inline int VirtuoseAPIBackend::virtActiveSpeedControl(VirtContext VC, float radius, float speedFactor) {
+	return ::virtActiveSpeedControl(VC, radius, speedFactor);
+}
+
+inline int VirtuoseAPIBackend::virtDeactiveSpeedControl(VirtContext VC) {
+	return ::virtDeactiveSpeedControl(VC);
+}
+
+inline int VirtuoseAPIBackend::virtIsInShiftPosition(VirtContext VC, int *shift) {
+	return ::virtIsInShiftPosition(VC, shift);
+}
+
+inline int VirtuoseAPIBackend::virtSetFrictionForce(VirtContext VC, float fx, float fy, float fz) {
+	return ::virtSetFrictionForce(VC, fx, fy, fz);
+}
+
+inline int VirtuoseAPIBackend::virtGetMouseState(VirtContext VC, int *active, int *left_click, int *right_click) {
+	return ::virtGetMouseState(VC, active, left_click, right_click);
+}
+
+inline int VirtuoseAPIBackend::virtGenerateDebugFile(VirtContext VC) {
+	return ::virtGenerateDebugFile(VC);
+}
+
+inline int VirtuoseAPIBackend::virtGetCenterSphere(VirtContext VC, float *pos) {
+	return ::virtGetCenterSphere(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtGetAxisOfRotation(VirtContext VC, float *axis) {
+	return ::virtGetAxisOfRotation(VC, axis);
+}
+
+inline int VirtuoseAPIBackend::virtGetADC(VirtContext VC, int line, float *adc) {
+	return ::virtGetADC(VC, line, adc);
+}
+
+inline int VirtuoseAPIBackend::virtConvertDeplToHomogeneMatrix(VirtContext VC, float *d, float *m) {
+	return ::virtConvertDeplToHomogeneMatrix(VC, d, m);
+}
+
+inline int VirtuoseAPIBackend::virtConvertHomogeneMatrixToDepl(VirtContext VC, float *d, float *m) {
+	return ::virtConvertHomogeneMatrixToDepl(VC, d, m);
+}
+
+inline int VirtuoseAPIBackend::virtGetTrackball(VirtContext VC, int *x_move, int *y_move) {
+	return ::virtGetTrackball(VC, x_move, y_move);
+}
+
+inline int VirtuoseAPIBackend::virtGetTrackballButton(VirtContext VC, int *active, int *left_btn, int *middle_btn, int *right_btn) {
+	return ::virtGetTrackballButton(VC, active, left_btn, middle_btn, right_btn);
+}
+
+inline int VirtuoseAPIBackend::virtSetAbsolutePosition(VirtContext VC, float *pos) {
+	return ::virtSetAbsolutePosition(VC, pos);
+}
+
+inline int VirtuoseAPIBackend::virtBeepOnLimit(VirtContext VC, int enable) {
+	return ::virtBeepOnLimit(VC, enable);
+}
+
+inline int VirtuoseAPIBackend::virtEnableForceFeedback(VirtContext VC, int enable) {
+	return ::virtEnableForceFeedback(VC, enable);
+}
+
+inline int VirtuoseAPIBackend::virtGetPhysicalSpeed(VirtContext VC, float *speed) {
+	return ::virtGetPhysicalSpeed(VC, speed);
+}
+
+inline int VirtuoseAPIBackend::virtForceShiftButton(VirtContext VC, int forceShiftButton) {
+	return ::virtForceShiftButton(VC, forceShiftButton);
+}
+
+inline int VirtuoseAPIBackend::virtAddForce(VirtContext VC, float *force) {
+	return ::virtAddForce(VC, force);
+}
+
+/* Wrapper Implementation Details Follow */
+
+template<typename Backend>
+inline int BasicVirtuoseMethods<Backend>::APIVersion(int *major, int *minor) {
+	return VPP_PROFILE_CALL(APIVersion, Backend::virtAPIVersion(major, minor));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::attachVO(float mass, float *mxmymz) {
+	
+			int ret = VPP_PROFILE_CALL(attachVO, Backend::virtAttachVO(vc_, mass, mxmymz));
+			VPP_CHECK_RETURN(ret, "virtAttachVO(vc_, mass, mxmymz)");
+			return VPP_STATUS(ret);
 }
 
-inline bool Virtuose::hasError() {
-	return (virtGetErrorCode(vc_) != VIRT_E_NO_ERROR);
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryAttachVO(float mass, float *mxmymz) {
+	return _result(VPP_PROFILE_CALL(attachVO, Backend::virtAttachVO(vc_, mass, mxmymz)));
 }
 
-inline std::string Virtuose::getErrorOrEmpty() {
-	std::string ret;
-	int code = virtGetErrorCode(vc_);
-	if (virtGetErrorCode(vc_) != VIRT_E_NO_ERROR) {
-		ret = getErrorMessage(code);
-	}
-	return ret;
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::attachQSVO(float *Ks, float *Bs) {
+	
+			int ret = VPP_PROFILE_CALL(attachQSVO, Backend::virtAttachQSVO(vc_, Ks, Bs));
+			VPP_CHECK_RETURN(ret, "virtAttachQSVO(vc_, Ks, Bs)");
+			return VPP_STATUS(ret);
 }
 
-/** @brief Returns the latest error message.
-*/
-inline std::string Virtuose::getErrorMessage() {
-	return getErrorMessage(virtGetErrorCode(vc_));
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryAttachQSVO(float *Ks, float *Bs) {
+	return _result(VPP_PROFILE_CALL(attachQSVO, Backend::virtAttachQSVO(vc_, Ks, Bs)));
 }
 
-/** @brief Converts an error code into an error message string.
-*/
-inline std::string Virtuose::getErrorMessage(int code) {
-	return virtGetErrorMessage(code);
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::attachVOAvatar(float mass, float *mxmymz) {
+	
+			int ret = VPP_PROFILE_CALL(attachVOAvatar, Backend::virtAttachVOAvatar(vc_, mass, mxmymz));
+			VPP_CHECK_RETURN(ret, "virtAttachVOAvatar(vc_, mass, mxmymz)");
+			return VPP_STATUS(ret);
 }
 
-/// @brief Equality between a Virtuose object and a raw VirtContext.
-inline bool operator==(Virtuose const& v, VirtContext const vc) {
-	return (v.getVirtContext() == vc);
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryAttachVOAvatar(float mass, float *mxmymz) {
+	return _result(VPP_PROFILE_CALL(attachVOAvatar, Backend::virtAttachVOAvatar(vc_, mass, mxmymz)));
 }
 
-/// @brief Equality between a raw VirtContext and a Virtuose object.
-inline bool operator==(VirtContext const vc, Virtuose const& v) {
-	return (v.getVirtContext() == vc);
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::detachVO() {
+	
+			int ret = VPP_PROFILE_CALL(detachVO, Backend::virtDetachVO(vc_));
+			VPP_CHECK_RETURN(ret, "virtDetachVO(vc_)");
+			return VPP_STATUS(ret);
 }
 
-/// @brief Equality between two Virtuose objects - this should always be false!
-inline bool operator==(Virtuose const& v1, Virtuose const& v2) {
-	return (v1.getVirtContext() == v2.getVirtContext());
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryDetachVO() {
+	return _result(VPP_PROFILE_CALL(detachVO, Backend::virtDetachVO(vc_)));
 }
 
-/// @brief Less-than comparison between Virtuose objects
-inline bool operator<(Virtuose const& v1, Virtuose const& v2) {
-	return (v1.getVirtContext() < v2.getVirtContext());
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::detachVOAvatar() {
+	
+			int ret = VPP_PROFILE_CALL(detachVOAvatar, Backend::virtDetachVOAvatar(vc_));
+			VPP_CHECK_RETURN(ret, "virtDetachVOAvatar(vc_)");
+			return VPP_STATUS(ret);
 }
 
-/* Wrapper Implementation Details Follow */
-
-inline int Virtuose::APIVersion(int *major, int *minor) {
-	return virtAPIVersion(major, minor);
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryDetachVOAvatar() {
+	return _result(VPP_PROFILE_CALL(detachVOAvatar, Backend::virtDetachVOAvatar(vc_)));
 }
 
-inline int Virtuose::attachVO(float mass, float *mxmymz) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::displayHardwareStatus(FILE *fh) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtAttachVO(vc_, mass, mxmymz));
-			return ret;
+			int ret = VPP_PROFILE_CALL(displayHardwareStatus, Backend::virtDisplayHardwareStatus(vc_, fh));
+			VPP_CHECK_RETURN(ret, "virtDisplayHardwareStatus(vc_, fh)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::attachQSVO(float *Ks, float *Bs) {
-	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtAttachQSVO(vc_, Ks, Bs));
-			return ret;
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryDisplayHardwareStatus(FILE *fh) {
+	return _result(VPP_PROFILE_CALL(displayHardwareStatus, Backend::virtDisplayHardwareStatus(vc_, fh)));
 }
 
-inline int Virtuose::attachVOAvatar(float mass, float *mxmymz) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getBaseFrame(float *base) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtAttachVOAvatar(vc_, mass, mxmymz));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getBaseFrame, Backend::virtGetBaseFrame(vc_, base));
+			VPP_CHECK_RETURN(ret, "virtGetBaseFrame(vc_, base)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::detachVO() {
-	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtDetachVO(vc_));
-			return ret;
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetBaseFrame(float *base) {
+	return _result(VPP_PROFILE_CALL(getBaseFrame, Backend::virtGetBaseFrame(vc_, base)));
 }
 
-inline int Virtuose::detachVOAvatar() {
-	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtDetachVOAvatar(vc_));
-			return ret;
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getBaseFrame() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getBaseFrame(ret.data));
+	return ret;
 }
 
-inline int Virtuose::displayHardwareStatus(FILE *fh) {
-	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtDisplayHardwareStatus(vc_, fh));
-			return ret;
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetBaseFrame() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetBaseFrame(ret.data));
+	return ret;
 }
 
-inline int Virtuose::getBaseFrame(float *base) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getButton(int button_number, int *state) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetBaseFrame(vc_, base));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getButton, Backend::virtGetButton(vc_, button_number, state));
+			VPP_CHECK_RETURN(ret, "virtGetButton(vc_, button_number, state)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getButton(int button_number, int *state) {
-	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetButton(vc_, button_number, state));
-			return ret;
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetButton(int button_number, int *state) {
+	return _result(VPP_PROFILE_CALL(getButton, Backend::virtGetButton(vc_, button_number, state)));
 }
 
-inline int Virtuose::getCommandType(VirtCommandType *type) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getCommandType(VirtCommandType *type) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetCommandType(vc_, type));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getCommandType, Backend::virtGetCommandType(vc_, type));
+			VPP_CHECK_RETURN(ret, "virtGetCommandType(vc_, type)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getDeadMan(int *dead_man) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetCommandType(VirtCommandType *type) {
+	return _result(VPP_PROFILE_CALL(getCommandType, Backend::virtGetCommandType(vc_, type)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getDeadMan(int *dead_man) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetDeadMan(vc_, dead_man));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getDeadMan, Backend::virtGetDeadMan(vc_, dead_man));
+			VPP_CHECK_RETURN(ret, "virtGetDeadMan(vc_, dead_man)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetDeadMan(int *dead_man) {
+	return _result(VPP_PROFILE_CALL(getDeadMan, Backend::virtGetDeadMan(vc_, dead_man)));
 }
 
-inline int Virtuose::getEmergencyStop(int *emergency_stop) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getEmergencyStop(int *emergency_stop) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetEmergencyStop(vc_, emergency_stop));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getEmergencyStop, Backend::virtGetEmergencyStop(vc_, emergency_stop));
+			VPP_CHECK_RETURN(ret, "virtGetEmergencyStop(vc_, emergency_stop)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getError(int *error) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetEmergencyStop(int *emergency_stop) {
+	return _result(VPP_PROFILE_CALL(getEmergencyStop, Backend::virtGetEmergencyStop(vc_, emergency_stop)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getError(int *error) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetError(vc_, error));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getError, Backend::virtGetError(vc_, error));
+			VPP_CHECK_RETURN(ret, "virtGetError(vc_, error)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetError(int *error) {
+	return _result(VPP_PROFILE_CALL(getError, Backend::virtGetError(vc_, error)));
 }
 
-inline int Virtuose::getErrorCode() {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getErrorCode() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetErrorCode(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getErrorCode, Backend::virtGetErrorCode(vc_));
+			VPP_CHECK_RETURN(ret, "virtGetErrorCode(vc_)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getForce(float *force) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetErrorCode() {
+	return _result(VPP_PROFILE_CALL(getErrorCode, Backend::virtGetErrorCode(vc_)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getForce(float *force) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetForce(vc_, force));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getForce, Backend::virtGetForce(vc_, force));
+			VPP_CHECK_RETURN(ret, "virtGetForce(vc_, force)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetForce(float *force) {
+	return _result(VPP_PROFILE_CALL(getForce, Backend::virtGetForce(vc_, force)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseWrench>::type BasicVirtuoseMethods<Backend>::getForce() {
+	VirtuoseValue<VirtuoseWrench>::type ret;
+	_setStatus(ret, getForce(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseWrench> BasicVirtuoseMethods<Backend>::tryGetForce() {
+	VirtuoseExpected<VirtuoseWrench> ret;
+	_setStatus(ret, tryGetForce(ret.data));
+	return ret;
 }
 
-inline int Virtuose::getForceFactor(float *force_factor) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getForceFactor(float *force_factor) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetForceFactor(vc_, force_factor));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getForceFactor, Backend::virtGetForceFactor(vc_, force_factor));
+			VPP_CHECK_RETURN(ret, "virtGetForceFactor(vc_, force_factor)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetForceFactor(float *force_factor) {
+	return _result(VPP_PROFILE_CALL(getForceFactor, Backend::virtGetForceFactor(vc_, force_factor)));
 }
 
-inline int Virtuose::getIndexingMode(VirtIndexingType *indexing_mode) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getIndexingMode(VirtIndexingType *indexing_mode) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetIndexingMode(vc_, indexing_mode));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getIndexingMode, Backend::virtGetIndexingMode(vc_, indexing_mode));
+			VPP_CHECK_RETURN(ret, "virtGetIndexingMode(vc_, indexing_mode)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getLimitTorque(float *torque) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetIndexingMode(VirtIndexingType *indexing_mode) {
+	return _result(VPP_PROFILE_CALL(getIndexingMode, Backend::virtGetIndexingMode(vc_, indexing_mode)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getLimitTorque(float *torque) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetLimitTorque(vc_, torque));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getLimitTorque, Backend::virtGetLimitTorque(vc_, torque));
+			VPP_CHECK_RETURN(ret, "virtGetLimitTorque(vc_, torque)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetLimitTorque(float *torque) {
+	return _result(VPP_PROFILE_CALL(getLimitTorque, Backend::virtGetLimitTorque(vc_, torque)));
 }
 
-inline int Virtuose::getObservationFrame(float *obs) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getObservationFrame(float *obs) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetObservationFrame(vc_, obs));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getObservationFrame, Backend::virtGetObservationFrame(vc_, obs));
+			VPP_CHECK_RETURN(ret, "virtGetObservationFrame(vc_, obs)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getPosition(float *pos) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetObservationFrame(float *obs) {
+	return _result(VPP_PROFILE_CALL(getObservationFrame, Backend::virtGetObservationFrame(vc_, obs)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getObservationFrame() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getObservationFrame(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetObservationFrame() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetObservationFrame(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getPosition(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetPosition(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getPosition, Backend::virtGetPosition(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtGetPosition(vc_, pos)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetPosition(float *pos) {
+	return _result(VPP_PROFILE_CALL(getPosition, Backend::virtGetPosition(vc_, pos)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getPosition() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getPosition(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetPosition() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetPosition(ret.data));
+	return ret;
 }
 
-inline int Virtuose::getPowerOn(int *power) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getPowerOn(int *power) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetPowerOn(vc_, power));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getPowerOn, Backend::virtGetPowerOn(vc_, power));
+			VPP_CHECK_RETURN(ret, "virtGetPowerOn(vc_, power)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getSpeed(float *speed) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetPowerOn(int *power) {
+	return _result(VPP_PROFILE_CALL(getPowerOn, Backend::virtGetPowerOn(vc_, power)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getSpeed(float *speed) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetSpeed(vc_, speed));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getSpeed, Backend::virtGetSpeed(vc_, speed));
+			VPP_CHECK_RETURN(ret, "virtGetSpeed(vc_, speed)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetSpeed(float *speed) {
+	return _result(VPP_PROFILE_CALL(getSpeed, Backend::virtGetSpeed(vc_, speed)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseTwist>::type BasicVirtuoseMethods<Backend>::getSpeed() {
+	VirtuoseValue<VirtuoseTwist>::type ret;
+	_setStatus(ret, getSpeed(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseTwist> BasicVirtuoseMethods<Backend>::tryGetSpeed() {
+	VirtuoseExpected<VirtuoseTwist> ret;
+	_setStatus(ret, tryGetSpeed(ret.data));
+	return ret;
 }
 
-inline int Virtuose::getSpeedFactor(float *speed_factor) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getSpeedFactor(float *speed_factor) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetSpeedFactor(vc_, speed_factor));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getSpeedFactor, Backend::virtGetSpeedFactor(vc_, speed_factor));
+			VPP_CHECK_RETURN(ret, "virtGetSpeedFactor(vc_, speed_factor)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetSpeedFactor(float *speed_factor) {
+	return _result(VPP_PROFILE_CALL(getSpeedFactor, Backend::virtGetSpeedFactor(vc_, speed_factor)));
 }
 
-inline int Virtuose::getTimeLastUpdate(unsigned int *time) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getTimeLastUpdate(unsigned int *time) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetTimeLastUpdate(vc_, time));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getTimeLastUpdate, Backend::virtGetTimeLastUpdate(vc_, time));
+			VPP_CHECK_RETURN(ret, "virtGetTimeLastUpdate(vc_, time)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getTimeoutValue(float *time_value) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetTimeLastUpdate(unsigned int *time) {
+	return _result(VPP_PROFILE_CALL(getTimeLastUpdate, Backend::virtGetTimeLastUpdate(vc_, time)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getTimeoutValue(float *time_value) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetTimeoutValue(vc_, time_value));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getTimeoutValue, Backend::virtGetTimeoutValue(vc_, time_value));
+			VPP_CHECK_RETURN(ret, "virtGetTimeoutValue(vc_, time_value)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetTimeoutValue(float *time_value) {
+	return _result(VPP_PROFILE_CALL(getTimeoutValue, Backend::virtGetTimeoutValue(vc_, time_value)));
 }
 
-inline int Virtuose::setBaseFrame(float *base) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setBaseFrame(float *base) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetBaseFrame(vc_, base));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setBaseFrame, Backend::virtSetBaseFrame(vc_, base));
+			VPP_CHECK_RETURN(ret, "virtSetBaseFrame(vc_, base)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setCommandType(VirtCommandType type) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetBaseFrame(float *base) {
+	return _result(VPP_PROFILE_CALL(setBaseFrame, Backend::virtSetBaseFrame(vc_, base)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setCommandType(VirtCommandType type) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetCommandType(vc_, type));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setCommandType, Backend::virtSetCommandType(vc_, type));
+			VPP_CHECK_RETURN(ret, "virtSetCommandType(vc_, type)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetCommandType(VirtCommandType type) {
+	return _result(VPP_PROFILE_CALL(setCommandType, Backend::virtSetCommandType(vc_, type)));
 }
 
-inline int Virtuose::setDebugFlags(unsigned short flag) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setDebugFlags(unsigned short flag) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetDebugFlags(vc_, flag));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setDebugFlags, Backend::virtSetDebugFlags(vc_, flag));
+			VPP_CHECK_RETURN(ret, "virtSetDebugFlags(vc_, flag)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setForce(float *force) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetDebugFlags(unsigned short flag) {
+	return _result(VPP_PROFILE_CALL(setDebugFlags, Backend::virtSetDebugFlags(vc_, flag)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setForce(float *force) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetForce(vc_, force));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setForce, Backend::virtSetForce(vc_, force));
+			VPP_CHECK_RETURN(ret, "virtSetForce(vc_, force)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetForce(float *force) {
+	return _result(VPP_PROFILE_CALL(setForce, Backend::virtSetForce(vc_, force)));
 }
 
-inline int Virtuose::setForceFactor(float force_factor) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setForceFactor(float force_factor) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetForceFactor(vc_, force_factor));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setForceFactor, Backend::virtSetForceFactor(vc_, force_factor));
+			VPP_CHECK_RETURN(ret, "virtSetForceFactor(vc_, force_factor)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setIndexingMode(VirtIndexingType indexing_mode) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetForceFactor(float force_factor) {
+	return _result(VPP_PROFILE_CALL(setForceFactor, Backend::virtSetForceFactor(vc_, force_factor)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setIndexingMode(VirtIndexingType indexing_mode) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetIndexingMode(vc_, indexing_mode));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setIndexingMode, Backend::virtSetIndexingMode(vc_, indexing_mode));
+			VPP_CHECK_RETURN(ret, "virtSetIndexingMode(vc_, indexing_mode)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetIndexingMode(VirtIndexingType indexing_mode) {
+	return _result(VPP_PROFILE_CALL(setIndexingMode, Backend::virtSetIndexingMode(vc_, indexing_mode)));
 }
 
-inline int Virtuose::setLimitTorque(float torque) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setLimitTorque(float torque) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetLimitTorque(vc_, torque));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setLimitTorque, Backend::virtSetLimitTorque(vc_, torque));
+			VPP_CHECK_RETURN(ret, "virtSetLimitTorque(vc_, torque)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setObservationFrame(float *obs) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetLimitTorque(float torque) {
+	return _result(VPP_PROFILE_CALL(setLimitTorque, Backend::virtSetLimitTorque(vc_, torque)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setObservationFrame(float *obs) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetObservationFrame(vc_, obs));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setObservationFrame, Backend::virtSetObservationFrame(vc_, obs));
+			VPP_CHECK_RETURN(ret, "virtSetObservationFrame(vc_, obs)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetObservationFrame(float *obs) {
+	return _result(VPP_PROFILE_CALL(setObservationFrame, Backend::virtSetObservationFrame(vc_, obs)));
 }
 
-inline int Virtuose::setObservationFrameSpeed(float *speed) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setObservationFrameSpeed(float *speed) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetObservationFrameSpeed(vc_, speed));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setObservationFrameSpeed, Backend::virtSetObservationFrameSpeed(vc_, speed));
+			VPP_CHECK_RETURN(ret, "virtSetObservationFrameSpeed(vc_, speed)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setOutputFile(char *name) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetObservationFrameSpeed(float *speed) {
+	return _result(VPP_PROFILE_CALL(setObservationFrameSpeed, Backend::virtSetObservationFrameSpeed(vc_, speed)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setOutputFile(char *name) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetOutputFile(vc_, name));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setOutputFile, Backend::virtSetOutputFile(vc_, name));
+			VPP_CHECK_RETURN(ret, "virtSetOutputFile(vc_, name)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetOutputFile(char *name) {
+	return _result(VPP_PROFILE_CALL(setOutputFile, Backend::virtSetOutputFile(vc_, name)));
 }
 
-inline int Virtuose::setPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetPeriodicFunction(vc_, fn, period, arg));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setPeriodicFunction, Backend::virtSetPeriodicFunction(vc_, fn, period, arg));
+			VPP_CHECK_RETURN(ret, "virtSetPeriodicFunction(vc_, fn, period, arg)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setPosition(float *pos) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetPeriodicFunction(void (*fn)(VirtContext, void *), float *period, void *arg) {
+	return _result(VPP_PROFILE_CALL(setPeriodicFunction, Backend::virtSetPeriodicFunction(vc_, fn, period, arg)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setPosition(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetPosition(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setPosition, Backend::virtSetPosition(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtSetPosition(vc_, pos)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetPosition(float *pos) {
+	return _result(VPP_PROFILE_CALL(setPosition, Backend::virtSetPosition(vc_, pos)));
 }
 
-inline int Virtuose::setPowerOn(int power) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setPowerOn(int power) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetPowerOn(vc_, power));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setPowerOn, Backend::virtSetPowerOn(vc_, power));
+			VPP_CHECK_RETURN(ret, "virtSetPowerOn(vc_, power)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setSpeed(float *speed) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetPowerOn(int power) {
+	return _result(VPP_PROFILE_CALL(setPowerOn, Backend::virtSetPowerOn(vc_, power)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setSpeed(float *speed) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetSpeed(vc_, speed));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setSpeed, Backend::virtSetSpeed(vc_, speed));
+			VPP_CHECK_RETURN(ret, "virtSetSpeed(vc_, speed)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetSpeed(float *speed) {
+	return _result(VPP_PROFILE_CALL(setSpeed, Backend::virtSetSpeed(vc_, speed)));
 }
 
-inline int Virtuose::setSpeedFactor(float speed_factor) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setSpeedFactor(float speed_factor) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetSpeedFactor(vc_, speed_factor));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setSpeedFactor, Backend::virtSetSpeedFactor(vc_, speed_factor));
+			VPP_CHECK_RETURN(ret, "virtSetSpeedFactor(vc_, speed_factor)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setTexture(float *position, float *intensity, int reinit) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetSpeedFactor(float speed_factor) {
+	return _result(VPP_PROFILE_CALL(setSpeedFactor, Backend::virtSetSpeedFactor(vc_, speed_factor)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setTexture(float *position, float *intensity, int reinit) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetTexture(vc_, position, intensity, reinit));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setTexture, Backend::virtSetTexture(vc_, position, intensity, reinit));
+			VPP_CHECK_RETURN(ret, "virtSetTexture(vc_, position, intensity, reinit)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetTexture(float *position, float *intensity, int reinit) {
+	return _result(VPP_PROFILE_CALL(setTexture, Backend::virtSetTexture(vc_, position, intensity, reinit)));
 }
 
-inline int Virtuose::setTextureForce(float *texture_force) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setTextureForce(float *texture_force) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetTextureForce(vc_, texture_force));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setTextureForce, Backend::virtSetTextureForce(vc_, texture_force));
+			VPP_CHECK_RETURN(ret, "virtSetTextureForce(vc_, texture_force)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setTimeStep(float step) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetTextureForce(float *texture_force) {
+	return _result(VPP_PROFILE_CALL(setTextureForce, Backend::virtSetTextureForce(vc_, texture_force)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setTimeStep(float step) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetTimeStep(vc_, step));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setTimeStep, Backend::virtSetTimeStep(vc_, step));
+			VPP_CHECK_RETURN(ret, "virtSetTimeStep(vc_, step)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetTimeStep(float step) {
+	return _result(VPP_PROFILE_CALL(setTimeStep, Backend::virtSetTimeStep(vc_, step)));
 }
 
-inline int Virtuose::setTimeoutValue(float time_value) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setTimeoutValue(float time_value) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetTimeoutValue(vc_, time_value));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setTimeoutValue, Backend::virtSetTimeoutValue(vc_, time_value));
+			VPP_CHECK_RETURN(ret, "virtSetTimeoutValue(vc_, time_value)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::startLoop() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetTimeoutValue(float time_value) {
+	return _result(VPP_PROFILE_CALL(setTimeoutValue, Backend::virtSetTimeoutValue(vc_, time_value)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::startLoop() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtStartLoop(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(startLoop, Backend::virtStartLoop(vc_));
+			VPP_CHECK_RETURN(ret, "virtStartLoop(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryStartLoop() {
+	return _result(VPP_PROFILE_CALL(startLoop, Backend::virtStartLoop(vc_)));
 }
 
-inline int Virtuose::stopLoop() {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::stopLoop() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtStopLoop(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(stopLoop, Backend::virtStopLoop(vc_));
+			VPP_CHECK_RETURN(ret, "virtStopLoop(vc_)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::waitForSynch() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryStopLoop() {
+	return _result(VPP_PROFILE_CALL(stopLoop, Backend::virtStopLoop(vc_)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::waitForSynch() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtWaitForSynch(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(waitForSynch, Backend::virtWaitForSynch(vc_));
+			VPP_CHECK_RETURN(ret, "virtWaitForSynch(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryWaitForSynch() {
+	return _result(VPP_PROFILE_CALL(waitForSynch, Backend::virtWaitForSynch(vc_)));
 }
 
-inline int Virtuose::trajRecordStart() {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::trajRecordStart() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtTrajRecordStart(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(trajRecordStart, Backend::virtTrajRecordStart(vc_));
+			VPP_CHECK_RETURN(ret, "virtTrajRecordStart(vc_)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::trajRecordStop() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryTrajRecordStart() {
+	return _result(VPP_PROFILE_CALL(trajRecordStart, Backend::virtTrajRecordStart(vc_)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::trajRecordStop() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtTrajRecordStop(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(trajRecordStop, Backend::virtTrajRecordStop(vc_));
+			VPP_CHECK_RETURN(ret, "virtTrajRecordStop(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryTrajRecordStop() {
+	return _result(VPP_PROFILE_CALL(trajRecordStop, Backend::virtTrajRecordStop(vc_)));
 }
 
-inline int Virtuose::trajSetSamplingTimeStep(float timeStep, unsigned int *recordTime) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::trajSetSamplingTimeStep(float timeStep, unsigned int *recordTime) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtTrajSetSamplingTimeStep(vc_, timeStep, recordTime));
-			return ret;
+			int ret = VPP_PROFILE_CALL(trajSetSamplingTimeStep, Backend::virtTrajSetSamplingTimeStep(vc_, timeStep, recordTime));
+			VPP_CHECK_RETURN(ret, "virtTrajSetSamplingTimeStep(vc_, timeStep, recordTime)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmStartTrajSampling(unsigned int nbSamples) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryTrajSetSamplingTimeStep(float timeStep, unsigned int *recordTime) {
+	return _result(VPP_PROFILE_CALL(trajSetSamplingTimeStep, Backend::virtTrajSetSamplingTimeStep(vc_, timeStep, recordTime)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmStartTrajSampling(unsigned int nbSamples) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmStartTrajSampling(vc_, nbSamples));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmStartTrajSampling, Backend::virtVmStartTrajSampling(vc_, nbSamples));
+			VPP_CHECK_RETURN(ret, "virtVmStartTrajSampling(vc_, nbSamples)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmStartTrajSampling(unsigned int nbSamples) {
+	return _result(VPP_PROFILE_CALL(vmStartTrajSampling, Backend::virtVmStartTrajSampling(vc_, nbSamples)));
 }
 
-inline int Virtuose::vmGetTrajSamples(float *samples) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmGetTrajSamples(float *samples) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmGetTrajSamples(vc_, samples));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmGetTrajSamples, Backend::virtVmGetTrajSamples(vc_, samples));
+			VPP_CHECK_RETURN(ret, "virtVmGetTrajSamples(vc_, samples)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetType(VirtVmType type) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmGetTrajSamples(float *samples) {
+	return _result(VPP_PROFILE_CALL(vmGetTrajSamples, Backend::virtVmGetTrajSamples(vc_, samples)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetType(VirtVmType type) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetType(vc_, type));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetType, Backend::virtVmSetType(vc_, type));
+			VPP_CHECK_RETURN(ret, "virtVmSetType(vc_, type)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetType(VirtVmType type) {
+	return _result(VPP_PROFILE_CALL(vmSetType, Backend::virtVmSetType(vc_, type)));
 }
 
-inline int Virtuose::vmSetParameter(VirtVmParameter *param) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetParameter(VirtVmParameter *param) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetParameter(vc_, param));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetParameter, Backend::virtVmSetParameter(vc_, param));
+			VPP_CHECK_RETURN(ret, "virtVmSetParameter(vc_, param)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmActivate() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetParameter(VirtVmParameter *param) {
+	return _result(VPP_PROFILE_CALL(vmSetParameter, Backend::virtVmSetParameter(vc_, param)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmActivate() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmActivate(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmActivate, Backend::virtVmActivate(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmActivate(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmActivate() {
+	return _result(VPP_PROFILE_CALL(vmActivate, Backend::virtVmActivate(vc_)));
 }
 
-inline int Virtuose::vmDeactivate() {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmDeactivate() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmDeactivate(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmDeactivate, Backend::virtVmDeactivate(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmDeactivate(vc_)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetBaseFrame(float *base) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmDeactivate() {
+	return _result(VPP_PROFILE_CALL(vmDeactivate, Backend::virtVmDeactivate(vc_)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetBaseFrame(float *base) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetBaseFrame(vc_, base));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetBaseFrame, Backend::virtVmSetBaseFrame(vc_, base));
+			VPP_CHECK_RETURN(ret, "virtVmSetBaseFrame(vc_, base)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetBaseFrame(float *base) {
+	return _result(VPP_PROFILE_CALL(vmSetBaseFrame, Backend::virtVmSetBaseFrame(vc_, base)));
 }
 
-inline int Virtuose::vmSetMaxArtiBounds(float *bounds) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetMaxArtiBounds(float *bounds) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetMaxArtiBounds(vc_, bounds));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetMaxArtiBounds, Backend::virtVmSetMaxArtiBounds(vc_, bounds));
+			VPP_CHECK_RETURN(ret, "virtVmSetMaxArtiBounds(vc_, bounds)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetMinArtiBounds(float *bounds) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetMaxArtiBounds(float *bounds) {
+	return _result(VPP_PROFILE_CALL(vmSetMaxArtiBounds, Backend::virtVmSetMaxArtiBounds(vc_, bounds)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetMinArtiBounds(float *bounds) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetMinArtiBounds(vc_, bounds));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetMinArtiBounds, Backend::virtVmSetMinArtiBounds(vc_, bounds));
+			VPP_CHECK_RETURN(ret, "virtVmSetMinArtiBounds(vc_, bounds)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetMinArtiBounds(float *bounds) {
+	return _result(VPP_PROFILE_CALL(vmSetMinArtiBounds, Backend::virtVmSetMinArtiBounds(vc_, bounds)));
 }
 
-inline int Virtuose::getPhysicalPosition(float *pos) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getPhysicalPosition(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetPhysicalPosition(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getPhysicalPosition, Backend::virtGetPhysicalPosition(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtGetPhysicalPosition(vc_, pos)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetPhysicalPosition(float *pos) {
+	return _result(VPP_PROFILE_CALL(getPhysicalPosition, Backend::virtGetPhysicalPosition(vc_, pos)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getPhysicalPosition() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getPhysicalPosition(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetPhysicalPosition() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetPhysicalPosition(ret.data));
+	return ret;
 }
 
-inline int Virtuose::getAvatarPosition(float *pos) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getAvatarPosition(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetAvatarPosition(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getAvatarPosition, Backend::virtGetAvatarPosition(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtGetAvatarPosition(vc_, pos)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetAvatarPosition(float *pos) {
+	return _result(VPP_PROFILE_CALL(getAvatarPosition, Backend::virtGetAvatarPosition(vc_, pos)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getAvatarPosition() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getAvatarPosition(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetAvatarPosition() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetAvatarPosition(ret.data));
+	return ret;
 }
 
-inline int Virtuose::saturateTorque(float forceThreshold, float momentThreshold) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::saturateTorque(float forceThreshold, float momentThreshold) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSaturateTorque(vc_, forceThreshold, momentThreshold));
-			return ret;
+			int ret = VPP_PROFILE_CALL(saturateTorque, Backend::virtSaturateTorque(vc_, forceThreshold, momentThreshold));
+			VPP_CHECK_RETURN(ret, "virtSaturateTorque(vc_, forceThreshold, momentThreshold)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetDefaultToTransparentMode() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySaturateTorque(float forceThreshold, float momentThreshold) {
+	return _result(VPP_PROFILE_CALL(saturateTorque, Backend::virtSaturateTorque(vc_, forceThreshold, momentThreshold)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetDefaultToTransparentMode() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetDefaultToTransparentMode(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetDefaultToTransparentMode, Backend::virtVmSetDefaultToTransparentMode(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmSetDefaultToTransparentMode(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetDefaultToTransparentMode() {
+	return _result(VPP_PROFILE_CALL(vmSetDefaultToTransparentMode, Backend::virtVmSetDefaultToTransparentMode(vc_)));
 }
 
-inline int Virtuose::vmSetDefaultToCartesianPosition() {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetDefaultToCartesianPosition() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetDefaultToCartesianPosition(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetDefaultToCartesianPosition, Backend::virtVmSetDefaultToCartesianPosition(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmSetDefaultToCartesianPosition(vc_)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetBaseFrameToCurrentFrame() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetDefaultToCartesianPosition() {
+	return _result(VPP_PROFILE_CALL(vmSetDefaultToCartesianPosition, Backend::virtVmSetDefaultToCartesianPosition(vc_)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetBaseFrameToCurrentFrame() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetBaseFrameToCurrentFrame(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetBaseFrameToCurrentFrame, Backend::virtVmSetBaseFrameToCurrentFrame(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmSetBaseFrameToCurrentFrame(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetBaseFrameToCurrentFrame() {
+	return _result(VPP_PROFILE_CALL(vmSetBaseFrameToCurrentFrame, Backend::virtVmSetBaseFrameToCurrentFrame(vc_)));
 }
 
-inline int Virtuose::convertRGBToGrayscale(float *rgb, float *gray) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::convertRGBToGrayscale(float *rgb, float *gray) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtConvertRGBToGrayscale(vc_, rgb, gray));
-			return ret;
+			int ret = VPP_PROFILE_CALL(convertRGBToGrayscale, Backend::virtConvertRGBToGrayscale(vc_, rgb, gray));
+			VPP_CHECK_RETURN(ret, "virtConvertRGBToGrayscale(vc_, rgb, gray)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmGetBaseFrame(float *base) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryConvertRGBToGrayscale(float *rgb, float *gray) {
+	return _result(VPP_PROFILE_CALL(convertRGBToGrayscale, Backend::virtConvertRGBToGrayscale(vc_, rgb, gray)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmGetBaseFrame(float *base) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmGetBaseFrame(vc_, base));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmGetBaseFrame, Backend::virtVmGetBaseFrame(vc_, base));
+			VPP_CHECK_RETURN(ret, "virtVmGetBaseFrame(vc_, base)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmGetBaseFrame(float *base) {
+	return _result(VPP_PROFILE_CALL(vmGetBaseFrame, Backend::virtVmGetBaseFrame(vc_, base)));
 }
 
-inline int Virtuose::waitPressButton(int button_number) {
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::vmGetBaseFrame() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, vmGetBaseFrame(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryVmGetBaseFrame() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryVmGetBaseFrame(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::waitPressButton(int button_number) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtWaitPressButton(vc_, button_number));
-			return ret;
+			int ret = VPP_PROFILE_CALL(waitPressButton, Backend::virtWaitPressButton(vc_, button_number));
+			VPP_CHECK_RETURN(ret, "virtWaitPressButton(vc_, button_number)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryWaitPressButton(int button_number) {
+	return _result(VPP_PROFILE_CALL(waitPressButton, Backend::virtWaitPressButton(vc_, button_number)));
 }
 
-inline int Virtuose::getTimeStep(float *step) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getTimeStep(float *step) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetTimeStep(vc_, step));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getTimeStep, Backend::virtGetTimeStep(vc_, step));
+			VPP_CHECK_RETURN(ret, "virtGetTimeStep(vc_, step)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmSetRobotMode(int OnOff) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetTimeStep(float *step) {
+	return _result(VPP_PROFILE_CALL(getTimeStep, Backend::virtGetTimeStep(vc_, step)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSetRobotMode(int OnOff) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSetRobotMode(vc_, OnOff));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSetRobotMode, Backend::virtVmSetRobotMode(vc_, OnOff));
+			VPP_CHECK_RETURN(ret, "virtVmSetRobotMode(vc_, OnOff)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSetRobotMode(int OnOff) {
+	return _result(VPP_PROFILE_CALL(vmSetRobotMode, Backend::virtVmSetRobotMode(vc_, OnOff)));
 }
 
-inline int Virtuose::vmSaveCurrentSpline(char *file_name) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmSaveCurrentSpline(char *file_name) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmSaveCurrentSpline(vc_, file_name));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmSaveCurrentSpline, Backend::virtVmSaveCurrentSpline(vc_, file_name));
+			VPP_CHECK_RETURN(ret, "virtVmSaveCurrentSpline(vc_, file_name)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmLoadSpline(char *file_name) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmSaveCurrentSpline(char *file_name) {
+	return _result(VPP_PROFILE_CALL(vmSaveCurrentSpline, Backend::virtVmSaveCurrentSpline(vc_, file_name)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmLoadSpline(char *file_name) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmLoadSpline(vc_, file_name));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmLoadSpline, Backend::virtVmLoadSpline(vc_, file_name));
+			VPP_CHECK_RETURN(ret, "virtVmLoadSpline(vc_, file_name)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmLoadSpline(char *file_name) {
+	return _result(VPP_PROFILE_CALL(vmLoadSpline, Backend::virtVmLoadSpline(vc_, file_name)));
 }
 
-inline int Virtuose::vmDeleteSpline(char *file_name) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmDeleteSpline(char *file_name) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmDeleteSpline(vc_, file_name));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmDeleteSpline, Backend::virtVmDeleteSpline(vc_, file_name));
+			VPP_CHECK_RETURN(ret, "virtVmDeleteSpline(vc_, file_name)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::vmWaitUpperBound() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmDeleteSpline(char *file_name) {
+	return _result(VPP_PROFILE_CALL(vmDeleteSpline, Backend::virtVmDeleteSpline(vc_, file_name)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::vmWaitUpperBound() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtVmWaitUpperBound(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(vmWaitUpperBound, Backend::virtVmWaitUpperBound(vc_));
+			VPP_CHECK_RETURN(ret, "virtVmWaitUpperBound(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryVmWaitUpperBound() {
+	return _result(VPP_PROFILE_CALL(vmWaitUpperBound, Backend::virtVmWaitUpperBound(vc_)));
 }
 
-inline int Virtuose::disableControlConnexion(int disable) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::disableControlConnexion(int disable) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtDisableControlConnexion(vc_, disable));
-			return ret;
+			int ret = VPP_PROFILE_CALL(disableControlConnexion, Backend::virtDisableControlConnexion(vc_, disable));
+			VPP_CHECK_RETURN(ret, "virtDisableControlConnexion(vc_, disable)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::isInBounds(unsigned int *bounds) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryDisableControlConnexion(int disable) {
+	return _result(VPP_PROFILE_CALL(disableControlConnexion, Backend::virtDisableControlConnexion(vc_, disable)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::isInBounds(unsigned int *bounds) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtIsInBounds(vc_, bounds));
-			return ret;
+			int ret = VPP_PROFILE_CALL(isInBounds, Backend::virtIsInBounds(vc_, bounds));
+			VPP_CHECK_RETURN(ret, "virtIsInBounds(vc_, bounds)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryIsInBounds(unsigned int *bounds) {
+	return _result(VPP_PROFILE_CALL(isInBounds, Backend::virtIsInBounds(vc_, bounds)));
 }
 
-inline int Virtuose::getAlarm(unsigned int *alarm) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getAlarm(unsigned int *alarm) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetAlarm(vc_, alarm));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getAlarm, Backend::virtGetAlarm(vc_, alarm));
+			VPP_CHECK_RETURN(ret, "virtGetAlarm(vc_, alarm)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getCatchFrame(float *frame) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetAlarm(unsigned int *alarm) {
+	return _result(VPP_PROFILE_CALL(getAlarm, Backend::virtGetAlarm(vc_, alarm)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getCatchFrame(float *frame) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetCatchFrame(vc_, frame));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getCatchFrame, Backend::virtGetCatchFrame(vc_, frame));
+			VPP_CHECK_RETURN(ret, "virtGetCatchFrame(vc_, frame)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetCatchFrame(float *frame) {
+	return _result(VPP_PROFILE_CALL(getCatchFrame, Backend::virtGetCatchFrame(vc_, frame)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseDisplacement>::type BasicVirtuoseMethods<Backend>::getCatchFrame() {
+	VirtuoseValue<VirtuoseDisplacement>::type ret;
+	_setStatus(ret, getCatchFrame(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseDisplacement> BasicVirtuoseMethods<Backend>::tryGetCatchFrame() {
+	VirtuoseExpected<VirtuoseDisplacement> ret;
+	_setStatus(ret, tryGetCatchFrame(ret.data));
+	return ret;
 }
 
-inline int Virtuose::setCatchFrame(float *frame) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setCatchFrame(float *frame) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetCatchFrame(vc_, frame));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setCatchFrame, Backend::virtSetCatchFrame(vc_, frame));
+			VPP_CHECK_RETURN(ret, "virtSetCatchFrame(vc_, frame)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetCatchFrame(float *frame) {
+	return _result(VPP_PROFILE_CALL(setCatchFrame, Backend::virtSetCatchFrame(vc_, frame)));
 }
 
-inline int Virtuose::activeSpeedControl(float radius, float speedFactor) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::activeSpeedControl(float radius, float speedFactor) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtActiveSpeedControl(vc_, radius, speedFactor));
-			return ret;
+			int ret = VPP_PROFILE_CALL(activeSpeedControl, Backend::virtActiveSpeedControl(vc_, radius, speedFactor));
+			VPP_CHECK_RETURN(ret, "virtActiveSpeedControl(vc_, radius, speedFactor)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::deactiveSpeedControl() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryActiveSpeedControl(float radius, float speedFactor) {
+	return _result(VPP_PROFILE_CALL(activeSpeedControl, Backend::virtActiveSpeedControl(vc_, radius, speedFactor)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::deactiveSpeedControl() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtDeactiveSpeedControl(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(deactiveSpeedControl, Backend::virtDeactiveSpeedControl(vc_));
+			VPP_CHECK_RETURN(ret, "virtDeactiveSpeedControl(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryDeactiveSpeedControl() {
+	return _result(VPP_PROFILE_CALL(deactiveSpeedControl, Backend::virtDeactiveSpeedControl(vc_)));
 }
 
-inline int Virtuose::isInShiftPosition(int *shift) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::isInShiftPosition(int *shift) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtIsInShiftPosition(vc_, shift));
-			return ret;
+			int ret = VPP_PROFILE_CALL(isInShiftPosition, Backend::virtIsInShiftPosition(vc_, shift));
+			VPP_CHECK_RETURN(ret, "virtIsInShiftPosition(vc_, shift)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setFrictionForce(float fx, float fy, float fz) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryIsInShiftPosition(int *shift) {
+	return _result(VPP_PROFILE_CALL(isInShiftPosition, Backend::virtIsInShiftPosition(vc_, shift)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setFrictionForce(float fx, float fy, float fz) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetFrictionForce(vc_, fx, fy, fz));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setFrictionForce, Backend::virtSetFrictionForce(vc_, fx, fy, fz));
+			VPP_CHECK_RETURN(ret, "virtSetFrictionForce(vc_, fx, fy, fz)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetFrictionForce(float fx, float fy, float fz) {
+	return _result(VPP_PROFILE_CALL(setFrictionForce, Backend::virtSetFrictionForce(vc_, fx, fy, fz)));
 }
 
-inline int Virtuose::getMouseState(int *active, int *left_click, int *right_click) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getMouseState(int *active, int *left_click, int *right_click) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetMouseState(vc_, active, left_click, right_click));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getMouseState, Backend::virtGetMouseState(vc_, active, left_click, right_click));
+			VPP_CHECK_RETURN(ret, "virtGetMouseState(vc_, active, left_click, right_click)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::generateDebugFile() {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetMouseState(int *active, int *left_click, int *right_click) {
+	return _result(VPP_PROFILE_CALL(getMouseState, Backend::virtGetMouseState(vc_, active, left_click, right_click)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::generateDebugFile() {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGenerateDebugFile(vc_));
-			return ret;
+			int ret = VPP_PROFILE_CALL(generateDebugFile, Backend::virtGenerateDebugFile(vc_));
+			VPP_CHECK_RETURN(ret, "virtGenerateDebugFile(vc_)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGenerateDebugFile() {
+	return _result(VPP_PROFILE_CALL(generateDebugFile, Backend::virtGenerateDebugFile(vc_)));
 }
 
-inline int Virtuose::getCenterSphere(float *pos) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getCenterSphere(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetCenterSphere(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getCenterSphere, Backend::virtGetCenterSphere(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtGetCenterSphere(vc_, pos)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getAxisOfRotation(float *axis) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetCenterSphere(float *pos) {
+	return _result(VPP_PROFILE_CALL(getCenterSphere, Backend::virtGetCenterSphere(vc_, pos)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getAxisOfRotation(float *axis) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetAxisOfRotation(vc_, axis));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getAxisOfRotation, Backend::virtGetAxisOfRotation(vc_, axis));
+			VPP_CHECK_RETURN(ret, "virtGetAxisOfRotation(vc_, axis)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetAxisOfRotation(float *axis) {
+	return _result(VPP_PROFILE_CALL(getAxisOfRotation, Backend::virtGetAxisOfRotation(vc_, axis)));
 }
 
-inline int Virtuose::getADC(int line, float *adc) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getADC(int line, float *adc) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetADC(vc_, line, adc));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getADC, Backend::virtGetADC(vc_, line, adc));
+			VPP_CHECK_RETURN(ret, "virtGetADC(vc_, line, adc)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::convertDisplacementToTransformMatrix(float *d, float *m) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetADC(int line, float *adc) {
+	return _result(VPP_PROFILE_CALL(getADC, Backend::virtGetADC(vc_, line, adc)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::convertDisplacementToTransformMatrix(float *d, float *m) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtConvertDeplToHomogeneMatrix(vc_, d, m));
-			return ret;
+			int ret = VPP_PROFILE_CALL(convertDisplacementToTransformMatrix, Backend::virtConvertDeplToHomogeneMatrix(vc_, d, m));
+			VPP_CHECK_RETURN(ret, "virtConvertDeplToHomogeneMatrix(vc_, d, m)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryConvertDisplacementToTransformMatrix(float *d, float *m) {
+	return _result(VPP_PROFILE_CALL(convertDisplacementToTransformMatrix, Backend::virtConvertDeplToHomogeneMatrix(vc_, d, m)));
 }
 
-inline int Virtuose::convertTransformMatrixToDisplacement(float *d, float *m) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::convertTransformMatrixToDisplacement(float *d, float *m) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtConvertHomogeneMatrixToDepl(vc_, d, m));
-			return ret;
+			int ret = VPP_PROFILE_CALL(convertTransformMatrixToDisplacement, Backend::virtConvertHomogeneMatrixToDepl(vc_, d, m));
+			VPP_CHECK_RETURN(ret, "virtConvertHomogeneMatrixToDepl(vc_, d, m)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::getTrackball(int *x_move, int *y_move) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryConvertTransformMatrixToDisplacement(float *d, float *m) {
+	return _result(VPP_PROFILE_CALL(convertTransformMatrixToDisplacement, Backend::virtConvertHomogeneMatrixToDepl(vc_, d, m)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getTrackball(int *x_move, int *y_move) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetTrackball(vc_, x_move, y_move));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getTrackball, Backend::virtGetTrackball(vc_, x_move, y_move));
+			VPP_CHECK_RETURN(ret, "virtGetTrackball(vc_, x_move, y_move)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetTrackball(int *x_move, int *y_move) {
+	return _result(VPP_PROFILE_CALL(getTrackball, Backend::virtGetTrackball(vc_, x_move, y_move)));
 }
 
-inline int Virtuose::getTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetTrackballButton(vc_, active, left_btn, middle_btn, right_btn));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getTrackballButton, Backend::virtGetTrackballButton(vc_, active, left_btn, middle_btn, right_btn));
+			VPP_CHECK_RETURN(ret, "virtGetTrackballButton(vc_, active, left_btn, middle_btn, right_btn)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::setAbsolutePosition(float *pos) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetTrackballButton(int *active, int *left_btn, int *middle_btn, int *right_btn) {
+	return _result(VPP_PROFILE_CALL(getTrackballButton, Backend::virtGetTrackballButton(vc_, active, left_btn, middle_btn, right_btn)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::setAbsolutePosition(float *pos) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtSetAbsolutePosition(vc_, pos));
-			return ret;
+			int ret = VPP_PROFILE_CALL(setAbsolutePosition, Backend::virtSetAbsolutePosition(vc_, pos));
+			VPP_CHECK_RETURN(ret, "virtSetAbsolutePosition(vc_, pos)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::trySetAbsolutePosition(float *pos) {
+	return _result(VPP_PROFILE_CALL(setAbsolutePosition, Backend::virtSetAbsolutePosition(vc_, pos)));
 }
 
-inline int Virtuose::beepOnLimit(int enable) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::beepOnLimit(int enable) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtBeepOnLimit(vc_, enable));
-			return ret;
+			int ret = VPP_PROFILE_CALL(beepOnLimit, Backend::virtBeepOnLimit(vc_, enable));
+			VPP_CHECK_RETURN(ret, "virtBeepOnLimit(vc_, enable)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::enableForceFeedback(int enable) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryBeepOnLimit(int enable) {
+	return _result(VPP_PROFILE_CALL(beepOnLimit, Backend::virtBeepOnLimit(vc_, enable)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::enableForceFeedback(int enable) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtEnableForceFeedback(vc_, enable));
-			return ret;
+			int ret = VPP_PROFILE_CALL(enableForceFeedback, Backend::virtEnableForceFeedback(vc_, enable));
+			VPP_CHECK_RETURN(ret, "virtEnableForceFeedback(vc_, enable)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryEnableForceFeedback(int enable) {
+	return _result(VPP_PROFILE_CALL(enableForceFeedback, Backend::virtEnableForceFeedback(vc_, enable)));
 }
 
-inline int Virtuose::getPhysicalSpeed(float *speed) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::getPhysicalSpeed(float *speed) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtGetPhysicalSpeed(vc_, speed));
-			return ret;
+			int ret = VPP_PROFILE_CALL(getPhysicalSpeed, Backend::virtGetPhysicalSpeed(vc_, speed));
+			VPP_CHECK_RETURN(ret, "virtGetPhysicalSpeed(vc_, speed)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryGetPhysicalSpeed(float *speed) {
+	return _result(VPP_PROFILE_CALL(getPhysicalSpeed, Backend::virtGetPhysicalSpeed(vc_, speed)));
+}
+
+template<typename Backend>
+inline VirtuoseValue<VirtuoseTwist>::type BasicVirtuoseMethods<Backend>::getPhysicalSpeed() {
+	VirtuoseValue<VirtuoseTwist>::type ret;
+	_setStatus(ret, getPhysicalSpeed(ret.data));
+	return ret;
+}
+
+template<typename Backend>
+inline VirtuoseExpected<VirtuoseTwist> BasicVirtuoseMethods<Backend>::tryGetPhysicalSpeed() {
+	VirtuoseExpected<VirtuoseTwist> ret;
+	_setStatus(ret, tryGetPhysicalSpeed(ret.data));
+	return ret;
 }
 
-inline int Virtuose::forceShiftButton(int forceShiftButton) {
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::forceShiftButton(int forceShiftButton) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtForceShiftButton(vc_, forceShiftButton));
-			return ret;
+			int ret = VPP_PROFILE_CALL(forceShiftButton, Backend::virtForceShiftButton(vc_, forceShiftButton));
+			VPP_CHECK_RETURN(ret, "virtForceShiftButton(vc_, forceShiftButton)");
+			return VPP_STATUS(ret);
 }
 
-inline int Virtuose::addForce(float *force) {
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryForceShiftButton(int forceShiftButton) {
+	return _result(VPP_PROFILE_CALL(forceShiftButton, Backend::virtForceShiftButton(vc_, forceShiftButton)));
+}
+
+template<typename Backend>
+inline VirtuoseStatus BasicVirtuoseMethods<Backend>::addForce(float *force) {
 	
-			int ret;
-			VPP_CHECKED_CALL(ret = virtAddForce(vc_, force));
-			return ret;
+			int ret = VPP_PROFILE_CALL(addForce, Backend::virtAddForce(vc_, force));
+			VPP_CHECK_RETURN(ret, "virtAddForce(vc_, force)");
+			return VPP_STATUS(ret);
+}
+
+template<typename Backend>
+inline VirtuoseResult BasicVirtuoseMethods<Backend>::tryAddForce(float *force) {
+	return _result(VPP_PROFILE_CALL(addForce, Backend::virtAddForce(vc_, force)));
 }
 
 #undef VPP_VERBOSE_MESSAGE
 #undef VPP_CHECKED_CALL
+#undef VPP_CHECK_RETURN
+#undef VPP_STATUS
+#undef VPP_PROFILE_CALL
+#undef VPP_PROFILE_RDTSC
+#undef VPP_THREAD_LOCAL
+#undef VPP_THROWING_ERROR_CHECK
+#undef VPP_UNLIKELY
+#undef VPP_COLD
+#undef VPP_NORETURN
+#undef VPP_ALIGNED
+#undef VPP_WEAK
 
 #endif // INCLUDED_vpp_h_GUID_0d0a89d6_fd37_447c_aa27_ebc289ddb935
 
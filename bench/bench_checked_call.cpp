@@ -0,0 +1,57 @@
+/**
+	@file
+	@brief Measures the per-call overhead of the checked wrapper methods
+	against calling the raw VirtuoseAPI functions, using a stub
+	virtCallDLL (see stub_virtcalldll.cpp).
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+
+static const long defaultIterations = 20000000;
+
+static void report(const char * name, double raw, double wrapped) {
+	std::printf("%-14s raw %7.2f ns/call   wrapped %7.2f ns/call   overhead %+6.2f ns\n",
+	            name, raw, wrapped, wrapped - raw);
+}
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	Virtuose vpp("bench");
+	VirtContext vc = vpp.getVirtContext();
+	float pos[7];
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+
+	std::printf("%ld iterations per measurement\n", iterations);
+
+	double raw = nanosecondsPerCall(iterations, [&] { virtGetPosition(vc, pos); });
+	double wrapped = nanosecondsPerCall(iterations, [&] { vpp.getPosition(pos); });
+	report("getPosition", raw, wrapped);
+
+	// By-value overload: should cost the same as filling a local array.
+	volatile float sink;
+	raw = nanosecondsPerCall(iterations, [&] { float p[7]; virtGetPosition(vc, p); sink = p[0]; });
+	wrapped = nanosecondsPerCall(iterations, [&] { VirtuoseDisplacement p = vpp.getPosition(); sink = p[0]; });
+	report("getPosition()", raw, wrapped);
+
+	raw = nanosecondsPerCall(iterations, [&] { virtSetForce(vc, force); });
+	wrapped = nanosecondsPerCall(iterations, [&] { vpp.setForce(force); });
+	report("setForce", raw, wrapped);
+
+	raw = nanosecondsPerCall(iterations, [&] { virtSetTimeStep(vc, 0.001f); });
+	wrapped = nanosecondsPerCall(iterations, [&] { vpp.setTimeStep(0.001f); });
+	report("setTimeStep", raw, wrapped);
+	return 0;
+}
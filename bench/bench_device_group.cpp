@@ -0,0 +1,267 @@
+/**
+	@file
+	@brief Runs several mock devices at 1 kHz while another thread takes
+	combined snapshots of their states as fast as it can, first with
+	VirtuoseGroup, then with the states copied into one mutex-protected
+	array by every servo tick. Reports the servo ticks' duration from
+	reading the state (publishing it and a spring force), the cost of a
+	snapshot, and the skew between the devices' samples in a snapshot:
+	for VirtuoseGroup, both as aligned by snapshot() and between the
+	devices' latest samples.
+
+	Each device's loop is pinned to a CPU (device i to CPU i modulo the
+	CPU count) and, if a priority is given, asked for SCHED_FIFO.
+
+	Usage: bench_device_group [devices [seconds [priority]]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-device-group.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	const float period = 0.001f;
+
+	int64_t nowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	double percentile(std::vector<double> & values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[static_cast<std::size_t>(p / 100.0 * (values.size() - 1) + 0.5)];
+	}
+
+	/// @brief Servo work shared by both variants: a spring to the origin.
+	void spring(Virtuose & vpp, VirtuoseState const& state) {
+		float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+		for (int k = 0; k < 3; ++k) {
+			force[k] = -50.f * state.position[k];
+		}
+		vpp.setForce(force);
+	}
+
+	/// @brief Per-device tick durations, written by that device's loop only.
+	struct TickTimes {
+		std::vector<double> us;
+		char pad[64];
+	};
+
+	struct GroupServo {
+		std::vector<TickTimes> * times;
+
+		void operator()(std::size_t device, Virtuose & vpp, VirtuoseGroupSample const& sample) {
+			spring(vpp, sample.state);
+			(*times)[device].us.push_back((nowNs() - sample.timeNs) / 1000.0);
+		}
+	};
+
+	/// @brief The usual alternative: one array of states behind a mutex.
+	struct LockedStates {
+		std::mutex mutex;
+		VirtuoseGroupSample devices[VPP_GROUP_MAX_DEVICES];
+		bool ready[VPP_GROUP_MAX_DEVICES];
+	};
+
+	struct LockedServo {
+		LockedStates * shared;
+		std::vector<TickTimes> * times;
+		std::size_t device;
+		VirtuoseThreadOptions options;
+		bool configured;
+		uint64_t tick;
+
+		void operator()(Virtuose & vpp) {
+			if (!configured) {
+				configured = true;
+				applyVirtuoseThreadOptions(options);
+			}
+			VirtuoseGroupSample sample;
+			vpp.readState(sample.state);
+			sample.tick = tick++;
+			sample.timeNs = nowNs();
+			{
+				std::lock_guard<std::mutex> lock(shared->mutex);
+				shared->devices[device] = sample;
+				shared->ready[device] = true;
+			}
+			spring(vpp, sample.state);
+			(*times)[device].us.push_back((nowNs() - sample.timeNs) / 1000.0);
+		}
+	};
+
+	struct ReaderResult {
+		double nsPerSnapshot;
+		std::vector<double> alignedSkewUs;
+		std::vector<double> latestSkewUs;
+	};
+
+	/// @brief Spread of the sample times of @a samples, in ns.
+	int64_t skewNs(const VirtuoseGroupSample * samples, std::size_t count) {
+		int64_t earliest = samples[0].timeNs, latest = samples[0].timeNs;
+		for (std::size_t i = 1; i < count; ++i) {
+			earliest = std::min(earliest, samples[i].timeNs);
+			latest = std::max(latest, samples[i].timeNs);
+		}
+		return latest - earliest;
+	}
+
+	/** @brief Calls @a takeSnapshot until @a stop. Every 1000th snapshot,
+		calls @a measureSkew(aligned, latest) to sample the skew of the
+		snapshot (-1 if not aligned) and between the latest samples.
+	*/
+	template<typename F, typename G>
+	void readSnapshots(std::atomic<bool> const& stop, ReaderResult & result, F takeSnapshot, G measureSkew) {
+		long count = 0;
+		Clock::time_point start = Clock::now();
+		while (!stop.load(std::memory_order_relaxed)) {
+			if (takeSnapshot()) {
+				if (count % 1000 == 0) {
+					int64_t aligned, latest;
+					measureSkew(aligned, latest);
+					if (aligned >= 0) {
+						result.alignedSkewUs.push_back(aligned / 1000.0);
+					}
+					result.latestSkewUs.push_back(latest / 1000.0);
+				}
+				++count;
+			}
+		}
+		result.nsPerSnapshot = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (count ? count : 1);
+	}
+
+	void report(const char * what, std::vector<TickTimes> & times, ReaderResult & reader) {
+		std::vector<double> all;
+		for (std::size_t i = 0; i < times.size(); ++i) {
+			all.insert(all.end(), times[i].us.begin(), times[i].us.end());
+		}
+		std::printf("%-22s ticks %6zu   tick p50 %6.2f us p99 %6.2f us max %7.1f us   snapshot %6.1f ns\n",
+		            what, all.size(), percentile(all, 50), percentile(all, 99), percentile(all, 100), reader.nsPerSnapshot);
+		if (!reader.alignedSkewUs.empty()) {
+			std::printf("%-22s skew aligned p50 %6.1f us max %7.1f us, of the latest samples p50 %6.1f us max %7.1f us\n", "",
+			            percentile(reader.alignedSkewUs, 50), percentile(reader.alignedSkewUs, 100),
+			            percentile(reader.latestSkewUs, 50), percentile(reader.latestSkewUs, 100));
+		} else {
+			std::printf("%-22s skew of the latest samples p50 %6.1f us max %7.1f us\n", "",
+			            percentile(reader.latestSkewUs, 50), percentile(reader.latestSkewUs, 100));
+		}
+	}
+
+	VirtuoseThreadOptions optionsFor(std::size_t device, int priority) {
+		unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+		return VirtuoseThreadOptions(static_cast<int>(device % cpus), priority);
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	std::size_t devices = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 4;
+	double seconds = (argc > 2) ? std::atof(argv[2]) : 2.0;
+	int priority = (argc > 3) ? std::atoi(argv[3]) : 0;
+	devices = std::min<std::size_t>(std::max<std::size_t>(devices, 1), VPP_GROUP_MAX_DEVICES);
+	std::chrono::duration<double> runTime(seconds);
+
+	{
+		VirtuoseGroup group;
+		for (std::size_t i = 0; i < devices; ++i) {
+			group.add("bench", optionsFor(i, priority));
+		}
+		std::vector<TickTimes> times(devices);
+		for (std::size_t i = 0; i < devices; ++i) {
+			times[i].us.reserve(static_cast<std::size_t>(seconds / period * 2));
+		}
+		GroupServo servo = {&times};
+		ReaderResult reader;
+		std::atomic<bool> stop(false);
+		group.start(servo, period);
+		std::thread readerThread([&] {
+			VirtuoseGroupSnapshot snapshot;
+			readSnapshots(stop, reader, [&] {
+				return group.snapshot(snapshot);
+			}, [&](int64_t & aligned, int64_t & latest) {
+				aligned = snapshot.skewNs();
+				VirtuoseGroupSample samples[VPP_GROUP_MAX_DEVICES];
+				for (std::size_t i = 0; i < devices; ++i) {
+					group.latest(i, samples[i]);
+				}
+				latest = skewNs(samples, devices);
+			});
+		});
+		std::this_thread::sleep_for(runTime);
+		group.stop();
+		stop = true;
+		readerThread.join();
+		for (std::size_t i = 0; i < devices; ++i) {
+			VirtuoseThreadStatus status = group.threadStatus(i);
+			std::printf("device %zu: CPU %d %s, SCHED_FIFO %s\n", i, optionsFor(i, priority).cpu,
+			            status.affinityError ? std::strerror(status.affinityError) : "pinned",
+			            priority == 0 ? "not requested" : (status.priorityError ? std::strerror(status.priorityError) : "set"));
+		}
+		report("VirtuoseGroup", times, reader);
+	}
+
+	{
+		std::vector<std::unique_ptr<Virtuose> > vpps;
+		std::vector<LockedServo> servos(devices);
+		std::vector<TickTimes> times(devices);
+		LockedStates shared;
+		for (std::size_t i = 0; i < devices; ++i) {
+			shared.ready[i] = false;
+			times[i].us.reserve(static_cast<std::size_t>(seconds / period * 2));
+			LockedServo s = {&shared, &times, i, optionsFor(i, priority), false, 0};
+			servos[i] = s;
+			vpps.push_back(std::unique_ptr<Virtuose>(new Virtuose("bench")));
+		}
+		ReaderResult reader;
+		std::atomic<bool> stop(false);
+		float p = period;
+		for (std::size_t i = 0; i < devices; ++i) {
+			vpps[i]->setPeriodicFunction(servos[i], &p);
+			vpps[i]->startLoop();
+		}
+		std::thread readerThread([&] {
+			VirtuoseGroupSample copy[VPP_GROUP_MAX_DEVICES];
+			readSnapshots(stop, reader, [&] {
+				std::lock_guard<std::mutex> lock(shared.mutex);
+				for (std::size_t i = 0; i < devices; ++i) {
+					if (!shared.ready[i]) {
+						return false;
+					}
+					copy[i] = shared.devices[i];
+				}
+				return true;
+			}, [&](int64_t & aligned, int64_t & latest) {
+				aligned = -1;
+				latest = skewNs(copy, devices);
+			});
+		});
+		std::this_thread::sleep_for(runTime);
+		for (std::size_t i = 0; i < devices; ++i) {
+			vpps[i]->stopLoop();
+		}
+		stop = true;
+		readerThread.join();
+		report("one mutex, all states", times, reader);
+	}
+	return 0;
+}
@@ -0,0 +1,88 @@
+/**
+	@file
+	@brief Compares the hot calls made through the variadic virtCallDLL
+	(the VirtuoseAPI's own inline functions) with the same calls made by
+	vpp.h built with VPP_DIRECT_DISPATCH, which uses the mock backend's
+	direct entry points.
+
+	Usage: bench_direct_dispatch [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#define VPP_DIRECT_DISPATCH
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+#include <virtuoseAPI-mock.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+
+static const long defaultIterations = 2000000;
+
+static void report(const char * what, double variadic, double direct) {
+	std::printf("%-14s virtCallDLL %8.2f ns   direct %8.2f ns   saving %+7.2f ns\n",
+	            what, variadic, direct, variadic - direct);
+}
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	Virtuose vpp("bench");
+	VirtContext vc = vpp.getVirtContext();
+	if (!virtGetEntryPoint(GETPOSITION)) {
+		std::printf("backend has no direct entry points\n");
+		return 1;
+	}
+
+	float pos[7];
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+	VirtuoseState state;
+	volatile float sink;
+
+	double variadic = nanosecondsPerCall(iterations, [&] {
+		virtGetPosition(vc, pos);
+		sink = pos[0];
+	});
+	double direct = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(pos);
+		sink = pos[0];
+	});
+	report("getPosition", variadic, direct);
+
+	variadic = nanosecondsPerCall(iterations, [&] {
+		virtSetForce(vc, force);
+	});
+	direct = nanosecondsPerCall(iterations, [&] {
+		vpp.setForce(force);
+	});
+	report("setForce", variadic, direct);
+
+	variadic = nanosecondsPerCall(iterations, [&] {
+		virtGetPosition(vc, state.position.data);
+		virtGetSpeed(vc, state.speed.data);
+		for (int i = 0; i < VPP_STATE_BUTTON_COUNT; ++i) {
+			int pressed;
+			virtGetButton(vc, i, &pressed);
+		}
+		virtGetDeadMan(vc, &state.deadMan);
+		virtGetEmergencyStop(vc, &state.emergencyStop);
+		virtGetPowerOn(vc, &state.powerOn);
+		virtGetTimeLastUpdate(vc, &state.timeLastUpdate);
+		sink = state.position[0];
+	});
+	direct = nanosecondsPerCall(iterations, [&] {
+		vpp.readState(state);
+		sink = state.position[0];
+	});
+	report("readState", variadic, direct);
+	(void) sink;
+	return 0;
+}
@@ -0,0 +1,90 @@
+/**
+	@file
+	@brief Measures the cost of a failed call, with errors injected on
+	every getPosition by the mock backend: caught VirtuoseAPIError with
+	and without reading what(), the eagerly-formatted exception the
+	wrapper used to throw, and tryGetPosition(), which doesn't throw.
+
+	Usage: bench_error_path [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+#include <virtuoseAPI-mock.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+static const long defaultIterations = 200000;
+
+namespace {
+	/// What the wrapper did before formatting became lazy, with the same
+	/// call depth and out-of-line throw as Virtuose::getPosition.
+	__attribute__((noinline, cold, noreturn)) void throwEager(VirtContext vc, const char * call,
+	        const char * file, int line, const char * func) {
+		std::ostringstream s;
+		s << "VirtuoseAPI Error (in call '" << call << "' in " << func << "@" << file << ":" << line << "): " << virtGetErrorMessage(virtGetErrorCode(vc));
+		throw std::runtime_error(s.str());
+	}
+
+	__attribute__((noinline)) int eagerGetPosition(VirtContext vc, float * pos) {
+		int ret = virtGetPosition(vc, pos);
+		if (ret != 0) {
+			throwEager(vc, "virtGetPosition(vc_, pos)", __FILE__, __LINE__, __FUNCTION__);
+		}
+		return ret;
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	Virtuose vpp("bench");
+	VirtContext vc = vpp.getVirtContext();
+	float pos[7];
+	volatile unsigned long sink = 0;
+
+	virtMockInjectError(GETPOSITION, 1, VIRT_E_COMMUNICATION_FAILURE);
+
+	double lazy = nanosecondsPerCall(iterations, [&] {
+		try {
+			vpp.getPosition(pos);
+		} catch (Virtuose::VirtuoseAPIError & e) {
+			sink += e.code();
+		}
+	});
+	double lazyWhat = nanosecondsPerCall(iterations, [&] {
+		try {
+			vpp.getPosition(pos);
+		} catch (Virtuose::VirtuoseAPIError & e) {
+			sink += e.what()[0];
+		}
+	});
+	double eager = nanosecondsPerCall(iterations, [&] {
+		try {
+			eagerGetPosition(vc, pos);
+		} catch (std::runtime_error & e) {
+			sink += e.what()[0];
+		}
+	});
+	double result = nanosecondsPerCall(iterations, [&] {
+		sink += vpp.tryGetPosition(pos).errorCode;
+	});
+
+	virtMockInjectError(GETPOSITION, 0, 0);
+
+	std::printf("failed getPosition: eager message %8.1f ns   lazy, what() unread %8.1f ns   lazy, what() read %8.1f ns   tryGetPosition %8.1f ns\n",
+	            eager, lazy, lazyWhat, result);
+	(void) sink;
+	return 0;
+}
@@ -0,0 +1,92 @@
+/**
+	@file
+	@brief Measures the per-tick cost of dispatching the periodic
+	function: a C callback constructing a borrowed Virtuose or a
+	VirtuoseRef from the VirtContext every tick, versus the templated
+	setPeriodicFunction() overloads that pass the registering object.
+
+	Runs against the stub backend, which invokes the registered function
+	synchronously (stubRunPeriodic), so only dispatch plus one getPosition
+	is timed.
+
+	Usage: bench_periodic_callback [ticks]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" void stubRunPeriodic(long ticks);
+
+namespace {
+	float sink;
+
+	void borrowedTick(VirtContext vc, void *) {
+		Virtuose vpp(vc);
+		float pos[7];
+		vpp.getPosition(pos);
+		sink = pos[0];
+	}
+
+	void refTick(VirtContext vc, void *) {
+		VirtuoseRef vpp(vc);
+		float pos[7];
+		vpp.getPosition(pos);
+		sink = pos[0];
+	}
+
+	void functionTick(Virtuose & vpp) {
+		float pos[7];
+		vpp.getPosition(pos);
+		sink = pos[0];
+	}
+
+	struct Servo {
+		void operator()(Virtuose & vpp) {
+			tick(vpp);
+		}
+		void tick(Virtuose & vpp) {
+			float pos[7];
+			vpp.getPosition(pos);
+			sink = pos[0];
+		}
+	};
+
+	void report(const char * name, double ns) {
+		std::printf("%-38s %7.2f ns/tick\n", name, ns);
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	long ticks = (argc > 1) ? std::atol(argv[1]) : 10000000;
+	Virtuose vpp("bench");
+	float period = 0.001f;
+	Servo servo;
+
+	vpp.setPeriodicFunction(&borrowedTick, &period, NULL);
+	report("C callback + borrowed Virtuose(vc)", nanosecondsPerCall(1, [&] { stubRunPeriodic(ticks); }) / ticks);
+
+	vpp.setPeriodicFunction(&refTick, &period, NULL);
+	report("C callback + VirtuoseRef(vc)", nanosecondsPerCall(1, [&] { stubRunPeriodic(ticks); }) / ticks);
+
+	vpp.setPeriodicFunction(&functionTick, &period);
+	report("function taking Virtuose &", nanosecondsPerCall(1, [&] { stubRunPeriodic(ticks); }) / ticks);
+
+	vpp.setPeriodicFunction(servo, &period);
+	report("callable object", nanosecondsPerCall(1, [&] { stubRunPeriodic(ticks); }) / ticks);
+
+	vpp.setPeriodicFunction<Servo, &Servo::tick>(servo, &period);
+	report("member function", nanosecondsPerCall(1, [&] { stubRunPeriodic(ticks); }) / ticks);
+	return 0;
+}
@@ -0,0 +1,129 @@
+/**
+	@file
+	@brief Latency/jitter benchmark for a servo loop driven through
+	Virtuose::setPeriodicFunction and startLoop, run against the mock
+	backend at 1, 2 and 4 kHz.
+
+	Each callback iteration does what a typical haptic loop does:
+	getPosition, compute a spring force, setForce. The time taken by that
+	iteration and the interval between successive callbacks are
+	recorded, and percentiles and deadline misses are reported per rate.
+
+	Usage: bench_periodic_loop [seconds-per-rate]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	struct LoopData {
+		double period; // seconds
+		std::vector<double> iteration; // seconds
+		std::vector<double> interval; // seconds
+		Clock::time_point lastStart;
+		bool started;
+	};
+
+	void servoTick(VirtContext vc, void * arg) {
+		LoopData & data = *static_cast<LoopData *>(arg);
+		Clock::time_point start = Clock::now();
+
+		Virtuose vpp(vc);
+		float pos[7];
+		vpp.getPosition(pos);
+		const float stiffness = 200.f;
+		float force[6] = { -stiffness * pos[0], -stiffness * pos[1], -stiffness * pos[2], 0.f, 0.f, 0.f};
+		vpp.setForce(force);
+
+		Clock::time_point end = Clock::now();
+		if (data.iteration.size() < data.iteration.capacity()) {
+			data.iteration.push_back(std::chrono::duration<double>(end - start).count());
+			if (data.started) {
+				data.interval.push_back(std::chrono::duration<double>(start - data.lastStart).count());
+			}
+		}
+		data.lastStart = start;
+		data.started = true;
+	}
+
+	double percentile(std::vector<double> const& sorted, double p) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		std::size_t idx = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+		return sorted[idx];
+	}
+
+	void runRate(int hz, double seconds) {
+		LoopData data;
+		data.period = 1.0 / hz;
+		data.started = false;
+		std::size_t expected = static_cast<std::size_t>(hz * seconds * 1.5) + 16;
+		data.iteration.reserve(expected);
+		data.interval.reserve(expected);
+
+		{
+			Virtuose vpp("bench");
+			float period = static_cast<float>(data.period);
+			vpp.setTimeStep(period);
+			vpp.setPeriodicFunction(servoTick, &period, &data);
+			vpp.startLoop();
+			std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+			vpp.stopLoop();
+		}
+
+		std::size_t overruns = 0;
+		for (std::size_t i = 0; i < data.iteration.size(); ++i) {
+			if (data.iteration[i] > data.period) {
+				++overruns;
+			}
+		}
+		std::size_t skipped = 0;
+		for (std::size_t i = 0; i < data.interval.size(); ++i) {
+			if (data.interval[i] > 1.5 * data.period) {
+				++skipped;
+			}
+		}
+
+		std::sort(data.iteration.begin(), data.iteration.end());
+		std::sort(data.interval.begin(), data.interval.end());
+		const double us = 1e6;
+		std::printf("%5d Hz %8lu ticks | iteration us: p50 %7.2f p99 %7.2f p99.9 %7.2f max %8.2f"
+		            " | interval us: p50 %8.2f p99.9 %8.2f max %8.2f | overruns %lu late %lu\n",
+		            hz, static_cast<unsigned long>(data.iteration.size()),
+		            percentile(data.iteration, 50) * us, percentile(data.iteration, 99) * us,
+		            percentile(data.iteration, 99.9) * us,
+		            data.iteration.empty() ? 0.0 : data.iteration.back() * us,
+		            percentile(data.interval, 50) * us, percentile(data.interval, 99.9) * us,
+		            data.interval.empty() ? 0.0 : data.interval.back() * us,
+		            static_cast<unsigned long>(overruns), static_cast<unsigned long>(skipped));
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 5.0;
+	std::printf("%.1f s per rate; 'overruns' = iterations longer than the period,"
+	            " 'late' = callbacks starting more than 1.5 periods after the previous one\n", seconds);
+	const int rates[] = {1000, 2000, 4000};
+	for (std::size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) {
+		runRate(rates[i], seconds);
+	}
+	return 0;
+}
@@ -0,0 +1,175 @@
+/**
+	@file
+	@brief Compares composing and inverting displacements one at a time
+	(vpp_pose::compose() and invert() on packed poses) with the batch
+	versions on DisplacementArrays, for a frame applied to many tool
+	poses, pairs of poses, and inverses. Also times converting packed
+	poses to and from DisplacementArrays around the batch composition.
+
+	Checks the batch results against the single-pose ones, the
+	single-pose ones against the product of the poses' matrices, and
+	compose(d, invert(d)) against the identity. Built twice by make
+	bench: for the default target (SSE2) and with -mavx.
+
+	Usage: bench_pose_compose [poses [iterations]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp-pose-math.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+	std::vector<float> makePoses(std::size_t n, unsigned seed) {
+		std::vector<float> d(n * 7);
+		std::mt19937 rng(seed);
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+		for (std::size_t i = 0; i < n; ++i) {
+			float * p = &d[i * 7];
+			float q[4] = {normal(rng), normal(rng), normal(rng), normal(rng)};
+			float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			for (int k = 0; k < 3; ++k) {
+				p[k] = uniform(rng);
+			}
+			for (int k = 0; k < 4; ++k) {
+				p[3 + k] = q[k] / norm;
+			}
+		}
+		return d;
+	}
+
+	/// @brief One array per component, sized for @a n poses.
+	struct ArrayStorage {
+		std::vector<float> storage;
+		vpp_pose::DisplacementArrays arrays;
+
+		explicit ArrayStorage(std::size_t n) : storage(n * 7) {
+			float * p = &storage[0];
+			vpp_pose::DisplacementArrays a = {p, p + n, p + 2 * n, p + 3 * n, p + 4 * n, p + 5 * n, p + 6 * n};
+			arrays = a;
+		}
+	};
+
+	float maxDifference(std::vector<float> const& a, std::vector<float> const& b) {
+		float ret = 0.f;
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			ret = std::max(ret, std::fabs(a[i] - b[i]));
+		}
+		return ret;
+	}
+
+	/// @brief Largest difference between the matrix of compose(a, b) and
+	/// the product of the matrices of a and b.
+	float maxMatrixProductDifference(std::vector<float> const& a, std::vector<float> const& b, std::vector<float> const& composed) {
+		float ret = 0.f;
+		for (std::size_t i = 0; i < composed.size() / 7; ++i) {
+			float ma[16], mb[16], mc[16];
+			vpp_pose::displacementToMatrix(&a[i * 7], ma);
+			vpp_pose::displacementToMatrix(&b[i * 7], mb);
+			vpp_pose::displacementToMatrix(&composed[i * 7], mc);
+			for (int r = 0; r < 4; ++r) {
+				for (int c = 0; c < 4; ++c) {
+					float product = 0.f;
+					for (int k = 0; k < 4; ++k) {
+						product += ma[r * 4 + k] * mb[k * 4 + c];
+					}
+					ret = std::max(ret, std::fabs(product - mc[r * 4 + c]));
+				}
+			}
+		}
+		return ret;
+	}
+
+	void report(const char * what, std::size_t n, double single, double batch, float batchError) {
+		std::printf("%-24s per pose: single %6.2f ns   batch (%s) %6.2f ns   max difference %.2g\n",
+		            what, single / n, vpp_pose::batchInstructionSet(), batch / n, batchError);
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	std::size_t n = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 4096;
+	long iterations = (argc > 2) ? std::atol(argv[2]) : 2000;
+
+	std::vector<float> frame = makePoses(1, 1);
+	std::vector<float> a = makePoses(n, 2);
+	std::vector<float> b = makePoses(n, 3);
+	std::vector<float> single(n * 7), batch(n * 7);
+	ArrayStorage aArrays(n), bArrays(n), outArrays(n);
+	vpp_pose::toArrays(&a[0], aArrays.arrays, n);
+	vpp_pose::toArrays(&b[0], bArrays.arrays, n);
+
+	// A frame applied to every pose, as for many tools' world poses.
+	double singleTime = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp_pose::compose(&frame[0], &a[i * 7], &single[i * 7]);
+		}
+	});
+	double batchTime = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::compose(&frame[0], aArrays.arrays, outArrays.arrays, n);
+	});
+	vpp_pose::fromArrays(outArrays.arrays, &batch[0], n);
+	report("frame * pose", n, singleTime, batchTime, maxDifference(single, batch));
+	std::vector<float> frames(n * 7);
+	for (std::size_t i = 0; i < n; ++i) {
+		std::copy(frame.begin(), frame.end(), frames.begin() + i * 7);
+	}
+	float productError = maxMatrixProductDifference(frames, a, single);
+
+	batchTime = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::toArrays(&a[0], aArrays.arrays, n);
+		vpp_pose::compose(&frame[0], aArrays.arrays, outArrays.arrays, n);
+		vpp_pose::fromArrays(outArrays.arrays, &batch[0], n);
+	});
+	report("frame * pose, packed", n, singleTime, batchTime, maxDifference(single, batch));
+
+	singleTime = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp_pose::compose(&a[i * 7], &b[i * 7], &single[i * 7]);
+		}
+	});
+	batchTime = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::compose(aArrays.arrays, bArrays.arrays, outArrays.arrays, n);
+	});
+	vpp_pose::fromArrays(outArrays.arrays, &batch[0], n);
+	report("pose * pose", n, singleTime, batchTime, maxDifference(single, batch));
+	productError = std::max(productError, maxMatrixProductDifference(a, b, single));
+
+	singleTime = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp_pose::invert(&a[i * 7], &single[i * 7]);
+		}
+	});
+	batchTime = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::invert(aArrays.arrays, outArrays.arrays, n);
+	});
+	vpp_pose::fromArrays(outArrays.arrays, &batch[0], n);
+	report("inverse", n, singleTime, batchTime, maxDifference(single, batch));
+
+	float identityError = 0.f;
+	for (std::size_t i = 0; i < n; ++i) {
+		float d[7];
+		vpp_pose::compose(&a[i * 7], &single[i * 7], d);
+		const float identity[7] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f};
+		for (int k = 0; k < 7; ++k) {
+			identityError = std::max(identityError, std::fabs(d[k] - identity[k]));
+		}
+	}
+	std::printf("max difference from the matrix product %.2g, of pose * inverse from the identity %.2g\n",
+	            productError, identityError);
+	return 0;
+}
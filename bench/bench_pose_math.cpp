@@ -0,0 +1,126 @@
+/**
+	@file
+	@brief Compares displacement/matrix conversion through the VirtuoseAPI
+	(convertDisplacementToTransformMatrix() and
+	convertTransformMatrixToDisplacement(), against the mock backend)
+	with vpp_pose's scalar and batch conversions, and reports the
+	largest difference from the mock's results.
+
+	The mock's conversions are a copy of vpp_pose's scalar ones, so the
+	scalar difference only shows the copy is intact, and the batch one
+	that the batch conversions match the scalar ones. Neither checks
+	vpp_pose's conventions (row-major matrix, translation in the last
+	column, qw last) against the vendor library.
+
+	The poses are random, plus half-turns about each axis, which take
+	each branch of the matrix to quaternion conversion. The default
+	count is large enough that the branch predictor can't learn which
+	branch each pose takes, as it would for a few hundred poses converted
+	over and over. Built twice by make bench: for the default target
+	(SSE2) and with -mavx.
+
+	Usage: bench_pose_math [poses [iterations]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp-pose-math.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+	std::vector<float> makePoses(std::size_t n) {
+		std::vector<float> d(n * 7);
+		std::mt19937 rng(12345);
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+		for (std::size_t i = 0; i < n; ++i) {
+			float * p = &d[i * 7];
+			float q[4] = {normal(rng), normal(rng), normal(rng), normal(rng)};
+			float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			for (int k = 0; k < 3; ++k) {
+				p[k] = uniform(rng);
+			}
+			for (int k = 0; k < 4; ++k) {
+				p[3 + k] = q[k] / norm;
+			}
+		}
+		// Half-turns about x, y and z: trace -1, largest diagonal element
+		// on each axis in turn.
+		for (std::size_t axis = 0; axis < 3 && axis < n; ++axis) {
+			float * p = &d[axis * 7];
+			for (int k = 3; k < 7; ++k) {
+				p[k] = 0.f;
+			}
+			p[3 + axis] = 1.f;
+		}
+		return d;
+	}
+
+	float maxDifference(std::vector<float> const& a, std::vector<float> const& b) {
+		float ret = 0.f;
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			ret = std::max(ret, std::fabs(a[i] - b[i]));
+		}
+		return ret;
+	}
+
+	void report(const char * what, std::size_t n, double api, double scalar, double batch, float scalarError, float batchError) {
+		std::printf("%-20s per pose: VirtuoseAPI (mock) %7.2f ns   scalar %6.2f ns   batch (%s) %6.2f ns"
+		            "   max difference from mock: scalar %.2g batch %.2g\n",
+		            what, api / n, scalar / n, vpp_pose::batchInstructionSet(), batch / n, scalarError, batchError);
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	std::size_t n = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 16384;
+	long iterations = (argc > 2) ? std::atol(argv[2]) : 200;
+	Virtuose vpp("bench");
+
+	std::vector<float> d = makePoses(n);
+	std::vector<float> apiM(n * 16), scalarM(n * 16), batchM(n * 16);
+	double api = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp.convertDisplacementToTransformMatrix(&d[i * 7], &apiM[i * 16]);
+		}
+	});
+	double scalar = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp_pose::displacementToMatrix(&d[i * 7], &scalarM[i * 16]);
+		}
+	});
+	double batch = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::displacementsToMatrices(&d[0], &batchM[0], n);
+	});
+	report("displacement->matrix", n, api, scalar, batch, maxDifference(apiM, scalarM), maxDifference(apiM, batchM));
+
+	std::vector<float> apiD(n * 7), scalarD(n * 7), batchD(n * 7);
+	api = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp.convertTransformMatrixToDisplacement(&apiD[i * 7], &apiM[i * 16]);
+		}
+	});
+	scalar = nanosecondsPerCall(iterations, [&] {
+		for (std::size_t i = 0; i < n; ++i) {
+			vpp_pose::matrixToDisplacement(&apiM[i * 16], &scalarD[i * 7]);
+		}
+	});
+	batch = nanosecondsPerCall(iterations, [&] {
+		vpp_pose::matricesToDisplacements(&apiM[0], &batchD[0], n);
+	});
+	report("matrix->displacement", n, api, scalar, batch, maxDifference(apiD, scalarD), maxDifference(apiD, batchD));
+	return 0;
+}
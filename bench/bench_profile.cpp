@@ -0,0 +1,74 @@
+/**
+	@file
+	@brief Times a few hot calls through a do-nothing virtCallDLL, to
+	measure what VPP_PROFILE adds to each call: built as bench_profile
+	with it and bench_profile_off without. With VPP_PROFILE, then makes
+	servo-like calls from three threads and prints vpp_profile::report().
+
+	Usage: bench_profile [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+static const long defaultIterations = 2000000;
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	Virtuose vpp("bench");
+	VirtuoseState state;
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+
+#ifdef VPP_PROFILE
+	const char * mode = "VPP_PROFILE";
+#else
+	const char * mode = "no profiling";
+#endif
+	double getPosition = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(state.position.data);
+	});
+	double setForce = nanosecondsPerCall(iterations, [&] {
+		vpp.setForce(force);
+	});
+	double readState = nanosecondsPerCall(iterations, [&] {
+		vpp.readState(state);
+	});
+	std::printf("%-14s getPosition %6.2f ns   setForce %6.2f ns   readState %6.2f ns\n", mode, getPosition, setForce, readState);
+
+#ifdef VPP_PROFILE
+	vpp_profile::reset();
+	auto servo = [&] {
+		VirtuoseRef ref(vpp);
+		VirtuoseState s;
+		for (long i = 0; i < iterations / 10; ++i) {
+			ref.readState(s);
+			ref.setForce(force);
+		}
+	};
+	std::thread first(servo), second(servo);
+	float step;
+	for (long i = 0; i < iterations / 10; ++i) {
+		vpp.getPosition(state.position.data);
+		vpp.getTimeStep(&step);
+	}
+	first.join();
+	second.join();
+	std::printf("\n");
+	vpp_profile::report(std::cout);
+#endif
+	return 0;
+}
@@ -0,0 +1,75 @@
+/**
+	@file
+	@brief Compares reading a servo tick's worth of device state with the
+	individual wrapped getters against one Virtuose::readState() call,
+	and the matching writes against Virtuose::writeCommand().
+
+	Usage: bench_read_state [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+
+static const long defaultIterations = 2000000;
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	Virtuose vpp("bench");
+	VirtuoseState state;
+	volatile unsigned int sink;
+
+	double individual = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(state.position.data);
+		vpp.getSpeed(state.speed.data);
+		state.buttons = 0;
+		for (int i = 0; i < VPP_STATE_BUTTON_COUNT; ++i) {
+			int pressed;
+			vpp.getButton(i, &pressed);
+			state.buttons |= (pressed ? 1u : 0u) << i;
+		}
+		vpp.getDeadMan(&state.deadMan);
+		vpp.getEmergencyStop(&state.emergencyStop);
+		vpp.getPowerOn(&state.powerOn);
+		vpp.getTimeLastUpdate(&state.timeLastUpdate);
+		sink = state.buttons;
+	});
+	double batched = nanosecondsPerCall(iterations, [&] {
+		vpp.readState(state);
+		sink = state.buttons;
+	});
+	std::printf("read tick state:    individual %8.2f ns   readState    %8.2f ns   saving %+7.2f ns\n",
+	            individual, batched, individual - batched);
+
+	VirtuoseCommand command;
+	command.fields = VirtuoseCommand::Position | VirtuoseCommand::Speed | VirtuoseCommand::Force;
+	for (int i = 0; i < 7; ++i) {
+		command.position[i] = (i == 6) ? 1.f : 0.f;
+	}
+	for (int i = 0; i < 6; ++i) {
+		command.speed[i] = command.force[i] = 0.f;
+	}
+	individual = nanosecondsPerCall(iterations, [&] {
+		vpp.setPosition(command.position.data);
+		vpp.setSpeed(command.speed.data);
+		vpp.setForce(command.force.data);
+	});
+	batched = nanosecondsPerCall(iterations, [&] {
+		vpp.writeCommand(command);
+	});
+	std::printf("write tick command: individual %8.2f ns   writeCommand %8.2f ns   saving %+7.2f ns\n",
+	            individual, batched, individual - batched);
+	(void) sink;
+	return 0;
+}
@@ -0,0 +1,148 @@
+/**
+	@file
+	@brief Replays a synthetic 4 kHz recording through VirtuoseReplay:
+	runs a servo function over it as fast as possible a few times,
+	checking that every run computes the same forces, reports the
+	replay's own cost per tick, and then plays it at the recorded rate
+	to check the pacing.
+
+	Usage: bench_replay [seconds-of-recording [file]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-replay-backend.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static const int rate = 4000;
+
+namespace {
+	/// Spring to the origin, damping, and a stiffer spring while button 0 is held.
+	struct Servo {
+		std::vector<Clock::time_point> starts;
+
+		void operator()(VirtuoseReplay & vpp) {
+			if (starts.size() < starts.capacity()) {
+				starts.push_back(Clock::now());
+			}
+			VirtuoseState state = vpp.readState();
+			float stiffness = state.button(0) ? 400.f : 200.f;
+			const float damping = 2.f;
+			VirtuoseWrench force;
+			for (int i = 0; i < 3; ++i) {
+				force[i] = -stiffness * state.position[i] - damping * state.speed[i];
+				force[i + 3] = -0.1f * state.speed[i + 3];
+			}
+			vpp.setForce(force.data);
+		}
+	};
+
+	struct Nothing {
+		void operator()(VirtuoseReplay &) {}
+	};
+
+	void synthesize(const char * path, uint64_t count) {
+		VirtuoseTrajectoryRecorder recorder(path, count, 1.f / rate);
+		VirtuoseTrajectorySample s = VirtuoseTrajectorySample();
+		for (uint64_t i = 0; i < count; ++i) {
+			double t = double(i) / rate;
+			s.tick = i;
+			s.time = t;
+			for (int k = 0; k < 3; ++k) {
+				s.position[k] = 0.1f * static_cast<float>(std::sin(t * (k + 1)));
+				s.speed[k] = 0.1f * (k + 1) * static_cast<float>(std::cos(t * (k + 1)));
+			}
+			s.position[6] = 1.f;
+			s.buttons = (i / 1000) % 2;
+			s.deadMan = 1;
+			s.powerOn = 1;
+			s.timeLastUpdate = static_cast<uint32_t>(i);
+			while (!recorder.tryRecord(s)) {
+			}
+		}
+	}
+
+	double percentile(std::vector<double> sorted, double p) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		std::sort(sorted.begin(), sorted.end());
+		std::size_t idx = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+		return sorted[idx];
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 2.0;
+	const char * path = (argc > 2) ? argv[2] : "/tmp/bench_replay.vtraj";
+	uint64_t count = static_cast<uint64_t>(seconds * rate);
+	synthesize(path, count);
+
+	VirtuoseReplay vpp(path);
+	VirtuoseReplaySession & replay = VirtuoseReplayBackend::session(vpp.getVirtContext());
+	replay.setPacing(VirtuoseReplaySession::AsFastAsPossible);
+	float period = 1.f / rate;
+	const double us = 1e6;
+
+	Servo servo;
+	vpp.setPeriodicFunction(servo, &period);
+	uint64_t firstDigest = 0;
+	bool same = true;
+	for (int run = 0; run < 3; ++run) {
+		replay.rewind();
+		Clock::time_point start = Clock::now();
+		uint64_t ticks = replay.run();
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		if (run == 0) {
+			firstDigest = replay.forceDigest();
+		}
+		same = same && replay.forceDigest() == firstDigest;
+		std::printf("as fast as possible: %llu ticks in %.4f s (%.0fx real time), servo us: p50 %.3f p99 %.3f, digest %016llx\n",
+		            static_cast<unsigned long long>(ticks), elapsed, ticks / elapsed / rate,
+		            percentile(replay.tickTimes(), 50) * us, percentile(replay.tickTimes(), 99) * us,
+		            static_cast<unsigned long long>(replay.forceDigest()));
+	}
+	std::printf("forces %s across runs\n", same ? "identical" : "DIFFER");
+
+	Nothing nothing;
+	vpp.setPeriodicFunction(nothing, &period);
+	replay.rewind();
+	Clock::time_point start = Clock::now();
+	uint64_t ticks = replay.run();
+	double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	std::printf("replay cost with an empty servo: %.1f ns per tick\n", elapsed / ticks * 1e9);
+
+	servo.starts.reserve(count);
+	vpp.setPeriodicFunction(servo, &period);
+	replay.rewind();
+	replay.setPacing(VirtuoseReplaySession::RecordedRate);
+	vpp.startLoop();
+	replay.wait();
+	vpp.stopLoop();
+	std::vector<double> intervals;
+	for (std::size_t i = 1; i < servo.starts.size(); ++i) {
+		intervals.push_back(std::chrono::duration<double>(servo.starts[i] - servo.starts[i - 1]).count());
+	}
+	double span = std::chrono::duration<double>(servo.starts.back() - servo.starts.front()).count();
+	std::printf("recorded rate: %llu ticks over %.3f s (recorded %.3f s), interval us: p50 %.1f p99 %.1f max %.1f, digest %s\n",
+	            static_cast<unsigned long long>(replay.ticks()), span, (count - 1) / double(rate),
+	            percentile(intervals, 50) * us, percentile(intervals, 99) * us, percentile(intervals, 100) * us,
+	            replay.forceDigest() == firstDigest ? "identical" : "DIFFERS");
+	return same && replay.forceDigest() == firstDigest ? 0 : 1;
+}
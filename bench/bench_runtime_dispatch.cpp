@@ -0,0 +1,101 @@
+/**
+	@file
+	@brief Compares the hot calls made by vpp.h through the runtime-loaded
+	backend, which translates each function number through the table of
+	the version detected at load, with the same calls made straight to
+	the linked library's virtCallDLL, as the vendor's inline functions do.
+
+	Both go to the mock backend: it is linked for the baseline, and
+	loaded again by VirtuoseRuntime::load(), which gets the same instance.
+	Run with VIRTUOSE_MOCK_API_VERSION set to an older version (e.g. 3010)
+	to also time a call to a function that version doesn't have.
+
+	Usage: bench_runtime_dispatch [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+
+static const long defaultIterations = 2000000;
+
+static void report(const char * what, double linked, double runtime) {
+	std::printf("%-14s linked virtCallDLL %8.2f ns   runtime table %8.2f ns   overhead %+7.2f ns\n",
+	            what, linked, runtime, runtime - linked);
+}
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	if (!VirtuoseRuntime::load("libvirtuoseapi-mock.so")) {
+		std::printf("%s\n", VirtuoseRuntime::loadError().c_str());
+		return 1;
+	}
+	std::printf("library reports VirtuoseAPI %d.%d, using the table for %d.%d\n",
+	            VirtuoseRuntime::apiVersion() / 1000, VirtuoseRuntime::apiVersion() % 1000,
+	            VirtuoseRuntime::tableVersion() / 1000, VirtuoseRuntime::tableVersion() % 1000);
+
+	Virtuose vpp("bench");
+	VirtContext vc = vpp.getVirtContext();
+	float pos[7];
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+	VirtuoseState state;
+	volatile float sink;
+
+	double linked = nanosecondsPerCall(iterations, [&] {
+		virtCallDLL(GETPOSITION, vc, pos);
+		sink = pos[0];
+	});
+	double runtime = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(pos);
+		sink = pos[0];
+	});
+	report("getPosition", linked, runtime);
+
+	linked = nanosecondsPerCall(iterations, [&] {
+		virtCallDLL(SETFORCE, vc, force);
+	});
+	runtime = nanosecondsPerCall(iterations, [&] {
+		vpp.setForce(force);
+	});
+	report("setForce", linked, runtime);
+
+	linked = nanosecondsPerCall(iterations, [&] {
+		virtCallDLL(GETPOSITION, vc, state.position.data);
+		virtCallDLL(GETSPEED, vc, state.speed.data);
+		for (int i = 0; i < VPP_STATE_BUTTON_COUNT; ++i) {
+			int pressed;
+			virtCallDLL(GETBUTTON, vc, &i, &pressed);
+		}
+		virtCallDLL(GETDEADMAN, vc, &state.deadMan);
+		virtCallDLL(GETEMERGENCYSTOP, vc, &state.emergencyStop);
+		virtCallDLL(GETPOWERON, vc, &state.powerOn);
+		virtCallDLL(GETTIMELASTUPDATE, vc, &state.timeLastUpdate);
+		sink = state.position[0];
+	});
+	runtime = nanosecondsPerCall(iterations, [&] {
+		vpp.readState(state);
+		sink = state.position[0];
+	});
+	report("readState", linked, runtime);
+
+	if (!VirtuoseRuntime::has(vpp_runtime::GETARTICULARPOSITION)) {
+		float articular[20];
+		double absent = nanosecondsPerCall(iterations, [&] {
+			sink = static_cast<float>(vpp.tryGetArticularPosition(articular).errorCode);
+		});
+		std::printf("%-14s absent in this version: %8.2f ns, without calling the library\n", "getArticular", absent);
+	}
+	(void) sink;
+	return 0;
+}
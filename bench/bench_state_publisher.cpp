@@ -0,0 +1,162 @@
+/**
+	@file
+	@brief Contention benchmark and consistency check for
+	VirtuoseStatePublisher, compared with guarding the state with a mutex.
+
+	One writer thread publishes as fast as it can while 1 to 8 reader
+	threads read continuously. Every published VirtuoseState has all of
+	its fields derived from the same counter, so readers can detect a
+	torn read; the torn count must always be zero, and the program exits
+	with a nonzero status if it isn't.
+
+	With --check, runs only VirtuoseStatePublisher, for 0.25 s per reader
+	count unless given: the stress test make test runs.
+
+	Usage: bench_state_publisher [--check] [seconds-per-run]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-state-publisher.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	class MutexPublisher {
+		public:
+			void publish(VirtuoseState const& value) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				value_ = value;
+			}
+			bool tryRead(VirtuoseState & value) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				value = value_;
+				return true;
+			}
+		private:
+			std::mutex mutex_;
+			VirtuoseState value_;
+	};
+
+	VirtuoseState makeState(unsigned int i) {
+		VirtuoseState s;
+		for (int k = 0; k < VirtuoseDisplacement::size; ++k) {
+			s.position[k] = static_cast<float>(i + k);
+		}
+		for (int k = 0; k < VirtuoseTwist::size; ++k) {
+			s.speed[k] = static_cast<float>(i + k);
+		}
+		s.buttons = i;
+		s.deadMan = static_cast<int>(i);
+		s.emergencyStop = static_cast<int>(i);
+		s.powerOn = static_cast<int>(i);
+		s.timeLastUpdate = i;
+		return s;
+	}
+
+	bool consistent(VirtuoseState const& s) {
+		unsigned int i = s.timeLastUpdate;
+		// floats are exact up to 2^24, which the counter stays well below
+		// in a run of a few seconds; compare the low bits otherwise.
+		unsigned int low = i & 0xffffffu;
+		for (int k = 0; k < VirtuoseDisplacement::size; ++k) {
+			if ((static_cast<unsigned int>(s.position[k]) & 0xffffffu) != ((low + k) & 0xffffffu) && i < (1u << 24)) {
+				return false;
+			}
+		}
+		return s.buttons == i && s.deadMan == static_cast<int>(i) && s.powerOn == static_cast<int>(i);
+	}
+
+	/// @brief Returns the number of torn reads.
+	template<typename Publisher>
+	unsigned long run(const char * name, int readers, double seconds) {
+		Publisher publisher;
+		publisher.publish(makeState(0));
+		std::atomic<bool> done(false);
+		std::atomic<unsigned long> reads(0);
+		std::atomic<unsigned long> torn(0);
+
+		std::vector<std::thread> threads;
+		for (int r = 0; r < readers; ++r) {
+			threads.push_back(std::thread([&] {
+				unsigned long myReads = 0;
+				unsigned long myTorn = 0;
+				VirtuoseState s;
+				while (!done.load(std::memory_order_relaxed)) {
+					if (publisher.tryRead(s)) {
+						++myReads;
+						if (!consistent(s)) {
+							++myTorn;
+						}
+					}
+				}
+				reads += myReads;
+				torn += myTorn;
+			}));
+		}
+
+		std::vector<double> publishNs;
+		publishNs.reserve(1 << 20);
+		Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+		unsigned int i = 1;
+		for (; Clock::now() < end; ++i) {
+			VirtuoseState s = makeState(i);
+			Clock::time_point a = Clock::now();
+			publisher.publish(s);
+			Clock::time_point b = Clock::now();
+			if (publishNs.size() < publishNs.capacity()) {
+				publishNs.push_back(std::chrono::duration<double, std::nano>(b - a).count());
+			}
+		}
+		done = true;
+		for (std::size_t t = 0; t < threads.size(); ++t) {
+			threads[t].join();
+		}
+
+		std::sort(publishNs.begin(), publishNs.end());
+		std::printf("%-8s readers %d | writes %9.0f/s  reads %10.0f/s | publish ns: p50 %7.1f p99 %7.1f max %9.1f | torn %lu\n",
+		            name, readers, i / seconds, reads / seconds,
+		            publishNs[publishNs.size() / 2], publishNs[publishNs.size() * 99 / 100], publishNs.back(),
+		            torn.load());
+		return torn.load();
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	bool check = (argc > 1) && std::strcmp(argv[1], "--check") == 0;
+	if (check) {
+		--argc;
+		++argv;
+	}
+	double seconds = (argc > 1) ? std::atof(argv[1]) : (check ? 0.25 : 2.0);
+	const int readerCounts[] = {1, 2, 4, 8};
+	unsigned long torn = 0;
+	for (std::size_t i = 0; i < sizeof(readerCounts) / sizeof(readerCounts[0]); ++i) {
+		torn += run<VirtuoseStatePublisher<> >("seqlock", readerCounts[i], seconds);
+		if (!check) {
+			torn += run<MutexPublisher>("mutex", readerCounts[i], seconds);
+		}
+	}
+	if (torn > 0) {
+		std::printf("FAILED: %lu torn reads\n", torn);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,135 @@
+/**
+	@file
+	@brief Measures what the backend of BasicVirtuose costs: the same
+	in-process backend used as the template parameter (resolved at compile
+	time), called through a virtual interface (as a run-time backend
+	selection would), and Virtuose through the stub virtCallDLL for
+	reference.
+
+	The in-process backend keeps the device state in memory, as a test
+	double or a recording/replay backend would, so the numbers are
+	nearly all dispatch.
+
+	Usage: bench_static_backend [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const long defaultIterations = 20000000;
+
+namespace {
+	/// Device state of the in-process backend.
+	struct Device {
+		float position[7];
+		float force[6];
+	} device;
+
+	/// A complete backend, for what BasicVirtuose uses here.
+	struct InProcessBackend {
+		static VirtContext virtOpen(const char *) {
+			return reinterpret_cast<VirtContext>(&device);
+		}
+		static int virtClose(VirtContext) {
+			return 0;
+		}
+		static int virtGetErrorCode(VirtContext) {
+			return VIRT_E_NO_ERROR;
+		}
+		static char * virtGetErrorMessage(int) {
+			return const_cast<char *>("");
+		}
+		static int virtGetPosition(VirtContext vc, float * pos) {
+			std::memcpy(pos, static_cast<Device *>(vc)->position, sizeof(float) * 7);
+			return 0;
+		}
+		static int virtSetForce(VirtContext vc, float * force) {
+			std::memcpy(static_cast<Device *>(vc)->force, force, sizeof(float) * 6);
+			return 0;
+		}
+	};
+
+	/// The same operations behind a virtual interface.
+	class DynamicBackend {
+		public:
+			virtual ~DynamicBackend() {}
+			virtual int getPosition(float * pos) = 0;
+			virtual int setForce(float * force) = 0;
+	};
+
+	class InProcessDynamicBackend : public DynamicBackend {
+		public:
+			explicit InProcessDynamicBackend(VirtContext vc) : vc_(vc) {}
+			virtual int getPosition(float * pos) {
+				return InProcessBackend::virtGetPosition(vc_, pos);
+			}
+			virtual int setForce(float * force) {
+				return InProcessBackend::virtSetForce(vc_, force);
+			}
+		private:
+			VirtContext vc_;
+	};
+
+	/// Keeps the compiler from devirtualizing the calls.
+	__attribute__((noinline)) DynamicBackend * makeDynamicBackend(VirtContext vc) {
+		return new InProcessDynamicBackend(vc);
+	}
+} // end of anonymous namespace
+
+static void report(const char * what, double templated, double dynamic, double api) {
+	std::printf("%-12s template parameter %6.2f ns   virtual interface %6.2f ns   Virtuose (stub virtCallDLL) %6.2f ns\n",
+	            what, templated, dynamic, api);
+}
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : defaultIterations;
+	BasicVirtuose<InProcessBackend> sim("bench");
+	DynamicBackend * dynamic = makeDynamicBackend(sim.getVirtContext());
+	Virtuose vpp("bench");
+
+	float pos[7];
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+	volatile float sink;
+
+	double templated = nanosecondsPerCall(iterations, [&] {
+		sim.getPosition(pos);
+		sink = pos[0];
+	});
+	double virtualCall = nanosecondsPerCall(iterations, [&] {
+		dynamic->getPosition(pos);
+		sink = pos[0];
+	});
+	double api = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(pos);
+		sink = pos[0];
+	});
+	report("getPosition", templated, virtualCall, api);
+
+	templated = nanosecondsPerCall(iterations, [&] {
+		sim.setForce(force);
+	});
+	virtualCall = nanosecondsPerCall(iterations, [&] {
+		dynamic->setForce(force);
+	});
+	api = nanosecondsPerCall(iterations, [&] {
+		vpp.setForce(force);
+	});
+	report("setForce", templated, virtualCall, api);
+
+	delete dynamic;
+	(void) sink;
+	return 0;
+}
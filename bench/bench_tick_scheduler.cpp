@@ -0,0 +1,144 @@
+/**
+	@file
+	@brief Drives 1, 2, 4 and 8 mock devices at 1 kHz, first with
+	VirtuoseTickScheduler, then with one periodic function per device,
+	and reports the skew between the devices' state reads within a tick.
+
+	For the scheduler, that's the time between the first and the last
+	device's read in each tick, along with how late the timer thread
+	woke up and how many ticks it missed. For separate periodic
+	functions, it's the spread between the devices' k-th ticks.
+
+	Usage: bench_tick_scheduler [seconds [priority]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-device-group.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	const double period = 0.001;
+
+	int64_t nowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	double percentile(std::vector<double> & values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[static_cast<std::size_t>(p / 100.0 * (values.size() - 1) + 0.5)];
+	}
+
+	/// @brief Spring to the origin for every device, recording skew and lateness.
+	struct SchedulerCallback {
+		std::vector<double> skewUs;
+		std::vector<double> latenessUs;
+
+		void operator()(VirtuoseTickFrame & frame) {
+			for (std::size_t i = 0; i < frame.count; ++i) {
+				VirtuoseCommand & c = frame.commands[i];
+				c.fields = VirtuoseCommand::Force;
+				for (int k = 0; k < 6; ++k) {
+					c.force[k] = k < 3 ? -50.f * frame.states[i].position[k] : 0.f;
+				}
+			}
+			skewUs.push_back(frame.readSkewNs / 1000.0);
+			latenessUs.push_back((frame.wakeNs - frame.deadlineNs) / 1000.0);
+		}
+	};
+
+	/// @brief One device's own periodic function: the same spring, and
+	/// the time of each tick's state read.
+	struct SeparateServo {
+		std::vector<int64_t> readNs;
+
+		void operator()(Virtuose & vpp) {
+			VirtuoseState state;
+			vpp.readState(state);
+			readNs.push_back(nowNs());
+			float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+			for (int k = 0; k < 3; ++k) {
+				force[k] = -50.f * state.position[k];
+			}
+			vpp.setForce(force);
+		}
+	};
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 1.0;
+	int priority = (argc > 2) ? std::atoi(argv[2]) : 0;
+	std::size_t ticks = static_cast<std::size_t>(seconds / period);
+	std::chrono::duration<double> runTime(seconds);
+
+	for (std::size_t devices = 1; devices <= 8; devices *= 2) {
+		std::vector<std::unique_ptr<Virtuose> > vpps;
+		for (std::size_t i = 0; i < devices; ++i) {
+			vpps.push_back(std::unique_ptr<Virtuose>(new Virtuose("bench")));
+		}
+
+		SchedulerCallback callback;
+		callback.skewUs.reserve(ticks * 2);
+		callback.latenessUs.reserve(ticks * 2);
+		VirtuoseTickScheduler scheduler;
+		for (std::size_t i = 0; i < devices; ++i) {
+			scheduler.add(*vpps[i]);
+		}
+		scheduler.start(callback, period, VirtuoseThreadOptions(-1, priority));
+		std::this_thread::sleep_for(runTime);
+		scheduler.stop();
+		VirtuoseTickStats stats = scheduler.stats();
+
+		std::vector<SeparateServo> servos(devices);
+		float p = static_cast<float>(period);
+		for (std::size_t i = 0; i < devices; ++i) {
+			servos[i].readNs.reserve(ticks * 2);
+			vpps[i]->setPeriodicFunction(servos[i], &p);
+			vpps[i]->startLoop();
+		}
+		std::this_thread::sleep_for(runTime);
+		for (std::size_t i = 0; i < devices; ++i) {
+			vpps[i]->stopLoop();
+		}
+		std::size_t common = servos[0].readNs.size();
+		for (std::size_t i = 1; i < devices; ++i) {
+			common = std::min(common, servos[i].readNs.size());
+		}
+		std::vector<double> separateSkewUs;
+		for (std::size_t k = 0; k < common; ++k) {
+			int64_t earliest = servos[0].readNs[k], latest = servos[0].readNs[k];
+			for (std::size_t i = 1; i < devices; ++i) {
+				earliest = std::min(earliest, servos[i].readNs[k]);
+				latest = std::max(latest, servos[i].readNs[k]);
+			}
+			separateSkewUs.push_back((latest - earliest) / 1000.0);
+		}
+
+		std::printf("%zu device(s): scheduler read skew p50 %6.2f us p99 %6.2f us max %6.2f us, wake-up late p99 %6.1f us, %llu of %llu ticks missed\n",
+		            devices, percentile(callback.skewUs, 50), percentile(callback.skewUs, 99), percentile(callback.skewUs, 100),
+		            percentile(callback.latenessUs, 99), static_cast<unsigned long long>(stats.missedTicks),
+		            static_cast<unsigned long long>(stats.ticks + stats.missedTicks));
+		std::printf("%14s separate loops skew p50 %6.2f us p99 %6.2f us max %6.2f us\n", "",
+		            percentile(separateSkewUs, 50), percentile(separateSkewUs, 99), percentile(separateSkewUs, 100));
+	}
+	return 0;
+}
@@ -0,0 +1,39 @@
+/**
+	@file
+	@brief Timing helper shared by the micro-benchmarks.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_bench_timing_h_GUID_8f1d2c3b_4a5e_4f60_9b7c_1d2e3f4a5b6c
+#define INCLUDED_bench_timing_h_GUID_8f1d2c3b_4a5e_4f60_9b7c_1d2e3f4a5b6c
+
+// Internal Includes
+// none
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <chrono>
+
+/// @brief Runs f() a tenth of @a iterations to warm up, then
+/// @a iterations times, and returns the mean wall time per call.
+template<typename F>
+double nanosecondsPerCall(long iterations, F f) {
+	typedef std::chrono::steady_clock Clock;
+	for (long i = 0; i < iterations / 10; ++i) {
+		f();
+	}
+	Clock::time_point start = Clock::now();
+	for (long i = 0; i < iterations; ++i) {
+		f();
+	}
+	Clock::time_point end = Clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+#endif // INCLUDED_bench_timing_h_GUID_8f1d2c3b_4a5e_4f60_9b7c_1d2e3f4a5b6c
@@ -0,0 +1,102 @@
+/**
+	@file
+	@brief Measures what VirtuoseTimingController adds to each tick, then
+	runs a mock device at 1 kHz through a load profile (0.3 ms of work per
+	tick for 1 s, 1.6 ms for 2 s, 0.3 ms again for 3 s), once at a fixed
+	rate and once letting the controller step the rate between 1 and
+	4 ms, and reports overruns, late ticks, missed device updates and the
+	time step over time.
+
+	Usage: bench_timing_controller [iterations]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#include <vpp-timing-controller.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	/// @brief A spring to the origin, after busy work whose length
+	/// follows the load profile.
+	struct LoadedServo {
+		Clock::time_point start;
+		bool profile;
+
+		void operator()(Virtuose & vpp) {
+			if (profile) {
+				double t = std::chrono::duration<double>(Clock::now() - start).count();
+				std::chrono::microseconds work(t >= 1. && t < 3. ? 1600 : 300);
+				Clock::time_point end = Clock::now() + work;
+				while (Clock::now() < end) {
+				}
+			}
+			VirtuoseState state;
+			vpp.readState(state);
+			float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+			for (int k = 0; k < 3; ++k) {
+				force[k] = -50.f * state.position[k];
+			}
+			vpp.setForce(force);
+		}
+	};
+
+	void runProfile(Virtuose & vpp, const char * what, VirtuoseTimingOptions const& options) {
+		vpp.setTimeStep(0.001f);
+		LoadedServo servo = {Clock::now(), true};
+		VirtuoseTimingController<LoadedServo> timed(servo, options);
+		timed.start(vpp);
+		std::string steps;
+		for (int i = 0; i < 60; ++i) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			timed.adapt(vpp);
+			if (i % 5 == 4) {
+				char buf[16];
+				std::snprintf(buf, sizeof(buf), " %.0f", timed.stats().stepNs / 1e6);
+				steps += buf;
+			}
+		}
+		timed.stop(vpp);
+		VirtuoseTimingStats stats = timed.stats();
+		std::printf("%-10s %5llu ticks, %4llu overran (at most %4llu in a row), %4llu late, %4llu device updates missed, %llu rate changes\n",
+		            what, static_cast<unsigned long long>(stats.ticks), static_cast<unsigned long long>(stats.overruns),
+		            static_cast<unsigned long long>(stats.maxConsecutiveOverruns), static_cast<unsigned long long>(stats.lateTicks),
+		            static_cast<unsigned long long>(stats.missedUpdates), static_cast<unsigned long long>(stats.rateChanges));
+		std::printf("%-10s step every 0.5 s (ms):%s\n", "", steps.c_str());
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : 1000000;
+	Virtuose vpp("bench");
+
+	LoadedServo servo = {Clock::now(), false};
+	VirtuoseTimingController<LoadedServo> timed(servo);
+	double direct = nanosecondsPerCall(iterations, [&] {
+		servo(vpp);
+	});
+	double controlled = nanosecondsPerCall(iterations, [&] {
+		timed(vpp);
+	});
+	std::printf("servo tick: %.1f ns, through the controller %.1f ns (+%.1f ns)\n\n", direct, controlled, controlled - direct);
+
+	runProfile(vpp, "fixed", VirtuoseTimingOptions());
+	VirtuoseTimingOptions adaptive(0.001, 0.004);
+	adaptive.windowTicks = 100;
+	runProfile(vpp, "adaptive", adaptive);
+	return 0;
+}
@@ -0,0 +1,159 @@
+/**
+	@file
+	@brief Measures what VPP_TRACE adds to a call on the mock: built as
+	bench_trace with it and bench_trace_off without. With VPP_TRACE, then
+	runs a 1 kHz servo on the mock next to a 60 Hz "render" thread, first
+	untraced and then with a VirtuoseTraceWriter open, compares the
+	ticks' durations and intervals, and leaves the trace in a file to
+	open in chrome://tracing or ui.perfetto.dev.
+
+	Usage: bench_trace [iterations] [seconds] [trace file]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "bench_timing.h"
+#ifdef VPP_TRACE
+#	include <vpp-trace.h>
+#else
+#	include <vpp.h>
+#endif
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef VPP_TRACE
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double percentile(std::vector<double> & values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[static_cast<std::size_t>(p / 100.0 * (values.size() - 1) + 0.5)];
+	}
+
+	/// @brief A spring to the origin, keeping each tick's duration and
+	/// the time since the previous one.
+	struct Servo {
+		std::vector<double> tickUs;
+		std::vector<double> intervalUs;
+		Clock::time_point last;
+
+		void operator()(Virtuose & vpp) {
+			Clock::time_point begin = Clock::now();
+			VirtuoseState state;
+			vpp.readState(state);
+			float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+			for (int k = 0; k < 3; ++k) {
+				force[k] = -50.f * state.position[k];
+			}
+			vpp.setForce(force);
+			if (last != Clock::time_point()) {
+				intervalUs.push_back(std::chrono::duration<double, std::micro>(begin - last).count());
+			}
+			last = begin;
+			tickUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+		}
+	};
+
+	/// @brief 60 frames a second of 3 ms of work, each a traced event.
+	void render(std::atomic<bool> & stop) {
+		VirtuoseTraceWriter::nameThread("render");
+		Clock::time_point next = Clock::now();
+		while (!stop.load(std::memory_order_relaxed)) {
+			{
+				VirtuoseTraceScope frame("frame");
+				Clock::time_point end = Clock::now() + std::chrono::milliseconds(3);
+				while (Clock::now() < end) {
+				}
+			}
+			next += std::chrono::microseconds(16667);
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+	void runLoop(Virtuose & vpp, const char * what, double seconds, const char * path) {
+		Servo servo;
+		servo.tickUs.reserve(static_cast<std::size_t>(seconds * 2000));
+		servo.intervalUs.reserve(static_cast<std::size_t>(seconds * 2000));
+		VirtuoseTraceWriter * writer = path ? new VirtuoseTraceWriter(path) : NULL;
+		std::atomic<bool> stop(false);
+		std::thread renderer(render, std::ref(stop));
+		float period = 0.001f;
+		vpp.setPeriodicFunction(servo, &period);
+		vpp.startLoop();
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		vpp.stopLoop();
+		stop = true;
+		renderer.join();
+		std::size_t ticks = servo.tickUs.size();
+		std::printf("%-10s %5zu ticks: tick p50 %6.2f us p99 %6.2f us max %7.1f us   interval p1 %6.1f us p99 %6.1f us max %7.1f us\n",
+		            what, ticks, percentile(servo.tickUs, 50), percentile(servo.tickUs, 99), percentile(servo.tickUs, 100),
+		            percentile(servo.intervalUs, 1), percentile(servo.intervalUs, 99), percentile(servo.intervalUs, 100));
+		if (writer) {
+			writer->close();
+			std::printf("%-10s %llu events written to %s, %llu dropped\n", "",
+			            static_cast<unsigned long long>(writer->written()), path,
+			            static_cast<unsigned long long>(VirtuoseTraceWriter::dropped()));
+			delete writer;
+		}
+	}
+} // end of anonymous namespace
+#endif
+
+int main(int argc, char * argv[]) {
+	long iterations = (argc > 1) ? std::atol(argv[1]) : 1000000;
+	Virtuose vpp("bench");
+	VirtuoseState state;
+	float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+
+	double getPosition = nanosecondsPerCall(iterations, [&] {
+		vpp.getPosition(state.position.data);
+	});
+	double setForce = nanosecondsPerCall(iterations, [&] {
+		vpp.setForce(force);
+	});
+#ifdef VPP_TRACE
+	std::printf("%-22s getPosition %6.2f ns   setForce %6.2f ns\n", "VPP_TRACE, no writer", getPosition, setForce);
+	double seconds = (argc > 2) ? std::atof(argv[2]) : 3.0;
+	std::string path = (argc > 3) ? argv[3] : "bench_trace.json";
+	{
+		// In rounds that fit in the ring, letting the writer drain it in
+		// between, so that's the time to queue events, not to drop them.
+		VirtuoseTraceWriter writer(path, 0.01);
+		const int rounds = 50;
+		getPosition = setForce = 0.;
+		for (int i = 0; i < rounds; ++i) {
+			getPosition += nanosecondsPerCall(3000, [&] {
+				vpp.getPosition(state.position.data);
+			}) / rounds;
+			setForce += nanosecondsPerCall(3000, [&] {
+				vpp.setForce(force);
+			}) / rounds;
+			std::this_thread::sleep_for(std::chrono::milliseconds(25));
+		}
+		std::printf("%-22s getPosition %6.2f ns   setForce %6.2f ns   (%llu events dropped)\n\n", "VPP_TRACE, writer open",
+		            getPosition, setForce, static_cast<unsigned long long>(VirtuoseTraceWriter::dropped()));
+	}
+	runLoop(vpp, "untraced", seconds, NULL);
+	runLoop(vpp, "traced", seconds, path.c_str());
+#else
+	std::printf("%-22s getPosition %6.2f ns   setForce %6.2f ns\n", "no tracing", getPosition, setForce);
+#endif
+	return 0;
+}
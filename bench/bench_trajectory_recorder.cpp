@@ -0,0 +1,180 @@
+/**
+	@file
+	@brief Throughput and servo-thread cost of VirtuoseTrajectoryRecorder.
+
+	First runs a 4 kHz servo loop on the mock backend (readState, spring
+	force, setForce) that logs every tick, once with fprintf to a file
+	and once with the recorder, and reports what logging costs the tick
+	and how many samples reached the file. Then feeds the recorder
+	an hour of 4 kHz samples (by default) as fast as it takes them, to
+	measure how many records per second the background thread sustains.
+	Both recordings are read back and checked for missing ticks.
+
+	Usage: bench_trajectory_recorder [loop-seconds [burst-samples [file]]]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-trajectory-recorder.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static const int rate = 4000;
+
+namespace {
+	struct LoopData {
+		VirtuoseTrajectoryRecorder * recorder;
+		std::FILE * log;
+		std::vector<double> logging; // seconds
+		unsigned long ticks;
+	};
+
+	void servoTick(VirtContext vc, void * arg) {
+		LoopData & data = *static_cast<LoopData *>(arg);
+		VirtuoseRef vpp(vc);
+		VirtuoseState state = vpp.readState();
+		const float stiffness = 200.f;
+		VirtuoseWrench force = {{ -stiffness * state.position[0], -stiffness * state.position[1], -stiffness * state.position[2], 0.f, 0.f, 0.f}};
+		vpp.setForce(force.data);
+
+		Clock::time_point start = Clock::now();
+		if (data.recorder) {
+			data.recorder->record(state, force);
+		} else {
+			std::fprintf(data.log, "%lu %f %f %f %f %f %f %f %f %f %f %u %d\n", data.ticks,
+			             state.position[0], state.position[1], state.position[2], state.position[3],
+			             state.position[4], state.position[5], state.position[6],
+			             force[0], force[1], force[2], state.buttons, state.deadMan);
+		}
+		Clock::time_point end = Clock::now();
+		if (data.logging.size() < data.logging.capacity()) {
+			data.logging.push_back(std::chrono::duration<double>(end - start).count());
+		}
+		++data.ticks;
+	}
+
+	double percentile(std::vector<double> const& sorted, double p) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		std::size_t idx = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+		return sorted[idx];
+	}
+
+	void runLoop(LoopData & data, double seconds) {
+		data.logging.reserve(static_cast<std::size_t>(rate * seconds * 1.5) + 16);
+		Virtuose vpp("bench");
+		float period = 1.f / rate;
+		vpp.setTimeStep(period);
+		vpp.setPeriodicFunction(servoTick, &period, &data);
+		vpp.startLoop();
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		vpp.stopLoop();
+	}
+
+	void report(const char * what, std::vector<double> & logging) {
+		std::sort(logging.begin(), logging.end());
+		const double us = 1e6;
+		std::printf("%-9s %8lu ticks, logging cost us: p50 %7.3f p99 %7.3f p99.9 %8.3f max %9.3f\n",
+		            what, static_cast<unsigned long>(logging.size()),
+		            percentile(logging, 50) * us, percentile(logging, 99) * us,
+		            percentile(logging, 99.9) * us, logging.empty() ? 0.0 : logging.back() * us);
+	}
+
+	/// @brief Reads the file back and counts ticks missing between records.
+	void check(const char * path, uint64_t expected) {
+		VirtuoseTrajectoryReader reader(path);
+		uint64_t missing = 0;
+		bool ordered = true;
+		for (uint64_t i = 1; i < reader.size(); ++i) {
+			uint64_t prev = reader.sample(i - 1).tick;
+			uint64_t t = reader.sample(i).tick;
+			if (t <= prev) {
+				ordered = false;
+			} else {
+				missing += t - prev - 1;
+			}
+		}
+		std::printf("          file: %llu of %llu samples, %llu dropped, %llu ticks missing between records, %s\n",
+		            static_cast<unsigned long long>(reader.size()), static_cast<unsigned long long>(expected),
+		            static_cast<unsigned long long>(reader.header().dropped), static_cast<unsigned long long>(missing),
+		            ordered ? "in order" : "OUT OF ORDER");
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 10.0;
+	uint64_t burst = (argc > 2) ? std::strtoull(argv[2], NULL, 10) : uint64_t(rate) * 3600;
+	const char * path = (argc > 3) ? argv[3] : "/tmp/bench_trajectory_recorder.vtraj";
+	std::string textPath = std::string(path) + ".txt";
+
+	std::printf("%.1f s at %d Hz per run\n", seconds, rate);
+	{
+		LoopData data = LoopData();
+		data.log = std::fopen(textPath.c_str(), "w");
+		if (!data.log) {
+			std::perror(textPath.c_str());
+			return 1;
+		}
+		runLoop(data, seconds);
+		std::fclose(data.log);
+		std::remove(textPath.c_str());
+		report("fprintf", data.logging);
+	}
+	{
+		LoopData data = LoopData();
+		VirtuoseTrajectoryRecorder recorder(path, static_cast<uint64_t>(rate * seconds * 2) + 16, 1.f / rate);
+		int major, minor;
+		Virtuose::APIVersion(&major, &minor);
+		recorder.setAPIVersion(major, minor);
+		data.recorder = &recorder;
+		runLoop(data, seconds);
+		recorder.close();
+		report("recorder", data.logging);
+		check(path, data.ticks);
+	}
+
+	{
+		VirtuoseTrajectoryRecorder recorder(path, burst, 1.f / rate);
+		VirtuoseTrajectorySample sample = VirtuoseTrajectorySample();
+		Clock::time_point start = Clock::now();
+		for (uint64_t i = 0; i < burst; ++i) {
+			sample.tick = i;
+			sample.position[0] = static_cast<float>(i);
+			// Waits for the background thread instead of dropping.
+			while (!recorder.tryRecord(sample)) {
+				std::this_thread::yield();
+			}
+		}
+		recorder.close();
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		std::printf("burst     %llu samples (%.1f min at %d Hz) written in %.2f s: %.0f records/s, %.0fx real time\n",
+		            static_cast<unsigned long long>(burst), burst / double(rate) / 60, rate, elapsed,
+		            burst / elapsed, burst / elapsed / rate);
+		VirtuoseTrajectoryReader reader(path);
+		uint64_t missing = 0;
+		for (uint64_t i = 1; i < reader.size(); ++i) {
+			missing += reader.sample(i).tick - reader.sample(i - 1).tick - 1;
+		}
+		std::printf("          file: %llu of %llu samples, %llu ticks missing between records\n",
+		            static_cast<unsigned long long>(reader.size()), static_cast<unsigned long long>(burst),
+		            static_cast<unsigned long long>(missing));
+	}
+	std::printf("last recording left in %s (see vpp-trajectory-dump)\n", path);
+	return 0;
+}
@@ -0,0 +1,222 @@
+/**
+	@file
+	@brief Drives a mock device's virtual object along a circle at 1 kHz
+	from a physics step taking 3 to 8 ms, first with the physics run in
+	the periodic function every 5 ticks, then with VirtuoseVOPipeline and
+	the physics in its own thread: holding the latest target, with the
+	default extrapolation, and with a 16 ms delay for interpolation.
+
+	Reports the servo ticks' duration, how many overran the period, and
+	the commanded position's error, against the circle at the time the
+	command is for (including the delay, so that's the error of the
+	playback, not its lag).
+
+	Usage: bench_vo_pipeline [seconds]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-vo-pipeline.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+	const float period = 0.001f;
+	const double radius = 0.05;
+	const double omega = 3.14159265358979 / 2.;
+	const int physicsEvery = 5;
+	const double delay = 0.016;
+
+	double percentile(std::vector<double> & values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[static_cast<std::size_t>(p / 100.0 * (values.size() - 1) + 0.5)];
+	}
+
+	/// @brief The virtual object's true motion: around the circle, turning
+	/// about z to keep facing its center.
+	void truth(double t, VirtuoseDisplacement & position, VirtuoseTwist & speed) {
+		double a = omega * t;
+		position[0] = static_cast<float>(radius * std::cos(a));
+		position[1] = static_cast<float>(radius * std::sin(a));
+		position[2] = 0.f;
+		position[3] = 0.f;
+		position[4] = 0.f;
+		position[5] = static_cast<float>(std::sin(a / 2.));
+		position[6] = static_cast<float>(std::cos(a / 2.));
+		speed[0] = static_cast<float>(-radius * omega * std::sin(a));
+		speed[1] = static_cast<float>(radius * omega * std::cos(a));
+		speed[2] = 0.f;
+		speed[3] = 0.f;
+		speed[4] = 0.f;
+		speed[5] = static_cast<float>(omega);
+	}
+
+	/// @brief A physics step: busy for 3 to 8 ms, then the state for the
+	/// time it started.
+	struct Physics {
+		int64_t startNs;
+		std::mt19937 random;
+		std::uniform_int_distribution<int> durationUs;
+
+		explicit Physics(int64_t start) : startNs(start), random(12), durationUs(3000, 8000) {}
+
+		int64_t step(VirtuoseDisplacement & position, VirtuoseTwist & speed) {
+			int64_t begin = VirtuoseVOPipeline::nowNs();
+			int64_t end = begin + durationUs(random) * 1000;
+			volatile double work = 0.;
+			while (VirtuoseVOPipeline::nowNs() < end) {
+				for (int i = 0; i < 100; ++i) {
+					work = work + std::sqrt(static_cast<double>(i));
+				}
+			}
+			truth((begin - startNs) * 1e-9, position, speed);
+			return begin;
+		}
+	};
+
+	struct Results {
+		std::vector<double> tickUs;
+		std::vector<double> errorMm;
+
+		Results(std::size_t ticks) {
+			tickUs.reserve(ticks);
+			errorMm.reserve(ticks);
+		}
+
+		/// @brief Records a tick started at @a beginNs, commanding
+		/// @a position for the time @a atNs.
+		void record(int64_t startNs, int64_t beginNs, int64_t atNs, VirtuoseDisplacement const& position) {
+			tickUs.push_back((VirtuoseVOPipeline::nowNs() - beginNs) / 1000.0);
+			VirtuoseDisplacement expected;
+			VirtuoseTwist unused;
+			truth((atNs - startNs) * 1e-9, expected, unused);
+			double dx = position[0] - expected[0], dy = position[1] - expected[1], dz = position[2] - expected[2];
+			errorMm.push_back(std::sqrt(dx * dx + dy * dy + dz * dz) * 1000.0);
+		}
+
+		void report(const char * what, VirtuoseVOPipelineStats const* stats) {
+			std::size_t overran = 0;
+			for (std::size_t i = 0; i < tickUs.size(); ++i) {
+				if (tickUs[i] > period * 1e6) {
+					++overran;
+				}
+			}
+			std::size_t ticks = tickUs.size();
+			std::printf("%-24s tick p50 %7.2f us p99 %7.1f us max %7.1f us, %4zu of %5zu overran   error p50 %6.3f mm p99 %6.3f mm max %6.3f mm\n",
+			            what, percentile(tickUs, 50), percentile(tickUs, 99), percentile(tickUs, 100), overran, ticks,
+			            percentile(errorMm, 50), percentile(errorMm, 99), percentile(errorMm, 100));
+			if (stats) {
+				std::printf("%-24s %llu interpolated, %llu extrapolated, %llu held; %llu targets received, %llu skipped\n", "",
+				            static_cast<unsigned long long>(stats->interpolated), static_cast<unsigned long long>(stats->extrapolated),
+				            static_cast<unsigned long long>(stats->held), static_cast<unsigned long long>(stats->received),
+				            static_cast<unsigned long long>(stats->skipped));
+			}
+		}
+	};
+
+	/// @brief The physics in the periodic function, every few ticks.
+	struct InlineServo {
+		Physics * physics;
+		Results * results;
+		int tick;
+		VirtuoseDisplacement position;
+		VirtuoseTwist speed;
+
+		void operator()(Virtuose & vpp) {
+			int64_t begin = VirtuoseVOPipeline::nowNs();
+			if (tick++ % physicsEvery == 0) {
+				physics->step(position, speed);
+			}
+			vpp.setPosition(position.data);
+			vpp.setSpeed(speed.data);
+			results->record(physics->startNs, begin, begin + static_cast<int64_t>(period * 1e9f), position);
+		}
+	};
+
+	/// @brief What VirtuoseVOPipeline::command() does, keeping the pose.
+	struct PipelineServo {
+		VirtuoseVOPipeline * pipeline;
+		Results * results;
+		int64_t startNs;
+		int64_t lookaheadNs;
+
+		void operator()(Virtuose & vpp) {
+			int64_t begin = VirtuoseVOPipeline::nowNs();
+			VirtuoseDisplacement position;
+			VirtuoseTwist speed;
+			if (pipeline->sample(begin, position, speed)) {
+				vpp.setPosition(position.data);
+				vpp.setSpeed(speed.data);
+				results->record(startNs, begin, begin + lookaheadNs, position);
+			}
+		}
+	};
+
+	void runPipeline(Virtuose & vpp, const char * what, double delayS, double maxExtrapolation, double seconds) {
+		float timeStep;
+		vpp.getTimeStep(&timeStep);
+		VirtuoseVOPipeline pipeline(timeStep, delayS, maxExtrapolation);
+		int64_t start = VirtuoseVOPipeline::nowNs();
+		Physics physics(start);
+		Results results(static_cast<std::size_t>(seconds / period * 2));
+		PipelineServo servo = {&pipeline, &results, start, static_cast<int64_t>((timeStep - delayS) * 1e9)};
+		std::atomic<bool> stop(false);
+		std::thread physicsThread([&] {
+			VirtuoseDisplacement position;
+			VirtuoseTwist speed;
+			while (!stop.load(std::memory_order_relaxed)) {
+				int64_t t = physics.step(position, speed);
+				pipeline.publish(position, speed, t);
+			}
+		});
+		float p = period;
+		vpp.setPeriodicFunction(servo, &p);
+		vpp.startLoop();
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		vpp.stopLoop();
+		stop = true;
+		physicsThread.join();
+		VirtuoseVOPipelineStats stats = pipeline.stats();
+		results.report(what, &stats);
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 2.0;
+	Virtuose vpp("bench");
+
+	{
+		Physics physics(VirtuoseVOPipeline::nowNs());
+		Results results(static_cast<std::size_t>(seconds / period * 2));
+		InlineServo servo = {&physics, &results, 0, VirtuoseDisplacement(), VirtuoseTwist()};
+		float p = period;
+		vpp.setPeriodicFunction(servo, &p);
+		vpp.startLoop();
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		vpp.stopLoop();
+		results.report("physics in the servo", NULL);
+	}
+
+	runPipeline(vpp, "pipeline, hold", 0., 0., seconds);
+	runPipeline(vpp, "pipeline, extrapolate", 0., 0.02, seconds);
+	runPipeline(vpp, "pipeline, 16 ms delay", delay, 0.02, seconds);
+	return 0;
+}
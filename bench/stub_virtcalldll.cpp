@@ -0,0 +1,88 @@
+/**
+	@file
+	@brief Do-nothing stand-in for the VirtuoseAPI entry points, used to
+	measure the cost of the C++ wrapper layer itself.
+
+	Every call "succeeds" immediately; getters fill their output with
+	zeros. Kept in its own translation unit so the compiler cannot see
+	through the variadic call in either the raw or the wrapped path.
+
+	The periodic function is not run on a thread: it is recorded, and
+	stubRunPeriodic() calls it synchronously so per-tick dispatch cost
+	can be measured without scheduling noise.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+// none
+
+// Library/third-party includes
+#include <virtuoseAPI.h>
+
+// Standard includes
+#include <cstdarg>
+
+static VirtPeriodicFunction periodicFunction;
+static VirtContext periodicContext;
+static void * periodicArg;
+
+extern "C" int virtCallDLL(virtDLLFunction fn, ...) {
+	va_list args;
+	va_start(args, fn);
+	int ret = 0;
+	switch (fn) {
+		case OPEN:
+			ret = 1;
+			break;
+		case GETPOSITION:
+		case GETSPEED:
+		case GETFORCE: {
+			va_arg(args, VirtContext);
+			float * out = va_arg(args, float *);
+			int n = (fn == GETPOSITION) ? 7 : 6;
+			for (int i = 0; i < n; ++i) {
+				out[i] = 0.f;
+			}
+			break;
+		}
+		case GETBUTTON:
+			va_arg(args, VirtContext);
+			va_arg(args, int *);
+			*va_arg(args, int *) = 0;
+			break;
+		case GETDEADMAN:
+		case GETEMERGENCYSTOP:
+		case GETPOWERON:
+			va_arg(args, VirtContext);
+			*va_arg(args, int *) = 0;
+			break;
+		case GETTIMELASTUPDATE:
+			va_arg(args, VirtContext);
+			*va_arg(args, unsigned int *) = 0;
+			break;
+		case SETPERIODICFUNCTION:
+			periodicContext = va_arg(args, VirtContext);
+			periodicFunction = va_arg(args, VirtPeriodicFunction);
+			va_arg(args, float *);
+			periodicArg = va_arg(args, void *);
+			break;
+		default:
+			break;
+	}
+	va_end(args);
+	return ret;
+}
+
+extern "C" int virtLoadDLL(char *) {
+	return 0;
+}
+
+/// Calls the registered periodic function @a ticks times.
+extern "C" void stubRunPeriodic(long ticks) {
+	for (long i = 0; i < ticks; ++i) {
+		periodicFunction(periodicContext, periodicArg);
+	}
+}
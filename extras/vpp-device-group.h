@@ -0,0 +1,666 @@
+/**
+	@file
+	@brief Runs several devices from one process, in one of two ways:
+	VirtuoseGroup runs each device's periodic loop on its own thread,
+	optionally pinned to a CPU and run with real-time priority, and
+	takes time-aligned snapshots of all their states;
+	VirtuoseTickScheduler drives all the devices from one timer thread,
+	reading all states, calling one callback, then writing all commands
+	on each tick.
+
+	Requires C++11 and POSIX threads; CPU pinning is only available on
+	Linux.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_device_group_h_GUID_6c2f8e41_0b7d_4a93_8e15_d4a9b3f27c58
+#define INCLUDED_vpp_device_group_h_GUID_6c2f8e41_0b7d_4a93_8e15_d4a9b3f27c58
+
+// Internal Includes
+#include <vpp.h>
+#include "vpp-state-publisher.h"
+
+// Library/third-party includes
+#include <pthread.h>
+#include <sched.h>
+
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <time.h>
+
+/** @brief Most devices a VirtuoseGroup can hold. Define before including
+	this header to change it.
+*/
+#ifndef VPP_GROUP_MAX_DEVICES
+#	define VPP_GROUP_MAX_DEVICES 8
+#endif
+
+/** @brief Number of past samples kept per device for aligning snapshots.
+	Define before including this header to change it.
+*/
+#ifndef VPP_GROUP_HISTORY
+#	define VPP_GROUP_HISTORY 16
+#endif
+
+/// @brief Where and how a device's servo thread runs.
+struct VirtuoseThreadOptions {
+	/// CPU to pin the servo thread to, or -1 to leave it unpinned.
+	int cpu;
+	/// SCHED_FIFO priority (1 to 99), or 0 to keep the thread's policy.
+	int priority;
+
+	VirtuoseThreadOptions(int cpu_ = -1, int priority_ = 0) : cpu(cpu_), priority(priority_) {}
+};
+
+/** @brief What applying VirtuoseThreadOptions on a servo thread gave.
+
+	VirtuoseGroup applies the options on each loop's first tick, since
+	those threads belong to the VirtuoseAPI. SCHED_FIFO usually needs CAP_SYS_NICE or
+	an rtprio limit: without them priorityError is EPERM and the loop
+	runs with its usual policy.
+*/
+struct VirtuoseThreadStatus {
+	/// False until the loop's first tick.
+	bool applied;
+	/// 0, or the errno value from pinning the thread.
+	int affinityError;
+	/// 0, or the errno value from switching it to SCHED_FIFO.
+	int priorityError;
+};
+
+/// @brief Applies @a options to the calling thread.
+inline VirtuoseThreadStatus applyVirtuoseThreadOptions(VirtuoseThreadOptions const& options) {
+	VirtuoseThreadStatus ret = {true, 0, 0};
+	if (options.cpu >= 0) {
+#ifdef __linux__
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(options.cpu, &cpus);
+		ret.affinityError = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+		ret.affinityError = ENOSYS;
+#endif
+	}
+	if (options.priority > 0) {
+		sched_param param;
+		param.sched_priority = options.priority;
+		ret.priorityError = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+	}
+	return ret;
+}
+
+/// @brief A device's state at one tick of its loop.
+struct VirtuoseGroupSample {
+	VirtuoseState state;
+	/// Ticks of this device's loop before this one.
+	uint64_t tick;
+	/// When the state was read, in nanoseconds of std::chrono::steady_clock.
+	int64_t timeNs;
+};
+
+/// @brief One sample per device, as close as possible to a common time.
+struct VirtuoseGroupSnapshot {
+	std::size_t count;
+	/// The time the samples were picked for: the latest sample of the
+	/// device that ticked least recently.
+	int64_t timeNs;
+	VirtuoseGroupSample devices[VPP_GROUP_MAX_DEVICES];
+
+	/// @brief Largest difference between two devices' sample times, in ns.
+	int64_t skewNs() const {
+		int64_t earliest = devices[0].timeNs, latest = devices[0].timeNs;
+		for (std::size_t i = 1; i < count; ++i) {
+			earliest = devices[i].timeNs < earliest ? devices[i].timeNs : earliest;
+			latest = devices[i].timeNs > latest ? devices[i].timeNs : latest;
+		}
+		return latest - earliest;
+	}
+};
+
+/** @brief Opens several devices and runs their periodic loops together;
+	use VirtuoseGroup, for the VirtuoseAPI.
+
+	Each device keeps its own loop thread, started by its own
+	startLoop(): nothing is shared between the threads, so the devices
+	don't contend for locks or cache lines, and with one CPU per device
+	they scale across cores. Each tick, the group reads the device's
+	state, publishes it for snapshot(), and calls the servo function
+	with it:
+
+	@code
+	struct Servo {
+		void operator()(std::size_t device, Virtuose & vpp, VirtuoseGroupSample const& sample) {
+			// ...
+			vpp.setForce(force);
+		}
+	} servo;
+
+	VirtuoseGroup group;
+	group.add("left", VirtuoseThreadOptions(2, 80));
+	group.add("right", VirtuoseThreadOptions(3, 80));
+	group.start(servo, 0.001f);
+
+	// in the render thread
+	VirtuoseGroupSnapshot both;
+	if (group.snapshot(both)) {
+		// ...
+	}
+	@endcode
+
+	A tick whose readState() fails skips the servo function; see
+	readErrors().
+*/
+template<typename Backend>
+class BasicVirtuoseGroup {
+	public:
+		typedef BasicVirtuose<Backend> Device;
+
+		BasicVirtuoseGroup() : count_(0), running_(false) {}
+
+		/// @brief Stops the loops, then closes the devices.
+		~BasicVirtuoseGroup() {
+			stop();
+		}
+
+		/** @brief Opens the device @a name, whose loop will run with
+			@a options. Call before start().
+
+			@returns the index of the device in the group.
+
+			@throws VirtuoseAPIError if opening the device failed.
+			@throws std::length_error if the group already holds
+			VPP_GROUP_MAX_DEVICES devices.
+		*/
+		std::size_t add(std::string const& name, VirtuoseThreadOptions const& options = VirtuoseThreadOptions()) {
+			if (count_ == VPP_GROUP_MAX_DEVICES) {
+				throw std::length_error("VirtuoseGroup is full: define VPP_GROUP_MAX_DEVICES to hold more devices");
+			}
+			members_[count_].reset(new Member(name, count_, options));
+			return count_++;
+		}
+
+		std::size_t size() const {
+			return count_;
+		}
+
+		Device & device(std::size_t i) {
+			return members_[i]->vpp;
+		}
+
+		/** @brief Starts every device's loop with @a period, calling
+			servo(index, device, sample) on each tick with the sample
+			just published. @a servo must outlive the loops.
+
+			@returns the result of the first failing call, after stopping
+			the loops already started.
+		*/
+		template<typename F>
+		VirtuoseResult start(F & servo, float period) {
+			VirtuoseResult result = {0, VIRT_E_NO_ERROR};
+			for (std::size_t i = 0; i < count_ && result.ok(); ++i) {
+				Member & m = *members_[i];
+				// F may be const: _tick() casts back to F *.
+				m.servo = const_cast<void *>(static_cast<const volatile void *>(&servo));
+				m.period = period;
+				result = m.vpp.trySetPeriodicFunction(&BasicVirtuoseGroup::_tick<F>, &m.period, &m);
+				if (result.ok()) {
+					result = m.vpp.tryStartLoop();
+				}
+				running_ = running_ || result.ok();
+			}
+			if (!result.ok()) {
+				stop();
+			}
+			return result;
+		}
+
+		/// @brief Stops every device's loop.
+		void stop() {
+			if (!running_) {
+				return;
+			}
+			for (std::size_t i = 0; i < count_; ++i) {
+				members_[i]->vpp.tryStopLoop();
+			}
+			running_ = false;
+		}
+
+		bool running() const {
+			return running_;
+		}
+
+		VirtuoseThreadStatus threadStatus(std::size_t i) const {
+			Member const& m = *members_[i];
+			if (!m.threadApplied.load(std::memory_order_acquire)) {
+				VirtuoseThreadStatus ret = {false, 0, 0};
+				return ret;
+			}
+			return m.threadStatus;
+		}
+
+		/// @brief Ticks of device @a i whose readState() failed.
+		uint64_t readErrors(std::size_t i) const {
+			return members_[i]->readErrors.load(std::memory_order_relaxed);
+		}
+
+		/// @brief Latest sample of device @a i; false before its first tick.
+		bool latest(std::size_t i, VirtuoseGroupSample & sample) const {
+			Member const& m = *members_[i];
+			for (;;) {
+				uint64_t published = m.published.load(std::memory_order_acquire);
+				if (published == 0) {
+					return false;
+				}
+				if (_readTick(m, published - 1, sample)) {
+					return true;
+				}
+			}
+		}
+
+		/** @brief Fills @a snapshot with one sample per device, picking
+			for each the one closest to the time of the least recent
+			device's latest sample. With loops of equal period, the skew
+			is then at most half a period plus their jitter.
+
+			Wait-free for the servo threads; only retries if a loop
+			overwrote a sample while it was read.
+
+			@returns false if a device hasn't ticked yet.
+		*/
+		bool snapshot(VirtuoseGroupSnapshot & snapshot) const {
+			snapshot.count = count_;
+			if (count_ == 0) {
+				return false;
+			}
+			int64_t target = 0;
+			for (std::size_t i = 0; i < count_; ++i) {
+				if (!latest(i, snapshot.devices[i])) {
+					return false;
+				}
+				if (i == 0 || snapshot.devices[i].timeNs < target) {
+					target = snapshot.devices[i].timeNs;
+				}
+			}
+			snapshot.timeNs = target;
+			for (std::size_t i = 0; i < count_; ++i) {
+				_align(*members_[i], target, snapshot.devices[i]);
+			}
+			return true;
+		}
+
+	private:
+		/// @brief A device and what its loop thread publishes.
+		struct Member {
+			Member(std::string const& name, std::size_t index_, VirtuoseThreadOptions const& options_)
+				: vpp(name)
+				, index(index_)
+				, options(options_)
+				, period(0.f)
+				, servo(NULL)
+				, threadConfigured(false)
+				, ticks(0)
+				, published(0)
+				, readErrors(0)
+				, threadApplied(false) {}
+
+			/// The publishers are cache-line aligned, which plain new
+			/// only honours from C++17.
+			static void * operator new(std::size_t size) {
+				void * p = NULL;
+				if (posix_memalign(&p, 64, size) != 0) {
+					throw std::bad_alloc();
+				}
+				return p;
+			}
+			static void operator delete(void * p) {
+				std::free(p);
+			}
+
+			Device vpp;
+			std::size_t const index;
+			VirtuoseThreadOptions const options;
+			float period;
+			void * servo;
+
+			// Only touched by the loop thread.
+			bool threadConfigured;
+			uint64_t ticks;
+
+			std::atomic<uint64_t> published;
+			std::atomic<uint64_t> readErrors;
+			std::atomic<bool> threadApplied;
+			/// Written before threadApplied is set.
+			VirtuoseThreadStatus threadStatus;
+
+			/// Sample of tick t is in history[t % VPP_GROUP_HISTORY].
+			VirtuoseStatePublisher<VirtuoseGroupSample> history[VPP_GROUP_HISTORY];
+		};
+
+		template<typename F>
+		static void _tick(VirtContext, void * arg) {
+			Member & m = *static_cast<Member *>(arg);
+			if (!m.threadConfigured) {
+				m.threadConfigured = true;
+				m.threadStatus = applyVirtuoseThreadOptions(m.options);
+				m.threadApplied.store(true, std::memory_order_release);
+			}
+			VirtuoseGroupSample sample;
+			if (!m.vpp.tryReadState(sample.state).ok()) {
+				m.readErrors.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			sample.tick = m.ticks;
+			sample.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			m.history[m.ticks % VPP_GROUP_HISTORY].publish(sample);
+			++m.ticks;
+			m.published.store(m.ticks, std::memory_order_release);
+			(*static_cast<F *>(m.servo))(m.index, m.vpp, sample);
+		}
+
+		/// @brief Reads the sample of tick @a tick; false if it was
+		/// overwritten by a later one.
+		static bool _readTick(Member const& m, uint64_t tick, VirtuoseGroupSample & sample) {
+			VirtuoseStatePublisher<VirtuoseGroupSample> const& slot = m.history[tick % VPP_GROUP_HISTORY];
+			while (!slot.tryRead(sample)) {
+			}
+			return sample.tick == tick;
+		}
+
+		/// @brief Replaces @a sample, the latest of @a m, by the one
+		/// closest to @a target.
+		static void _align(Member const& m, int64_t target, VirtuoseGroupSample & sample) {
+			// Leaves the oldest slots alone: the loop may be overwriting them.
+			for (int back = 1; back < VPP_GROUP_HISTORY - 1 && sample.tick > 0 && sample.timeNs > target; ++back) {
+				VirtuoseGroupSample older;
+				if (!_readTick(m, sample.tick - 1, older)) {
+					return;
+				}
+				if (older.timeNs <= target && target - older.timeNs >= sample.timeNs - target) {
+					return;
+				}
+				sample = older;
+			}
+		}
+
+		std::unique_ptr<Member> members_[VPP_GROUP_MAX_DEVICES];
+		std::size_t count_;
+		bool running_;
+
+		/// @brief Copy constructor forbidden
+		BasicVirtuoseGroup(BasicVirtuoseGroup const&);
+
+		/// @brief Assignment operator forbidden
+		BasicVirtuoseGroup & operator=(BasicVirtuoseGroup const&);
+};
+
+typedef BasicVirtuoseGroup<VirtuoseAPIBackend> VirtuoseGroup;
+
+/// @brief What a VirtuoseTickScheduler hands its callback on each tick.
+struct VirtuoseTickFrame {
+	/// Ticks before this one.
+	uint64_t tick;
+	/// When the tick was due, in nanoseconds of std::chrono::steady_clock.
+	int64_t deadlineNs;
+	/// When the timer thread woke up for it.
+	int64_t wakeNs;
+	/// Time between the first and the last device's state read.
+	int64_t readSkewNs;
+	std::size_t count;
+	/// Device i's state; its previous one, unchanged, if reading failed.
+	VirtuoseState states[VPP_GROUP_MAX_DEVICES];
+	/// When device i's state read completed.
+	int64_t readTimeNs[VPP_GROUP_MAX_DEVICES];
+	bool stateOk[VPP_GROUP_MAX_DEVICES];
+	/// Written to device i after the callback; fields is 0 on entry, so
+	/// only what the callback sets is sent.
+	VirtuoseCommand commands[VPP_GROUP_MAX_DEVICES];
+};
+
+/// @brief Counters kept by a VirtuoseTickScheduler since start().
+struct VirtuoseTickStats {
+	uint64_t ticks;
+	/// Deadlines passed before the previous tick was done: those ticks
+	/// are skipped, not run late.
+	uint64_t missedTicks;
+	uint64_t readErrors;
+	uint64_t writeErrors;
+	int64_t maxReadSkewNs;
+	/// Longest delay between a deadline and the thread waking up.
+	int64_t maxLatenessNs;
+};
+
+/** @brief Drives several devices in lockstep from one timer thread; use
+	VirtuoseTickScheduler, for the VirtuoseAPI.
+
+	Separate periodic functions tick at unrelated times and drift apart,
+	so a simulation coupling the devices (an object held with both
+	hands) sees their states at different instants. Here each tick reads
+	every device's state back to back, calls one callback with all of
+	them, then writes every device's command, so all devices see the
+	same simulation step. The devices' own loops are not used: don't
+	call startLoop() on them.
+
+	@code
+	struct Bimanual {
+		void operator()(VirtuoseTickFrame & frame) {
+			// frame.states[0] and [1] were read within frame.readSkewNs
+			frame.commands[0].fields = VirtuoseCommand::Force;
+			// ...
+		}
+	} sim;
+
+	Virtuose left("left"), right("right");
+	VirtuoseTickScheduler scheduler;
+	scheduler.add(left);
+	scheduler.add(right);
+	scheduler.start(sim, 0.001, VirtuoseThreadOptions(2, 80));
+	@endcode
+
+	The timer thread sleeps until each absolute deadline (with
+	clock_nanosleep() on Linux, as steady_clock is CLOCK_MONOTONIC
+	there), so the period doesn't drift.
+
+	The callback may call stop(): the tick in progress is the last one.
+*/
+template<typename Backend>
+class BasicVirtuoseTickScheduler {
+	public:
+		typedef BasicVirtuoseMethods<Backend> Device;
+
+		BasicVirtuoseTickScheduler() : count_(0), running_(false), threadApplied_(false) {
+			_resetStats();
+		}
+
+		/// @brief Stops the timer thread.
+		~BasicVirtuoseTickScheduler() {
+			stop();
+		}
+
+		/** @brief Adds @a device, which must outlive the scheduler. Call
+			before start().
+
+			@returns the index of the device in each VirtuoseTickFrame.
+
+			@throws std::length_error if the scheduler already drives
+			VPP_GROUP_MAX_DEVICES devices.
+		*/
+		std::size_t add(Device & device) {
+			if (count_ == VPP_GROUP_MAX_DEVICES) {
+				throw std::length_error("VirtuoseTickScheduler is full: define VPP_GROUP_MAX_DEVICES to drive more devices");
+			}
+			devices_[count_] = &device;
+			return count_++;
+		}
+
+		std::size_t size() const {
+			return count_;
+		}
+
+		/** @brief Starts the timer thread, calling callback(frame) with a
+			VirtuoseTickFrame & every @a period seconds. @a callback must
+			outlive the thread. @a options apply to the timer thread.
+		*/
+		template<typename F>
+		void start(F & callback, double period, VirtuoseThreadOptions const& options = VirtuoseThreadOptions()) {
+			stop();
+			_resetStats();
+			threadApplied_.store(false, std::memory_order_relaxed);
+			running_.store(true, std::memory_order_relaxed);
+			thread_ = std::thread(&BasicVirtuoseTickScheduler::_run<F>, this, &callback,
+			                      static_cast<int64_t>(period * 1e9 + 0.5), options);
+		}
+
+		/// @brief Stops the timer thread, after the tick in progress.
+		/// Called from the callback, doesn't wait for the thread to end.
+		void stop() {
+			running_.store(false, std::memory_order_relaxed);
+			if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+				thread_.join();
+			}
+		}
+
+		bool running() const {
+			return running_.load(std::memory_order_relaxed);
+		}
+
+		VirtuoseThreadStatus threadStatus() const {
+			if (!threadApplied_.load(std::memory_order_acquire)) {
+				VirtuoseThreadStatus ret = {false, 0, 0};
+				return ret;
+			}
+			return threadStatus_;
+		}
+
+		VirtuoseTickStats stats() const {
+			VirtuoseTickStats ret;
+			ret.ticks = ticks_.load(std::memory_order_relaxed);
+			ret.missedTicks = missedTicks_.load(std::memory_order_relaxed);
+			ret.readErrors = readErrors_.load(std::memory_order_relaxed);
+			ret.writeErrors = writeErrors_.load(std::memory_order_relaxed);
+			ret.maxReadSkewNs = maxReadSkewNs_.load(std::memory_order_relaxed);
+			ret.maxLatenessNs = maxLatenessNs_.load(std::memory_order_relaxed);
+			return ret;
+		}
+
+	private:
+		static int64_t _nowNs() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static void _sleepUntil(int64_t deadlineNs) {
+#ifdef __linux__
+			timespec ts;
+			ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000);
+			ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000);
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+			}
+#else
+			typedef std::chrono::steady_clock Clock;
+			std::this_thread::sleep_until(Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(deadlineNs))));
+#endif
+		}
+
+		void _resetStats() {
+			ticks_.store(0, std::memory_order_relaxed);
+			missedTicks_.store(0, std::memory_order_relaxed);
+			readErrors_.store(0, std::memory_order_relaxed);
+			writeErrors_.store(0, std::memory_order_relaxed);
+			maxReadSkewNs_.store(0, std::memory_order_relaxed);
+			maxLatenessNs_.store(0, std::memory_order_relaxed);
+		}
+
+		template<typename F>
+		void _run(F * callback, int64_t periodNs, VirtuoseThreadOptions options) {
+			threadStatus_ = applyVirtuoseThreadOptions(options);
+			threadApplied_.store(true, std::memory_order_release);
+
+			VirtuoseTickFrame frame = VirtuoseTickFrame();
+			frame.count = count_;
+			int64_t deadline = _nowNs() + periodNs;
+			// Counters are only written here: plain loads and stores are enough.
+			for (uint64_t tick = 0; running_.load(std::memory_order_relaxed); ++tick) {
+				_sleepUntil(deadline);
+				frame.tick = tick;
+				frame.deadlineNs = deadline;
+				frame.wakeNs = _nowNs();
+				for (std::size_t i = 0; i < count_; ++i) {
+					// A failed read stops partway through: keep the
+					// previous state whole instead.
+					VirtuoseState state;
+					frame.stateOk[i] = devices_[i]->tryReadState(state).ok();
+					frame.readTimeNs[i] = _nowNs();
+					if (frame.stateOk[i]) {
+						frame.states[i] = state;
+					}
+				}
+				frame.readSkewNs = count_ ? frame.readTimeNs[count_ - 1] - frame.readTimeNs[0] : 0;
+				for (std::size_t i = 0; i < count_; ++i) {
+					frame.commands[i].fields = 0;
+				}
+
+				(*callback)(frame);
+
+				uint64_t writeErrors = 0, readErrors = 0;
+				for (std::size_t i = 0; i < count_; ++i) {
+					readErrors += !frame.stateOk[i];
+					writeErrors += !devices_[i]->tryWriteCommand(frame.commands[i]).ok();
+				}
+				ticks_.store(tick + 1, std::memory_order_relaxed);
+				readErrors_.store(readErrors_.load(std::memory_order_relaxed) + readErrors, std::memory_order_relaxed);
+				writeErrors_.store(writeErrors_.load(std::memory_order_relaxed) + writeErrors, std::memory_order_relaxed);
+				if (frame.readSkewNs > maxReadSkewNs_.load(std::memory_order_relaxed)) {
+					maxReadSkewNs_.store(frame.readSkewNs, std::memory_order_relaxed);
+				}
+				if (frame.wakeNs - deadline > maxLatenessNs_.load(std::memory_order_relaxed)) {
+					maxLatenessNs_.store(frame.wakeNs - deadline, std::memory_order_relaxed);
+				}
+
+				deadline += periodNs;
+				int64_t now = _nowNs();
+				if (deadline <= now) {
+					uint64_t missed = static_cast<uint64_t>((now - deadline) / periodNs) + 1;
+					deadline += static_cast<int64_t>(missed) * periodNs;
+					missedTicks_.store(missedTicks_.load(std::memory_order_relaxed) + missed, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		Device * devices_[VPP_GROUP_MAX_DEVICES];
+		std::size_t count_;
+		std::thread thread_;
+		std::atomic<bool> running_;
+
+		std::atomic<bool> threadApplied_;
+		/// Written before threadApplied_ is set.
+		VirtuoseThreadStatus threadStatus_;
+
+		std::atomic<uint64_t> ticks_;
+		std::atomic<uint64_t> missedTicks_;
+		std::atomic<uint64_t> readErrors_;
+		std::atomic<uint64_t> writeErrors_;
+		std::atomic<int64_t> maxReadSkewNs_;
+		std::atomic<int64_t> maxLatenessNs_;
+
+		/// @brief Copy constructor forbidden
+		BasicVirtuoseTickScheduler(BasicVirtuoseTickScheduler const&);
+
+		/// @brief Assignment operator forbidden
+		BasicVirtuoseTickScheduler & operator=(BasicVirtuoseTickScheduler const&);
+};
+
+typedef BasicVirtuoseTickScheduler<VirtuoseAPIBackend> VirtuoseTickScheduler;
+
+#endif // INCLUDED_vpp_device_group_h_GUID_6c2f8e41_0b7d_4a93_8e15_d4a9b3f27c58
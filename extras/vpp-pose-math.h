@@ -0,0 +1,812 @@
+/**
+	@file
+	@brief Pose math on displacements (translation and quaternion, as
+	used by the VirtuoseAPI), computed in-process: conversion to and from
+	4x4 homogeneous transform matrices, as done by
+	virtConvertDeplToHomogeneMatrix()/virtConvertHomogeneMatrixToDepl(),
+	and composition and inversion.
+
+	The conversions are meant to match those functions, to rounding: the
+	matrix is row major with the translation in its last column (m[3],
+	m[7], m[11]), the quaternion has qw last, and a matrix is converted
+	back with a case analysis on its trace. These conventions have not
+	been checked against the vendor library: the mock backend's
+	conversions are a copy of these.
+
+	Single conversions are plain scalar code: a single pose doesn't have
+	enough independent work for SIMD to pay off. The batch functions
+	convert 8 poses at a time with AVX and 4 at a time with SSE when the
+	compiler targets them (-mavx, or x86-64 for SSE2), converting the
+	rest one by one. Define VPP_POSE_MATH_SCALAR before including this
+	header to use scalar code only.
+
+	compose() and invert() chain displacements, e.g. a position with the
+	observation, base or catch frame, in the same format. Their batch
+	versions take poses as DisplacementArrays, one array per component,
+	so each SIMD lane handles one pose without any shuffling.
+
+	Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_pose_math_h_GUID_d3a61f07_84e2_4c5b_9a1d_6e0f2b7c8d94
+#define INCLUDED_vpp_pose_math_h_GUID_d3a61f07_84e2_4c5b_9a1d_6e0f2b7c8d94
+
+// Internal Includes
+#include <vpp.h>
+
+// Library/third-party includes
+#if !defined(VPP_POSE_MATH_SCALAR) && defined(__AVX__)
+#	define VPP_POSE_MATH_AVX
+#	include <immintrin.h>
+#endif
+#if !defined(VPP_POSE_MATH_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#	define VPP_POSE_MATH_SSE
+#	include <emmintrin.h>
+#	ifdef __SSE4_1__
+#		include <smmintrin.h>
+#	endif
+#endif
+
+// Standard includes
+#include <cmath>
+#include <cstddef>
+
+struct VirtuoseTransformMatrixTag;
+
+/// @brief 4x4 homogeneous transform, row major, translation in the last column.
+typedef VirtuoseFloatArray<16, VirtuoseTransformMatrixTag> VirtuoseTransformMatrix;
+
+namespace vpp_pose {
+	/// @brief Converts one displacement (x, y, z, qx, qy, qz, qw) to a matrix.
+	inline void displacementToMatrix(const float * d, float * m) {
+		float x = d[3], y = d[4], z = d[5], w = d[6];
+		m[0] = 1.f - 2.f * (y * y + z * z);
+		m[1] = 2.f * (x * y - z * w);
+		m[2] = 2.f * (x * z + y * w);
+		m[3] = d[0];
+		m[4] = 2.f * (x * y + z * w);
+		m[5] = 1.f - 2.f * (x * x + z * z);
+		m[6] = 2.f * (y * z - x * w);
+		m[7] = d[1];
+		m[8] = 2.f * (x * z - y * w);
+		m[9] = 2.f * (y * z + x * w);
+		m[10] = 1.f - 2.f * (x * x + y * y);
+		m[11] = d[2];
+		m[12] = m[13] = m[14] = 0.f;
+		m[15] = 1.f;
+	}
+
+	/// @brief Converts one matrix to a displacement (x, y, z, qx, qy, qz, qw).
+	inline void matrixToDisplacement(const float * m, float * d) {
+		d[0] = m[3];
+		d[1] = m[7];
+		d[2] = m[11];
+		float trace = m[0] + m[5] + m[10];
+		if (trace > 0.f) {
+			float s = 0.5f / std::sqrt(trace + 1.f);
+			d[6] = 0.25f / s;
+			d[3] = (m[9] - m[6]) * s;
+			d[4] = (m[2] - m[8]) * s;
+			d[5] = (m[4] - m[1]) * s;
+		} else if (m[0] > m[5] && m[0] > m[10]) {
+			float s = 2.f * std::sqrt(1.f + m[0] - m[5] - m[10]);
+			d[6] = (m[9] - m[6]) / s;
+			d[3] = 0.25f * s;
+			d[4] = (m[1] + m[4]) / s;
+			d[5] = (m[2] + m[8]) / s;
+		} else if (m[5] > m[10]) {
+			float s = 2.f * std::sqrt(1.f + m[5] - m[0] - m[10]);
+			d[6] = (m[2] - m[8]) / s;
+			d[3] = (m[1] + m[4]) / s;
+			d[4] = 0.25f * s;
+			d[5] = (m[6] + m[9]) / s;
+		} else {
+			float s = 2.f * std::sqrt(1.f + m[10] - m[0] - m[5]);
+			d[6] = (m[4] - m[1]) / s;
+			d[3] = (m[2] + m[8]) / s;
+			d[4] = (m[6] + m[9]) / s;
+			d[5] = 0.25f * s;
+		}
+	}
+
+	inline VirtuoseTransformMatrix displacementToMatrix(VirtuoseDisplacement const& d) {
+		VirtuoseTransformMatrix m;
+		displacementToMatrix(d.data, m.data);
+		return m;
+	}
+
+	inline VirtuoseDisplacement matrixToDisplacement(VirtuoseTransformMatrix const& m) {
+		VirtuoseDisplacement d;
+		matrixToDisplacement(m.data, d.data);
+		return d;
+	}
+
+	namespace detail {
+		/* The batch kernels are written once against a "lane set" type,
+			whose vector V holds one value of each of the poses converted
+			together. Loading pose k's 4 floats with loadPose() and
+			transposing 4 of them gives one V per component; with AVX,
+			each 128-bit half transposes separately, so it holds poses
+			k and k + 4.
+		*/
+#ifdef VPP_POSE_MATH_SSE
+		struct SSE {
+			typedef __m128 V;
+			enum { width = 4 };
+
+			static V loadPose(const float * p, std::size_t k, std::size_t stride) {
+				return _mm_loadu_ps(p + k * stride);
+			}
+			static void storePose(float * p, std::size_t k, std::size_t stride, V v) {
+				_mm_storeu_ps(p + k * stride, v);
+			}
+			static V load(const float * p) {
+				return _mm_loadu_ps(p);
+			}
+			static void store(float * p, V v) {
+				_mm_storeu_ps(p, v);
+			}
+			static void transpose(V & r0, V & r1, V & r2, V & r3) {
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			}
+			/// @brief 0, 0, 0, 1 for each pose.
+			static V lastRow() {
+				return _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+			}
+			static V set1(float f) {
+				return _mm_set1_ps(f);
+			}
+			static V add(V a, V b) {
+				return _mm_add_ps(a, b);
+			}
+			static V sub(V a, V b) {
+				return _mm_sub_ps(a, b);
+			}
+			static V mul(V a, V b) {
+				return _mm_mul_ps(a, b);
+			}
+			static V div(V a, V b) {
+				return _mm_div_ps(a, b);
+			}
+			static V sqrt(V a) {
+				return _mm_sqrt_ps(a);
+			}
+			static V greater(V a, V b) {
+				return _mm_cmpgt_ps(a, b);
+			}
+			static V both(V a, V b) {
+				return _mm_and_ps(a, b);
+			}
+			/// @brief a where @a mask is set, else b.
+			static V select(V mask, V a, V b) {
+#ifdef __SSE4_1__
+				return _mm_blendv_ps(b, a, mask);
+#else
+				return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif
+			}
+		};
+#endif
+
+#ifdef VPP_POSE_MATH_AVX
+		struct AVX {
+			typedef __m256 V;
+			enum { width = 8 };
+
+			static V loadPose(const float * p, std::size_t k, std::size_t stride) {
+				return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + k * stride)),
+				                            _mm_loadu_ps(p + (k + 4) * stride), 1);
+			}
+			static void storePose(float * p, std::size_t k, std::size_t stride, V v) {
+				_mm_storeu_ps(p + k * stride, _mm256_castps256_ps128(v));
+				_mm_storeu_ps(p + (k + 4) * stride, _mm256_extractf128_ps(v, 1));
+			}
+			static V load(const float * p) {
+				return _mm256_loadu_ps(p);
+			}
+			static void store(float * p, V v) {
+				_mm256_storeu_ps(p, v);
+			}
+			static void transpose(V & r0, V & r1, V & r2, V & r3) {
+				V t0 = _mm256_unpacklo_ps(r0, r1);
+				V t1 = _mm256_unpackhi_ps(r0, r1);
+				V t2 = _mm256_unpacklo_ps(r2, r3);
+				V t3 = _mm256_unpackhi_ps(r2, r3);
+				r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+				r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+				r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+				r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+			}
+			static V lastRow() {
+				return _mm256_setr_ps(0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f);
+			}
+			static V set1(float f) {
+				return _mm256_set1_ps(f);
+			}
+			static V add(V a, V b) {
+				return _mm256_add_ps(a, b);
+			}
+			static V sub(V a, V b) {
+				return _mm256_sub_ps(a, b);
+			}
+			static V mul(V a, V b) {
+				return _mm256_mul_ps(a, b);
+			}
+			static V div(V a, V b) {
+				return _mm256_div_ps(a, b);
+			}
+			static V sqrt(V a) {
+				return _mm256_sqrt_ps(a);
+			}
+			static V greater(V a, V b) {
+				return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+			}
+			static V both(V a, V b) {
+				return _mm256_and_ps(a, b);
+			}
+			/// @brief a where @a mask is set, else b. Not blendv: GCC
+			/// turns nested blendvs on comparisons into per-element code.
+			static V select(V mask, V a, V b) {
+				return _mm256_or_ps(_mm256_and_ps(mask, a), _mm256_andnot_ps(mask, b));
+			}
+		};
+#endif
+
+		/// @brief Stores the 4 floats of poses 0-3 (and 4-7 with AVX).
+		/// Unrolled, so the values stay in registers.
+		template<typename L>
+		inline void storePoses(float * p, std::size_t stride, typename L::V v0, typename L::V v1, typename L::V v2, typename L::V v3) {
+			L::storePose(p, 0, stride, v0);
+			L::storePose(p, 1, stride, v1);
+			L::storePose(p, 2, stride, v2);
+			L::storePose(p, 3, stride, v3);
+		}
+
+		/// @brief Converts L::width displacements, @a dStride floats
+		/// apart, to matrices @a mStride floats apart.
+		template<typename L>
+		inline void displacementsToMatrices(const float * d, std::size_t dStride, float * m, std::size_t mStride) {
+			typedef typename L::V V;
+			V tx = L::loadPose(d, 0, dStride), ty = L::loadPose(d, 1, dStride), tz = L::loadPose(d, 2, dStride), unused = L::loadPose(d, 3, dStride);
+			L::transpose(tx, ty, tz, unused);
+			V x = L::loadPose(d + 3, 0, dStride), y = L::loadPose(d + 3, 1, dStride), z = L::loadPose(d + 3, 2, dStride), w = L::loadPose(d + 3, 3, dStride);
+			L::transpose(x, y, z, w);
+
+			V one = L::set1(1.f);
+			V two = L::set1(2.f);
+			V xx = L::mul(x, x), yy = L::mul(y, y), zz = L::mul(z, z);
+			V xy = L::mul(x, y), xz = L::mul(x, z), yz = L::mul(y, z);
+			V xw = L::mul(x, w), yw = L::mul(y, w), zw = L::mul(z, w);
+
+			V r00 = L::sub(one, L::mul(two, L::add(yy, zz))), r01 = L::mul(two, L::sub(xy, zw)), r02 = L::mul(two, L::add(xz, yw)), r03 = tx;
+			V r10 = L::mul(two, L::add(xy, zw)), r11 = L::sub(one, L::mul(two, L::add(xx, zz))), r12 = L::mul(two, L::sub(yz, xw)), r13 = ty;
+			V r20 = L::mul(two, L::sub(xz, yw)), r21 = L::mul(two, L::add(yz, xw)), r22 = L::sub(one, L::mul(two, L::add(xx, yy))), r23 = tz;
+			// Now element k of each rI0..rI3 holds row I of pose k.
+			L::transpose(r00, r01, r02, r03);
+			L::transpose(r10, r11, r12, r13);
+			L::transpose(r20, r21, r22, r23);
+			V row3 = L::lastRow();
+			storePoses<L>(m, mStride, r00, r01, r02, r03);
+			storePoses<L>(m + 4, mStride, r10, r11, r12, r13);
+			storePoses<L>(m + 8, mStride, r20, r21, r22, r23);
+			storePoses<L>(m + 12, mStride, row3, row3, row3, row3);
+		}
+
+		/** @brief Converts L::width matrices, @a mStride floats apart, to
+			displacements @a dStride floats apart.
+
+			Each lane picks the case matrixToDisplacement() would, but all
+			cases share one square root and one division, so the results
+			may differ from it in the last bit.
+		*/
+		template<typename L>
+		inline void matricesToDisplacements(const float * m, std::size_t mStride, float * d, std::size_t dStride) {
+			typedef typename L::V V;
+			V m0 = L::loadPose(m, 0, mStride), m1 = L::loadPose(m, 1, mStride), m2 = L::loadPose(m, 2, mStride), tx = L::loadPose(m, 3, mStride);
+			L::transpose(m0, m1, m2, tx);
+			V m4 = L::loadPose(m + 4, 0, mStride), m5 = L::loadPose(m + 4, 1, mStride), m6 = L::loadPose(m + 4, 2, mStride), ty = L::loadPose(m + 4, 3, mStride);
+			L::transpose(m4, m5, m6, ty);
+			V m8 = L::loadPose(m + 8, 0, mStride), m9 = L::loadPose(m + 8, 1, mStride), m10 = L::loadPose(m + 8, 2, mStride), tz = L::loadPose(m + 8, 3, mStride);
+			L::transpose(m8, m9, m10, tz);
+
+			V one = L::set1(1.f);
+			V half = L::set1(0.5f);
+			V trace = L::add(L::add(m0, m5), m10);
+			// The cases, in the order matrixToDisplacement() tries them:
+			// each select() below gives the earlier one priority.
+			V caseA = L::greater(trace, L::set1(0.f));
+			V caseB = L::both(L::greater(m0, m5), L::greater(m0, m10));
+			V caseC = L::greater(m5, m10);
+			V radicand = L::select(caseA, L::add(one, trace),
+			                       L::select(caseB, L::sub(L::sub(L::add(one, m0), m5), m10),
+			                                 L::select(caseC, L::sub(L::sub(L::add(one, m5), m0), m10),
+			                                           L::sub(L::sub(L::add(one, m10), m0), m5))));
+			// With r = 2 sqrt(radicand): the largest component is r / 4,
+			// the others a sum or difference of two elements divided by r.
+			V root = L::sqrt(radicand);
+			V big = L::mul(half, root);
+			V inv = L::div(half, root);
+			V a = L::mul(L::sub(m9, m6), inv);
+			V b = L::mul(L::sub(m2, m8), inv);
+			V c = L::mul(L::sub(m4, m1), inv);
+			V e = L::mul(L::add(m1, m4), inv);
+			V f = L::mul(L::add(m2, m8), inv);
+			V g = L::mul(L::add(m6, m9), inv);
+			V w = L::select(caseA, big, L::select(caseB, a, L::select(caseC, b, c)));
+			V x = L::select(caseA, a, L::select(caseB, big, L::select(caseC, e, f)));
+			V y = L::select(caseA, b, L::select(caseB, e, L::select(caseC, big, g)));
+			V z = L::select(caseA, c, L::select(caseB, f, L::select(caseC, g, big)));
+
+			// x, y, z, w of each pose go over the 4th float of the
+			// translation group, so the translation is stored first.
+			V x3 = x;
+			L::transpose(tx, ty, tz, x3);
+			L::transpose(x, y, z, w);
+			storePoses<L>(d, dStride, tx, ty, tz, x3);
+			storePoses<L>(d + 3, dStride, x, y, z, w);
+		}
+
+		template<typename L>
+		inline std::size_t displacementsToMatrices(const float * d, std::size_t dStride, float * m, std::size_t mStride, std::size_t n) {
+			std::size_t i = 0;
+			for (; i + L::width <= n; i += L::width) {
+				displacementsToMatrices<L>(d + i * dStride, dStride, m + i * mStride, mStride);
+			}
+			return i;
+		}
+
+		template<typename L>
+		inline std::size_t matricesToDisplacements(const float * m, std::size_t mStride, float * d, std::size_t dStride, std::size_t n) {
+			std::size_t i = 0;
+			for (; i + L::width <= n; i += L::width) {
+				matricesToDisplacements<L>(m + i * mStride, mStride, d + i * dStride, dStride);
+			}
+			return i;
+		}
+
+		inline void displacementsToMatrices(const float * d, std::size_t dStride, float * m, std::size_t mStride, std::size_t n) {
+			std::size_t i = 0;
+#ifdef VPP_POSE_MATH_AVX
+			i += displacementsToMatrices<AVX>(d, dStride, m, mStride, n);
+#endif
+#ifdef VPP_POSE_MATH_SSE
+			i += displacementsToMatrices<SSE>(d + i * dStride, dStride, m + i * mStride, mStride, n - i);
+#endif
+			for (; i < n; ++i) {
+				displacementToMatrix(d + i * dStride, m + i * mStride);
+			}
+		}
+
+		inline void matricesToDisplacements(const float * m, std::size_t mStride, float * d, std::size_t dStride, std::size_t n) {
+			std::size_t i = 0;
+#ifdef VPP_POSE_MATH_AVX
+			i += matricesToDisplacements<AVX>(m, mStride, d, dStride, n);
+#endif
+#ifdef VPP_POSE_MATH_SSE
+			i += matricesToDisplacements<SSE>(m + i * mStride, mStride, d + i * dStride, dStride, n - i);
+#endif
+			for (; i < n; ++i) {
+				matrixToDisplacement(m + i * mStride, d + i * dStride);
+			}
+		}
+	} // end of namespace detail
+
+	/// @brief Name of the instruction set the batch functions use.
+	inline const char * batchInstructionSet() {
+#if defined(VPP_POSE_MATH_AVX)
+		return "AVX";
+#elif defined(VPP_POSE_MATH_SSE)
+		return "SSE";
+#else
+		return "scalar";
+#endif
+	}
+
+	/// @brief Converts @a n displacements, packed 7 floats each as the
+	/// VirtuoseAPI passes them, to @a n packed 16-float matrices.
+	inline void displacementsToMatrices(const float * d, float * m, std::size_t n) {
+		detail::displacementsToMatrices(d, 7, m, 16, n);
+	}
+
+	/// @brief Converts @a n packed 16-float matrices to @a n displacements,
+	/// packed 7 floats each.
+	inline void matricesToDisplacements(const float * m, float * d, std::size_t n) {
+		detail::matricesToDisplacements(m, 16, d, 7, n);
+	}
+
+	inline void displacementsToMatrices(VirtuoseDisplacement const * d, VirtuoseTransformMatrix * m, std::size_t n) {
+		detail::displacementsToMatrices(d->data, sizeof(VirtuoseDisplacement) / sizeof(float), m->data, sizeof(VirtuoseTransformMatrix) / sizeof(float), n);
+	}
+
+	inline void matricesToDisplacements(VirtuoseTransformMatrix const * m, VirtuoseDisplacement * d, std::size_t n) {
+		detail::matricesToDisplacements(m->data, sizeof(VirtuoseTransformMatrix) / sizeof(float), d->data, sizeof(VirtuoseDisplacement) / sizeof(float), n);
+	}
+
+	/** @brief Poses stored as one array per component (structure of
+		arrays), for the batch composition functions: pose k is x[k], y[k],
+		z[k], qx[k], qy[k], qz[k], qw[k]. Doesn't own the arrays.
+
+		The functions taking these never allocate, and accept the same
+		arrays as input and output.
+	*/
+	struct DisplacementArrays {
+		float * x;
+		float * y;
+		float * z;
+		float * qx;
+		float * qy;
+		float * qz;
+		float * qw;
+	};
+
+	namespace detail {
+		/// @brief One pose at a time, for the poses left over by the SIMD
+		/// loops and for single poses.
+		struct Scalar {
+			typedef float V;
+			enum { width = 1 };
+
+			static V load(const float * p) {
+				return *p;
+			}
+			static void store(float * p, V v) {
+				*p = v;
+			}
+			static V set1(float f) {
+				return f;
+			}
+			static V add(V a, V b) {
+				return a + b;
+			}
+			static V sub(V a, V b) {
+				return a - b;
+			}
+			static V mul(V a, V b) {
+				return a * b;
+			}
+		};
+
+		/// @brief The components of L::width poses.
+		template<typename L>
+		struct PoseLanes {
+			typename L::V x, y, z, qx, qy, qz, qw;
+		};
+
+		/// @brief Rotates (vx, vy, vz) by the unit quaternion of @a q: with u
+		/// its vector part and t = 2 u x v, that's v + qw t + u x t.
+		template<typename L>
+		inline void rotate(PoseLanes<L> const& q, typename L::V & vx, typename L::V & vy, typename L::V & vz) {
+			typedef typename L::V V;
+			V two = L::set1(2.f);
+			V tx = L::mul(two, L::sub(L::mul(q.qy, vz), L::mul(q.qz, vy)));
+			V ty = L::mul(two, L::sub(L::mul(q.qz, vx), L::mul(q.qx, vz)));
+			V tz = L::mul(two, L::sub(L::mul(q.qx, vy), L::mul(q.qy, vx)));
+			vx = L::add(L::add(vx, L::mul(q.qw, tx)), L::sub(L::mul(q.qy, tz), L::mul(q.qz, ty)));
+			vy = L::add(L::add(vy, L::mul(q.qw, ty)), L::sub(L::mul(q.qz, tx), L::mul(q.qx, tz)));
+			vz = L::add(L::add(vz, L::mul(q.qw, tz)), L::sub(L::mul(q.qx, ty), L::mul(q.qy, tx)));
+		}
+
+		/// @brief a then b: b's translation rotated by a and moved by a's
+		/// translation, and the quaternion product a b.
+		template<typename L>
+		inline PoseLanes<L> compose(PoseLanes<L> const& a, PoseLanes<L> const& b) {
+			PoseLanes<L> ret;
+			ret.x = b.x;
+			ret.y = b.y;
+			ret.z = b.z;
+			rotate<L>(a, ret.x, ret.y, ret.z);
+			ret.x = L::add(a.x, ret.x);
+			ret.y = L::add(a.y, ret.y);
+			ret.z = L::add(a.z, ret.z);
+			ret.qx = L::add(L::add(L::mul(a.qw, b.qx), L::mul(a.qx, b.qw)), L::sub(L::mul(a.qy, b.qz), L::mul(a.qz, b.qy)));
+			ret.qy = L::add(L::add(L::mul(a.qw, b.qy), L::mul(a.qy, b.qw)), L::sub(L::mul(a.qz, b.qx), L::mul(a.qx, b.qz)));
+			ret.qz = L::add(L::add(L::mul(a.qw, b.qz), L::mul(a.qz, b.qw)), L::sub(L::mul(a.qx, b.qy), L::mul(a.qy, b.qx)));
+			ret.qw = L::sub(L::sub(L::mul(a.qw, b.qw), L::mul(a.qx, b.qx)), L::add(L::mul(a.qy, b.qy), L::mul(a.qz, b.qz)));
+			return ret;
+		}
+
+		/// @brief The conjugate quaternion, and the opposite translation
+		/// rotated by it.
+		template<typename L>
+		inline PoseLanes<L> invert(PoseLanes<L> const& d) {
+			typedef typename L::V V;
+			V zero = L::set1(0.f);
+			PoseLanes<L> ret;
+			ret.qx = L::sub(zero, d.qx);
+			ret.qy = L::sub(zero, d.qy);
+			ret.qz = L::sub(zero, d.qz);
+			ret.qw = d.qw;
+			ret.x = L::sub(zero, d.x);
+			ret.y = L::sub(zero, d.y);
+			ret.z = L::sub(zero, d.z);
+			rotate<L>(ret, ret.x, ret.y, ret.z);
+			return ret;
+		}
+
+		/// @brief A packed displacement, the same in every lane.
+		struct BroadcastPose {
+			const float * d;
+
+			template<typename L>
+			PoseLanes<L> get(std::size_t) const {
+				PoseLanes<L> ret = {L::set1(d[0]), L::set1(d[1]), L::set1(d[2]), L::set1(d[3]), L::set1(d[4]), L::set1(d[5]), L::set1(d[6])};
+				return ret;
+			}
+		};
+
+		/// @brief Poses i to i + L::width - 1 of some DisplacementArrays.
+		struct ArrayPoses {
+			DisplacementArrays a;
+
+			template<typename L>
+			PoseLanes<L> get(std::size_t i) const {
+				PoseLanes<L> ret = {L::load(a.x + i), L::load(a.y + i), L::load(a.z + i), L::load(a.qx + i), L::load(a.qy + i), L::load(a.qz + i), L::load(a.qw + i)};
+				return ret;
+			}
+			template<typename L>
+			void put(std::size_t i, PoseLanes<L> const& p) const {
+				L::store(a.x + i, p.x);
+				L::store(a.y + i, p.y);
+				L::store(a.z + i, p.z);
+				L::store(a.qx + i, p.qx);
+				L::store(a.qy + i, p.qy);
+				L::store(a.qz + i, p.qz);
+				L::store(a.qw + i, p.qw);
+			}
+		};
+
+		template<typename A, typename B>
+		struct ComposeBatch {
+			A a;
+			B b;
+			ArrayPoses out;
+
+			template<typename L>
+			void apply(std::size_t i) const {
+				out.put<L>(i, compose<L>(a.template get<L>(i), b.template get<L>(i)));
+			}
+		};
+
+		struct InvertBatch {
+			ArrayPoses in;
+			ArrayPoses out;
+
+			template<typename L>
+			void apply(std::size_t i) const {
+				out.put<L>(i, invert<L>(in.get<L>(i)));
+			}
+		};
+
+		/// @brief Calls k.apply<L>(i) for the widest L available, with i
+		/// stepping by L::width, then with narrower ones for the rest.
+		template<typename K>
+		inline void runBatch(K const& k, std::size_t n) {
+			std::size_t i = 0;
+#ifdef VPP_POSE_MATH_AVX
+			for (; i + AVX::width <= n; i += AVX::width) {
+				k.template apply<AVX>(i);
+			}
+#endif
+#ifdef VPP_POSE_MATH_SSE
+			for (; i + SSE::width <= n; i += SSE::width) {
+				k.template apply<SSE>(i);
+			}
+#endif
+			for (; i < n; ++i) {
+				k.template apply<Scalar>(i);
+			}
+		}
+
+		template<typename A, typename B>
+		inline void composeBatch(A const& a, B const& b, DisplacementArrays out, std::size_t n) {
+			ComposeBatch<A, B> k = {a, b, {out}};
+			runBatch(k, n);
+		}
+
+		template<typename L>
+		inline std::size_t toArrays(const float * d, DisplacementArrays out, std::size_t n) {
+			typedef typename L::V V;
+			std::size_t i = 0;
+			for (; i + L::width <= n; i += L::width) {
+				const float * p = d + i * 7;
+				V x = L::loadPose(p, 0, 7), y = L::loadPose(p, 1, 7), z = L::loadPose(p, 2, 7), unused = L::loadPose(p, 3, 7);
+				L::transpose(x, y, z, unused);
+				V qx = L::loadPose(p + 3, 0, 7), qy = L::loadPose(p + 3, 1, 7), qz = L::loadPose(p + 3, 2, 7), qw = L::loadPose(p + 3, 3, 7);
+				L::transpose(qx, qy, qz, qw);
+				PoseLanes<L> pose = {x, y, z, qx, qy, qz, qw};
+				ArrayPoses a = {out};
+				a.put<L>(i, pose);
+			}
+			return i;
+		}
+
+		template<typename L>
+		inline std::size_t fromArrays(DisplacementArrays in, float * d, std::size_t n) {
+			typedef typename L::V V;
+			std::size_t i = 0;
+			for (; i + L::width <= n; i += L::width) {
+				ArrayPoses a = {in};
+				PoseLanes<L> p = a.get<L>(i);
+				// As in matricesToDisplacements(): the translation first.
+				V qx = p.qx;
+				L::transpose(p.x, p.y, p.z, qx);
+				L::transpose(p.qx, p.qy, p.qz, p.qw);
+				storePoses<L>(d + i * 7, 7, p.x, p.y, p.z, qx);
+				storePoses<L>(d + i * 7 + 3, 7, p.qx, p.qy, p.qz, p.qw);
+			}
+			return i;
+		}
+	} // end of namespace detail
+
+	/** @brief Composes two displacements: @a out is @a b, given relative to
+		the frame @a a, expressed in the frame @a a is given in. For
+		instance, with the position from getPosition() and the frame from
+		getObservationFrame(), compose(observationFrame, position, out).
+
+		@a out may be @a a or @a b.
+	*/
+	inline void compose(const float * a, const float * b, float * out) {
+		detail::BroadcastPose pa = {a}, pb = {b};
+		detail::PoseLanes<detail::Scalar> p = detail::compose<detail::Scalar>(pa.get<detail::Scalar>(0), pb.get<detail::Scalar>(0));
+		out[0] = p.x;
+		out[1] = p.y;
+		out[2] = p.z;
+		out[3] = p.qx;
+		out[4] = p.qy;
+		out[5] = p.qz;
+		out[6] = p.qw;
+	}
+
+	/// @brief The inverse displacement: compose(d, out) is the identity.
+	/// @a out may be @a d.
+	inline void invert(const float * d, float * out) {
+		detail::BroadcastPose pd = {d};
+		detail::PoseLanes<detail::Scalar> p = detail::invert<detail::Scalar>(pd.get<detail::Scalar>(0));
+		out[0] = p.x;
+		out[1] = p.y;
+		out[2] = p.z;
+		out[3] = p.qx;
+		out[4] = p.qy;
+		out[5] = p.qz;
+		out[6] = p.qw;
+	}
+
+	inline VirtuoseDisplacement compose(VirtuoseDisplacement const& a, VirtuoseDisplacement const& b) {
+		VirtuoseDisplacement ret;
+		compose(a.data, b.data, ret.data);
+		return ret;
+	}
+
+	inline VirtuoseDisplacement invert(VirtuoseDisplacement const& d) {
+		VirtuoseDisplacement ret;
+		invert(d.data, ret.data);
+		return ret;
+	}
+
+	/** @brief Pose a fraction @a s of the way from @a a to @a b:
+		translation interpolated linearly, rotation along the shorter arc
+		(normalized linear interpolation of the quaternions, close to
+		slerp for the small steps between successive poses).
+
+		@a out may be @a a or @a b.
+	*/
+	inline void interpolate(const float * a, const float * b, float s, float * out) {
+		float dot = a[3] * b[3] + a[4] * b[4] + a[5] * b[5] + a[6] * b[6];
+		float sb = dot < 0.f ? -s : s;
+		float q[4];
+		float norm = 0.f;
+		for (int k = 0; k < 4; ++k) {
+			q[k] = (1.f - s) * a[3 + k] + sb * b[3 + k];
+			norm += q[k] * q[k];
+		}
+		for (int k = 0; k < 3; ++k) {
+			out[k] = a[k] + s * (b[k] - a[k]);
+		}
+		norm = 1.f / std::sqrt(norm);
+		for (int k = 0; k < 4; ++k) {
+			out[3 + k] = q[k] * norm;
+		}
+	}
+
+	/** @brief Moves @a d at the constant speed @a twist (linear then
+		angular, both in the frame @a d is given in, as returned by
+		getSpeed()) for @a dt seconds.
+
+		@a out may be @a d.
+	*/
+	inline void integrate(const float * d, const float * twist, float dt, float * out) {
+		float wx = twist[3], wy = twist[4], wz = twist[5];
+		float angle = std::sqrt(wx * wx + wy * wy + wz * wz) * dt;
+		// Rotation by angle about w, applied after d's rotation.
+		float sinc = angle > 1e-6f ? std::sin(0.5f * angle) / angle : 0.5f;
+		float delta[7] = {0.f, 0.f, 0.f, wx * dt * sinc, wy * dt * sinc, wz * dt * sinc, std::cos(0.5f * angle)};
+		float rotated[7] = {0.f, 0.f, 0.f, d[3], d[4], d[5], d[6]};
+		compose(delta, rotated, rotated);
+		for (int k = 0; k < 3; ++k) {
+			out[k] = d[k] + twist[k] * dt;
+		}
+		for (int k = 3; k < 7; ++k) {
+			out[k] = rotated[k];
+		}
+	}
+
+	/// @brief Copies @a n displacements, packed 7 floats each, into @a out.
+	inline void toArrays(const float * d, DisplacementArrays out, std::size_t n) {
+		std::size_t i = 0;
+#ifdef VPP_POSE_MATH_AVX
+		i += detail::toArrays<detail::AVX>(d, out, n);
+#endif
+#ifdef VPP_POSE_MATH_SSE
+		DisplacementArrays rest = {out.x + i, out.y + i, out.z + i, out.qx + i, out.qy + i, out.qz + i, out.qw + i};
+		i += detail::toArrays<detail::SSE>(d + i * 7, rest, n - i);
+#endif
+		for (; i < n; ++i) {
+			const float * p = d + i * 7;
+			out.x[i] = p[0];
+			out.y[i] = p[1];
+			out.z[i] = p[2];
+			out.qx[i] = p[3];
+			out.qy[i] = p[4];
+			out.qz[i] = p[5];
+			out.qw[i] = p[6];
+		}
+	}
+
+	/// @brief Copies @a n displacements from @a in, packing them 7 floats
+	/// each into @a d.
+	inline void fromArrays(DisplacementArrays in, float * d, std::size_t n) {
+		std::size_t i = 0;
+#ifdef VPP_POSE_MATH_AVX
+		i += detail::fromArrays<detail::AVX>(in, d, n);
+#endif
+#ifdef VPP_POSE_MATH_SSE
+		DisplacementArrays rest = {in.x + i, in.y + i, in.z + i, in.qx + i, in.qy + i, in.qz + i, in.qw + i};
+		i += detail::fromArrays<detail::SSE>(rest, d + i * 7, n - i);
+#endif
+		for (; i < n; ++i) {
+			float * p = d + i * 7;
+			p[0] = in.x[i];
+			p[1] = in.y[i];
+			p[2] = in.z[i];
+			p[3] = in.qx[i];
+			p[4] = in.qy[i];
+			p[5] = in.qz[i];
+			p[6] = in.qw[i];
+		}
+	}
+
+	/// @brief Composes @a frame with each of @a n poses: out[k] is
+	/// compose(frame, poses[k]), e.g. many tools' poses in the world frame.
+	inline void compose(const float * frame, DisplacementArrays poses, DisplacementArrays out, std::size_t n) {
+		detail::BroadcastPose a = {frame};
+		detail::ArrayPoses b = {poses};
+		detail::composeBatch(a, b, out, n);
+	}
+
+	/// @brief Composes each of @a n poses with @a frame: out[k] is
+	/// compose(poses[k], frame), e.g. with a catch frame.
+	inline void compose(DisplacementArrays poses, const float * frame, DisplacementArrays out, std::size_t n) {
+		detail::ArrayPoses a = {poses};
+		detail::BroadcastPose b = {frame};
+		detail::composeBatch(a, b, out, n);
+	}
+
+	/// @brief out[k] is compose(a[k], b[k]) for each of @a n poses.
+	inline void compose(DisplacementArrays a, DisplacementArrays b, DisplacementArrays out, std::size_t n) {
+		detail::ArrayPoses pa = {a}, pb = {b};
+		detail::composeBatch(pa, pb, out, n);
+	}
+
+	/// @brief out[k] is invert(poses[k]) for each of @a n poses.
+	inline void invert(DisplacementArrays poses, DisplacementArrays out, std::size_t n) {
+		detail::InvertBatch k = {{poses}, {out}};
+		detail::runBatch(k, n);
+	}
+} // end of namespace vpp_pose
+
+#endif // INCLUDED_vpp_pose_math_h_GUID_d3a61f07_84e2_4c5b_9a1d_6e0f2b7c8d94
@@ -0,0 +1,490 @@
+/**
+	@file
+	@brief Backend for BasicVirtuose replaying a session recorded by
+	VirtuoseTrajectoryRecorder, so force-rendering code can be run and
+	profiled without a device, on the same input every time.
+
+	Requires C++11 and POSIX (mmap).
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_replay_backend_h_GUID_5b2e8f14_9c3a_4d71_8e60_a4f7c2d91b38
+#define INCLUDED_vpp_replay_backend_h_GUID_5b2e8f14_9c3a_4d71_8e60_a4f7c2d91b38
+
+// Internal Includes
+#include "vpp-trajectory-recorder.h"
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** @brief A recorded session being replayed: the state the replay
+	backend reports, and the periodic function it drives.
+
+	Each tick makes the next record current, then calls the periodic
+	function, whose reads (getPosition(), getButton(),
+	getTimeLastUpdate()...) return that record's values. After the
+	periodic function returns, the force it last set is folded into
+	forceDigest() and, if recordTo() was called, written with the tick's
+	state to a new trajectory file, so runs can be compared.
+
+	Before the first tick, the first record is current.
+*/
+class VirtuoseReplaySession {
+	public:
+		typedef void (*PeriodicFunction)(VirtContext, void *);
+
+		enum Pacing {
+			/// Ticks follow the timestamps of the recording.
+			RecordedRate,
+			/// Ticks follow each other immediately.
+			AsFastAsPossible
+		};
+
+		/// @throws std::runtime_error if @a path isn't a trajectory file
+		/// of VirtuoseTrajectorySample records.
+		explicit VirtuoseReplaySession(std::string const& path);
+
+		~VirtuoseReplaySession() {
+			stop();
+		}
+
+		/// @brief Number of records in the recording.
+		uint64_t size() const {
+			return reader_.size();
+		}
+
+		/// @brief Number of ticks played so far.
+		uint64_t ticks() const {
+			return ticks_.load(std::memory_order_acquire);
+		}
+
+		/// @brief Whether every record has been played.
+		bool finished() const {
+			return ticks() == size();
+		}
+
+		VirtuoseTrajectoryFileHeader const& header() const {
+			return reader_.header();
+		}
+
+		/// @brief The record the device state is read from.
+		VirtuoseTrajectorySample const& current() const {
+			return current_;
+		}
+
+		void setPacing(Pacing pacing) {
+			pacing_ = pacing;
+		}
+
+		void setPeriodicFunction(PeriodicFunction fn, void * arg) {
+			fn_ = fn;
+			arg_ = arg;
+		}
+
+		/** @brief Plays the remaining records on the calling thread,
+			calling the periodic function once per record, and returns
+			the number of ticks played. Stops early if stop() is called
+			from another thread.
+		*/
+		uint64_t run() {
+			stopping_.store(false, std::memory_order_relaxed);
+			return _play();
+		}
+
+		/// @brief Calls run() on a new thread, as startLoop() does.
+		void start();
+
+		/** @brief Stops playing, and waits for the thread started by
+			start(). run() and start() play again from where it stopped.
+
+			May be called from the periodic function: playing then stops
+			after that tick, without waiting for the thread it runs on.
+		*/
+		void stop();
+
+		/// @brief Waits until the thread started by start() has played
+		/// every record, or was stopped. Returns at once if called from
+		/// that thread.
+		void wait() {
+			if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+				thread_.join();
+			}
+		}
+
+		/// @brief Stops playing and goes back to before the first tick,
+		/// clearing the digest and tick times and finishing the file
+		/// started by recordTo(), if any.
+		void rewind();
+
+		/** @brief Writes each tick played from now on (its state and the
+			force set during it) to a new trajectory file at @a path.
+			@throws std::runtime_error if the file can't be created.
+		*/
+		void recordTo(std::string const& path) {
+			output_.reset(new VirtuoseTrajectoryRecorder(path, size(), header().timeStep));
+			output_->setAPIVersion(header().apiMajor, header().apiMinor);
+		}
+
+		/// @brief Finishes the file started by recordTo().
+		void stopRecording() {
+			output_.reset();
+		}
+
+		/// @brief Last force set by the periodic function.
+		VirtuoseWrench const& force() const {
+			return force_;
+		}
+
+		void setForce(const float * force) {
+			std::memcpy(force_.data, force, sizeof(force_.data));
+		}
+
+		/** @brief FNV-1a hash of the force set at the end of each tick
+			played: two runs of deterministic code over the same
+			recording give the same digest.
+		*/
+		uint64_t forceDigest() const {
+			return digest_;
+		}
+
+		/// @brief Time spent in the periodic function for each tick
+		/// played, in seconds.
+		std::vector<double> const& tickTimes() const {
+			return tickTimes_;
+		}
+
+		float timeStep() const {
+			return timeStep_;
+		}
+
+		/// @brief Reported by getTimeStep(); the pacing still follows
+		/// the recording.
+		void setTimeStep(float step) {
+			timeStep_ = step;
+		}
+
+		/// @brief Error of the last call that failed, VIRT_E_NO_ERROR if none.
+		int lastError;
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseReplaySession(VirtuoseReplaySession const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseReplaySession & operator=(VirtuoseReplaySession const&);
+
+		void _fold(VirtuoseWrench const& force) {
+			unsigned char bytes[sizeof(force.data)];
+			std::memcpy(bytes, force.data, sizeof(bytes));
+			for (std::size_t i = 0; i < sizeof(bytes); ++i) {
+				digest_ = (digest_ ^ bytes[i]) * 1099511628211ull;
+			}
+		}
+
+		uint64_t _play();
+
+		VirtuoseTrajectoryReader reader_;
+		VirtuoseTrajectorySample current_;
+		VirtuoseWrench force_;
+		Pacing pacing_;
+		float timeStep_;
+		PeriodicFunction fn_;
+		void * arg_;
+		std::atomic<uint64_t> ticks_;
+		std::atomic<bool> stopping_;
+		uint64_t digest_;
+		std::vector<double> tickTimes_;
+		std::unique_ptr<VirtuoseTrajectoryRecorder> output_;
+		std::thread thread_;
+};
+
+/** @brief Backend for BasicVirtuose that replays a recording: the name
+	passed to virtOpen() is the path of a trajectory file, and the
+	VirtContext is the VirtuoseReplaySession playing it.
+
+	It has the calls a servo loop makes (state getters, setForce(),
+	time step, periodic function and loop) and accepts, doing nothing,
+	the usual setup calls (command type, indexing mode, factors, frames,
+	power). Other methods of BasicVirtuose don't compile with it.
+
+	The periodic function gets the replay's VirtContext, so it has to
+	use it through a VirtuoseReplay (or a BasicVirtuoseRef of this
+	backend), not a Virtuose: the templated overloads of
+	setPeriodicFunction() taking a callable do that for you.
+
+	@code
+	VirtuoseReplay vpp("session.vtraj");
+	MyServo servo; // void operator()(VirtuoseReplay & vpp)
+	float period = 0.00025f;
+	vpp.setPeriodicFunction(servo, &period);
+	VirtuoseReplaySession & replay = VirtuoseReplayBackend::session(vpp.getVirtContext());
+	replay.setPacing(VirtuoseReplaySession::AsFastAsPossible);
+	replay.run();
+	std::printf("%llx\n", (unsigned long long) replay.forceDigest());
+	@endcode
+*/
+struct VirtuoseReplayBackend {
+	static VirtuoseReplaySession & session(VirtContext vc) {
+		return *static_cast<VirtuoseReplaySession *>(vc);
+	}
+
+	static VirtContext virtOpen(const char * path) {
+		try {
+			return new VirtuoseReplaySession(path);
+		} catch (std::runtime_error &) {
+			_openError() = VIRT_E_FILE_NOT_FOUND;
+			return NULL;
+		}
+	}
+
+	static int virtClose(VirtContext vc) {
+		delete &session(vc);
+		return 0;
+	}
+
+	static int virtGetErrorCode(VirtContext vc) {
+		if (!vc) {
+			return _openError();
+		}
+		int error = session(vc).lastError;
+		session(vc).lastError = VIRT_E_NO_ERROR;
+		return error;
+	}
+
+	static char * virtGetErrorMessage(int code) {
+		const char * msg;
+		switch (code) {
+			case VIRT_E_NO_ERROR:
+				msg = "No error";
+				break;
+			case VIRT_E_FILE_NOT_FOUND:
+				msg = "Could not open the recording to replay";
+				break;
+			case VIRT_E_INCORRECT_VALUE:
+				msg = "Incorrect value";
+				break;
+			case VIRT_E_PERIODIC_FUNCTION:
+				msg = "No periodic function set";
+				break;
+			default:
+				msg = "Replay error";
+		}
+		return const_cast<char *>(msg);
+	}
+
+	static int virtGetPosition(VirtContext vc, float * pos) {
+		std::memcpy(pos, session(vc).current().position.data, sizeof(float) * VirtuoseDisplacement::size);
+		return 0;
+	}
+
+	static int virtGetSpeed(VirtContext vc, float * speed) {
+		std::memcpy(speed, session(vc).current().speed.data, sizeof(float) * VirtuoseTwist::size);
+		return 0;
+	}
+
+	static int virtGetButton(VirtContext vc, int button_number, int * state) {
+		if (button_number < 0 || button_number >= 32) {
+			return _fail(vc, VIRT_E_INCORRECT_VALUE);
+		}
+		*state = (session(vc).current().buttons >> button_number) & 1u;
+		return 0;
+	}
+
+	static int virtGetDeadMan(VirtContext vc, int * dead_man) {
+		*dead_man = session(vc).current().deadMan;
+		return 0;
+	}
+
+	static int virtGetEmergencyStop(VirtContext vc, int * emergency_stop) {
+		*emergency_stop = session(vc).current().emergencyStop;
+		return 0;
+	}
+
+	static int virtGetPowerOn(VirtContext vc, int * power) {
+		*power = session(vc).current().powerOn;
+		return 0;
+	}
+
+	static int virtGetTimeLastUpdate(VirtContext vc, unsigned int * time) {
+		*time = session(vc).current().timeLastUpdate;
+		return 0;
+	}
+
+	static int virtSetForce(VirtContext vc, float * force) {
+		session(vc).setForce(force);
+		return 0;
+	}
+
+	static int virtGetTimeStep(VirtContext vc, float * step) {
+		*step = session(vc).timeStep();
+		return 0;
+	}
+
+	static int virtSetTimeStep(VirtContext vc, float step) {
+		session(vc).setTimeStep(step);
+		return 0;
+	}
+
+	static int virtSetPeriodicFunction(VirtContext vc, void (*fn)(VirtContext, void *), float * period, void * arg) {
+		session(vc).setPeriodicFunction(fn, arg);
+		if (period) {
+			session(vc).setTimeStep(*period);
+		}
+		return 0;
+	}
+
+	/// @brief Starts playing on a new thread.
+	static int virtStartLoop(VirtContext vc) {
+		VirtuoseReplaySession & s = session(vc);
+		try {
+			s.start();
+		} catch (std::logic_error &) {
+			return _fail(vc, VIRT_E_PERIODIC_FUNCTION);
+		}
+		return 0;
+	}
+
+	static int virtStopLoop(VirtContext vc) {
+		session(vc).stop();
+		return 0;
+	}
+
+	/// @name Setup calls, accepted and ignored
+	/// @{
+	static int virtSetCommandType(VirtContext, VirtCommandType) {
+		return 0;
+	}
+	static int virtSetIndexingMode(VirtContext, VirtIndexingType) {
+		return 0;
+	}
+	static int virtSetForceFactor(VirtContext, float) {
+		return 0;
+	}
+	static int virtSetSpeedFactor(VirtContext, float) {
+		return 0;
+	}
+	static int virtSetBaseFrame(VirtContext, float *) {
+		return 0;
+	}
+	static int virtSetObservationFrame(VirtContext, float *) {
+		return 0;
+	}
+	static int virtSetPowerOn(VirtContext, int) {
+		return 0;
+	}
+	static int virtEnableForceFeedback(VirtContext, int) {
+		return 0;
+	}
+	/// @}
+
+	static int _fail(VirtContext vc, int error) {
+		session(vc).lastError = error;
+		return -1;
+	}
+
+	/// @brief Error of this thread's last failed virtOpen().
+	static int & _openError() {
+		static thread_local int error = VIRT_E_NO_ERROR;
+		return error;
+	}
+};
+
+/// @brief Virtuose replaying a recording instead of driving a device.
+typedef BasicVirtuose<VirtuoseReplayBackend> VirtuoseReplay;
+
+inline VirtuoseReplaySession::VirtuoseReplaySession(std::string const& path)
+	: lastError(VIRT_E_NO_ERROR)
+	, reader_(path)
+	, current_()
+	, force_()
+	, pacing_(RecordedRate)
+	, timeStep_(reader_.header().timeStep)
+	, fn_(NULL)
+	, arg_(NULL)
+	, ticks_(0)
+	, stopping_(false)
+	, digest_(14695981039346656037ull) {
+	if (!reader_.hasSampleLayout()) {
+		throw std::runtime_error(path + " does not hold VirtuoseTrajectorySample records");
+	}
+	if (size() > 0) {
+		current_ = reader_.sample(0);
+	}
+}
+
+inline uint64_t VirtuoseReplaySession::_play() {
+	typedef std::chrono::steady_clock Clock;
+	uint64_t first = ticks();
+	uint64_t count = size();
+	if (!fn_ || first == count) {
+		return 0;
+	}
+	tickTimes_.reserve(tickTimes_.size() + (count - first));
+	Clock::time_point start = Clock::now();
+	double startTime = reader_.sample(first).time;
+	uint64_t i = first;
+	for (; i < count && !stopping_.load(std::memory_order_relaxed); ++i) {
+		current_ = reader_.sample(i);
+		if (pacing_ == RecordedRate) {
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(current_.time - startTime)));
+		}
+		Clock::time_point before = Clock::now();
+		fn_(this, arg_);
+		tickTimes_.push_back(std::chrono::duration<double>(Clock::now() - before).count());
+		_fold(force_);
+		if (output_) {
+			VirtuoseTrajectorySample out = current_;
+			out.force = force_;
+			// Waits for the drain thread rather than dropping ticks,
+			// which it would outrun when playing as fast as possible.
+			while (!output_->tryRecord(out)) {
+				std::this_thread::yield();
+			}
+		}
+		ticks_.store(i + 1, std::memory_order_release);
+	}
+	return i - first;
+}
+
+inline void VirtuoseReplaySession::start() {
+	if (!fn_) {
+		throw std::logic_error("No periodic function set");
+	}
+	stop();
+	stopping_.store(false, std::memory_order_relaxed);
+	thread_ = std::thread(&VirtuoseReplaySession::_play, this);
+}
+
+inline void VirtuoseReplaySession::stop() {
+	stopping_.store(true, std::memory_order_relaxed);
+	wait();
+}
+
+inline void VirtuoseReplaySession::rewind() {
+	stop();
+	stopRecording();
+	ticks_.store(0, std::memory_order_release);
+	if (size() > 0) {
+		current_ = reader_.sample(0);
+	}
+	force_ = VirtuoseWrench();
+	digest_ = 14695981039346656037ull;
+	tickTimes_.clear();
+}
+
+#endif // INCLUDED_vpp_replay_backend_h_GUID_5b2e8f14_9c3a_4d71_8e60_a4f7c2d91b38
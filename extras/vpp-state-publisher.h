@@ -0,0 +1,136 @@
+/**
+	@file
+	@brief Wait-free publication of device state from the servo thread
+	to any number of reader threads.
+
+	Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_state_publisher_h_GUID_3e9a7c12_6b4d_4f8e_a1c5_0f2d9b8e7a61
+#define INCLUDED_vpp_state_publisher_h_GUID_3e9a7c12_6b4d_4f8e_a1c5_0f2d9b8e7a61
+
+// Internal Includes
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
+/** @brief Sequence-lock ("seqlock") holding the latest value of a
+	trivially-copyable type T, written by one thread and read by any
+	number of others.
+
+	publish() never blocks or waits on readers, so it is safe to call
+	from the periodic function registered with
+	Virtuose::setPeriodicFunction. Readers copy the value and retry if
+	the writer updated it meanwhile, so they never see a torn value and
+	never slow down the writer (they only share its cache lines).
+
+	Only one thread may publish to a given instance. The object is
+	aligned to a cache line so it doesn't share one with unrelated data.
+
+	Typical use:
+	@code
+	VirtuoseStatePublisher<> latest;
+
+	void servoTick(VirtContext vc, void *) {
+		VirtuoseRef vpp(vc);
+		latest.publish(vpp.readState());
+		// ...
+	}
+
+	// in the render thread
+	VirtuoseState s = latest.read();
+	@endcode
+*/
+template<typename T = VirtuoseState>
+class alignas(64) VirtuoseStatePublisher {
+		static_assert(std::is_trivially_copyable<T>::value, "VirtuoseStatePublisher needs a trivially-copyable type");
+	public:
+		typedef T value_type;
+
+		VirtuoseStatePublisher() : sequence_(0) {
+			for (std::size_t i = 0; i < wordCount; ++i) {
+				words_[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief Makes @a value the latest value. Writer thread only.
+		void publish(T const& value) {
+			uint64_t buf[wordCount];
+			buf[wordCount - 1] = 0;
+			std::memcpy(buf, &value, sizeof(T));
+
+			unsigned int seq = sequence_.load(std::memory_order_relaxed);
+			// Odd sequence: write in progress.
+			sequence_.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (std::size_t i = 0; i < wordCount; ++i) {
+				words_[i].store(buf[i], std::memory_order_relaxed);
+			}
+			sequence_.store(seq + 2, std::memory_order_release);
+		}
+
+		/** @brief Attempts a single consistent read.
+
+			@returns false if nothing was published yet, or if a publish
+			happened during the copy (in which case @a value is unchanged).
+		*/
+		bool tryRead(T & value) const {
+			unsigned int before = sequence_.load(std::memory_order_acquire);
+			if (before == 0 || (before & 1u)) {
+				return false;
+			}
+			uint64_t buf[wordCount];
+			for (std::size_t i = 0; i < wordCount; ++i) {
+				buf[i] = words_[i].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (sequence_.load(std::memory_order_relaxed) != before) {
+				return false;
+			}
+			std::memcpy(&value, buf, sizeof(T));
+			return true;
+		}
+
+		/** @brief Returns the latest published value, retrying until a
+			consistent copy is obtained.
+
+			Must not be called before the first publish().
+		*/
+		T read() const {
+			T ret;
+			while (!tryRead(ret)) {
+			}
+			return ret;
+		}
+
+		/// @brief Number of publish() calls so far.
+		unsigned int publishCount() const {
+			return sequence_.load(std::memory_order_acquire) / 2;
+		}
+
+	private:
+		enum { wordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t) };
+
+		/// @brief Copy constructor forbidden
+		VirtuoseStatePublisher(VirtuoseStatePublisher const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseStatePublisher & operator=(VirtuoseStatePublisher const&);
+
+		std::atomic<unsigned int> sequence_;
+		std::atomic<uint64_t> words_[wordCount];
+};
+
+#endif // INCLUDED_vpp_state_publisher_h_GUID_3e9a7c12_6b4d_4f8e_a1c5_0f2d9b8e7a61
@@ -0,0 +1,397 @@
+/**
+	@file
+	@brief Measures how long each tick of the periodic function takes
+	against the device's time step, and optionally steps the servo rate
+	down under sustained overload and back up once it's over.
+
+	Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_timing_controller_h_GUID_4d7a2e90_b61c_4f38_a5d2_8c0e9b3f1a67
+#define INCLUDED_vpp_timing_controller_h_GUID_4d7a2e90_b61c_4f38_a5d2_8c0e9b3f1a67
+
+// Internal Includes
+#include <vpp.h>
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+/// @brief When a VirtuoseTimingController changes the time step.
+struct VirtuoseTimingOptions {
+	/** Shortest (fastest) time step allowed, in seconds, or 0 for the
+		device's time step when the controller starts.
+	*/
+	double minStep;
+	/** Longest (slowest) time step allowed, in seconds, or 0 for
+		minStep: the rate is then never changed.
+	*/
+	double maxStep;
+	/// Ticks over which load is judged.
+	unsigned int windowTicks;
+	/// A window is overloaded when more than this fraction of its ticks overran.
+	double overloadFraction;
+	/// A window is underloaded when no tick took more than this fraction of the step.
+	double underloadUtilization;
+	/// Overloaded windows in a row before doubling the step.
+	unsigned int overloadWindows;
+	/// Underloaded windows in a row before halving it.
+	unsigned int recoverWindows;
+
+	VirtuoseTimingOptions(double minStep_ = 0., double maxStep_ = 0.)
+		: minStep(minStep_)
+		, maxStep(maxStep_)
+		, windowTicks(250)
+		, overloadFraction(0.02)
+		, underloadUtilization(0.35)
+		, overloadWindows(2)
+		, recoverWindows(8) {}
+};
+
+/// @brief Counters of a VirtuoseTimingController, readable from any thread.
+struct VirtuoseTimingStats {
+	/// Current time step, in nanoseconds.
+	int64_t stepNs;
+	/// Time step the load calls for: adapt() switches to it.
+	int64_t recommendedStepNs;
+	uint64_t ticks;
+	/// Ticks whose periodic function took longer than the step.
+	uint64_t overruns;
+	uint64_t consecutiveOverruns;
+	uint64_t maxConsecutiveOverruns;
+	/// Ticks starting more than 1.5 steps after the previous one.
+	uint64_t lateTicks;
+	/// Device updates missed, from the gaps in getTimeLastUpdate().
+	uint64_t missedUpdates;
+	int64_t lastComputeNs;
+	int64_t maxComputeNs;
+	/// Total time spent in the periodic function.
+	int64_t totalComputeNs;
+	/// Times adapt() changed the step.
+	uint64_t rateChanges;
+	/// Steps the device refused in setTimeStep().
+	uint64_t rejectedSteps;
+};
+
+/** @brief Wraps a periodic function (any callable taking the device it
+	was started on) to measure each tick's compute time against the time
+	step, and track overruns, late ticks and, from getTimeLastUpdate()
+	(in microseconds), device updates missed.
+
+	With a range of time steps in the VirtuoseTimingOptions, it also
+	judges the load over windows of ticks: after a few overloaded windows
+	in a row, it recommends twice the step; after more underloaded ones,
+	half, within the range. The servo thread only updates counters;
+	adapt(), called from another thread, applies a recommended step by
+	stopping the loop, calling setTimeStep() and restarting it. A step
+	the device refuses narrows the range instead.
+
+	@code
+	Servo servo;
+	VirtuoseTimingController<Servo> timed(servo, VirtuoseTimingOptions(0.001, 0.004));
+	timed.start(vpp);
+	while (running) {
+		sleep(100 ms);
+		timed.adapt(vpp);
+		publishMetrics(timed.stats());
+	}
+	timed.stop(vpp);
+	@endcode
+*/
+template<typename F>
+class VirtuoseTimingController {
+	public:
+		/// @param servo The periodic function, which must outlive the loop.
+		explicit VirtuoseTimingController(F & servo, VirtuoseTimingOptions const& options = VirtuoseTimingOptions())
+			: servo_(servo)
+			, options_(options)
+			, period_(0.f)
+			, device_(NULL) {
+			stepNs_.store(0, std::memory_order_relaxed);
+			recommendedStepNs_.store(0, std::memory_order_relaxed);
+			minStepNs_.store(0, std::memory_order_relaxed);
+			maxStepNs_.store(0, std::memory_order_relaxed);
+			resetStats();
+			_resetTracking();
+		}
+
+		/** @brief Registers the controller as @a vpp's periodic function,
+			at the device's time step (brought within the options' range),
+			and starts the loop.
+		*/
+		template<typename Device>
+		VirtuoseResult start(Device & vpp) {
+			float step;
+			VirtuoseResult result = vpp.tryGetTimeStep(&step);
+			if (!result.ok()) {
+				return result;
+			}
+			int64_t deviceNs = _toNs(step);
+			int64_t minNs = options_.minStep > 0. ? _toNs(options_.minStep) : deviceNs;
+			int64_t maxNs = std::max(minNs, options_.maxStep > 0. ? _toNs(options_.maxStep) : minNs);
+			minStepNs_.store(minNs, std::memory_order_relaxed);
+			maxStepNs_.store(maxNs, std::memory_order_relaxed);
+			int64_t stepNs = std::min(std::max(deviceNs, minNs), maxNs);
+			if (stepNs != deviceNs) {
+				result = vpp.trySetTimeStep(_toSeconds(stepNs));
+				if (!result.ok()) {
+					return result;
+				}
+			}
+			return _startLoop(vpp, stepNs);
+		}
+
+		template<typename Device>
+		VirtuoseResult stop(Device & vpp) {
+			return vpp.tryStopLoop();
+		}
+
+		/** @brief Switches to the recommended time step, if it differs from
+			the current one. Not from the periodic function.
+
+			@param changed Set to whether the step changed, if not null.
+		*/
+		template<typename Device>
+		VirtuoseResult adapt(Device & vpp, bool * changed = NULL) {
+			VirtuoseResult result = {0, VIRT_E_NO_ERROR};
+			int64_t current = stepNs_.load(std::memory_order_relaxed);
+			int64_t target = recommendedStepNs_.load(std::memory_order_relaxed);
+			if (changed) {
+				*changed = false;
+			}
+			if (target == current) {
+				return result;
+			}
+			result = vpp.tryStopLoop();
+			if (!result.ok()) {
+				return result;
+			}
+			if (vpp.trySetTimeStep(_toSeconds(target)).ok()) {
+				rateChanges_.store(rateChanges_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				if (changed) {
+					*changed = true;
+				}
+			} else {
+				// Not a legal step for this device: don't go that far again.
+				rejectedSteps_.store(rejectedSteps_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				(target > current ? maxStepNs_ : minStepNs_).store(current, std::memory_order_relaxed);
+				target = current;
+				vpp.trySetTimeStep(_toSeconds(current));
+			}
+			return _startLoop(vpp, target);
+		}
+
+		/** @brief Runs one tick: called by the VirtuoseAPI's loop once
+			started, or directly to drive the controller from another
+			periodic function.
+		*/
+		template<typename Device>
+		void operator()(Device & vpp) {
+			int64_t begin = _nowNs();
+			unsigned int update;
+			bool haveUpdate = vpp.tryGetTimeLastUpdate(&update).ok();
+			servo_(vpp);
+			_record(begin, _nowNs(), haveUpdate, update);
+		}
+
+		VirtuoseTimingStats stats() const {
+			VirtuoseTimingStats ret;
+			ret.stepNs = stepNs_.load(std::memory_order_relaxed);
+			ret.recommendedStepNs = recommendedStepNs_.load(std::memory_order_relaxed);
+			ret.ticks = ticks_.load(std::memory_order_relaxed);
+			ret.overruns = overruns_.load(std::memory_order_relaxed);
+			ret.consecutiveOverruns = consecutiveOverruns_.load(std::memory_order_relaxed);
+			ret.maxConsecutiveOverruns = maxConsecutiveOverruns_.load(std::memory_order_relaxed);
+			ret.lateTicks = lateTicks_.load(std::memory_order_relaxed);
+			ret.missedUpdates = missedUpdates_.load(std::memory_order_relaxed);
+			ret.lastComputeNs = lastComputeNs_.load(std::memory_order_relaxed);
+			ret.maxComputeNs = maxComputeNs_.load(std::memory_order_relaxed);
+			ret.totalComputeNs = totalComputeNs_.load(std::memory_order_relaxed);
+			ret.rateChanges = rateChanges_.load(std::memory_order_relaxed);
+			ret.rejectedSteps = rejectedSteps_.load(std::memory_order_relaxed);
+			return ret;
+		}
+
+		/// @brief Zeroes the counters. Not while the loop runs.
+		void resetStats() {
+			ticks_.store(0, std::memory_order_relaxed);
+			overruns_.store(0, std::memory_order_relaxed);
+			consecutiveOverruns_.store(0, std::memory_order_relaxed);
+			maxConsecutiveOverruns_.store(0, std::memory_order_relaxed);
+			lateTicks_.store(0, std::memory_order_relaxed);
+			missedUpdates_.store(0, std::memory_order_relaxed);
+			lastComputeNs_.store(0, std::memory_order_relaxed);
+			maxComputeNs_.store(0, std::memory_order_relaxed);
+			totalComputeNs_.store(0, std::memory_order_relaxed);
+			rateChanges_.store(0, std::memory_order_relaxed);
+			rejectedSteps_.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		static int64_t _nowNs() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static int64_t _toNs(double seconds) {
+			return static_cast<int64_t>(seconds * 1e9 + 0.5);
+		}
+
+		static float _toSeconds(int64_t ns) {
+			return static_cast<float>(ns * 1e-9);
+		}
+
+		template<typename Device>
+		VirtuoseResult _startLoop(Device & vpp, int64_t stepNs) {
+			stepNs_.store(stepNs, std::memory_order_relaxed);
+			recommendedStepNs_.store(stepNs, std::memory_order_relaxed);
+			_resetTracking();
+			period_ = _toSeconds(stepNs);
+			device_ = &vpp;
+			VirtuoseResult result = vpp.trySetPeriodicFunction(&VirtuoseTimingController::_tick<Device>, &period_, this);
+			if (!result.ok()) {
+				return result;
+			}
+			return vpp.tryStartLoop();
+		}
+
+		template<typename Device>
+		static void _tick(VirtContext, void * arg) {
+			VirtuoseTimingController & self = *static_cast<VirtuoseTimingController *>(arg);
+			self(*static_cast<Device *>(self.device_));
+		}
+
+		/// @brief Forgets the previous tick and the current window; only
+		/// while the loop is stopped.
+		void _resetTracking() {
+			havePrevious_ = false;
+			haveUpdate_ = false;
+			windowTicks_ = 0;
+			windowOverruns_ = 0;
+			windowMaxComputeNs_ = 0;
+			overloadedWindows_ = 0;
+			underloadedWindows_ = 0;
+		}
+
+		/// Counters only have one writer (the servo thread): no
+		/// read-modify-write needed.
+		static void _add(std::atomic<uint64_t> & counter, uint64_t n) {
+			counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+
+		void _record(int64_t begin, int64_t end, bool haveUpdate, unsigned int update) {
+			int64_t stepNs = stepNs_.load(std::memory_order_relaxed);
+			int64_t compute = end - begin;
+			_add(ticks_, 1);
+			lastComputeNs_.store(compute, std::memory_order_relaxed);
+			totalComputeNs_.store(totalComputeNs_.load(std::memory_order_relaxed) + compute, std::memory_order_relaxed);
+			if (compute > maxComputeNs_.load(std::memory_order_relaxed)) {
+				maxComputeNs_.store(compute, std::memory_order_relaxed);
+			}
+			if (compute > stepNs) {
+				_add(overruns_, 1);
+				_add(consecutiveOverruns_, 1);
+				uint64_t run = consecutiveOverruns_.load(std::memory_order_relaxed);
+				if (run > maxConsecutiveOverruns_.load(std::memory_order_relaxed)) {
+					maxConsecutiveOverruns_.store(run, std::memory_order_relaxed);
+				}
+				++windowOverruns_;
+			} else {
+				consecutiveOverruns_.store(0, std::memory_order_relaxed);
+			}
+
+			if (havePrevious_ && (begin - previousBeginNs_) * 2 > stepNs * 3) {
+				_add(lateTicks_, 1);
+			}
+			if (haveUpdate && haveUpdate_ && stepNs > 0) {
+				// Unsigned difference: right across the counter wrapping around.
+				int64_t gapNs = static_cast<int64_t>(update - previousUpdate_) * 1000;
+				if (gapNs * 2 > stepNs * 3) {
+					_add(missedUpdates_, static_cast<uint64_t>((gapNs + stepNs / 2) / stepNs - 1));
+				}
+			}
+			havePrevious_ = true;
+			previousBeginNs_ = begin;
+			haveUpdate_ = haveUpdate;
+			previousUpdate_ = update;
+
+			windowMaxComputeNs_ = std::max(windowMaxComputeNs_, compute);
+			if (++windowTicks_ == options_.windowTicks) {
+				_judgeWindow(stepNs);
+			}
+		}
+
+		void _judgeWindow(int64_t stepNs) {
+			if (windowOverruns_ > options_.overloadFraction * windowTicks_) {
+				++overloadedWindows_;
+				underloadedWindows_ = 0;
+			} else if (windowMaxComputeNs_ < options_.underloadUtilization * stepNs) {
+				++underloadedWindows_;
+				overloadedWindows_ = 0;
+			} else {
+				overloadedWindows_ = 0;
+				underloadedWindows_ = 0;
+			}
+			int64_t recommended = stepNs;
+			if (overloadedWindows_ >= options_.overloadWindows) {
+				recommended = std::min(stepNs * 2, maxStepNs_.load(std::memory_order_relaxed));
+			} else if (underloadedWindows_ >= options_.recoverWindows) {
+				recommended = std::max(stepNs / 2, minStepNs_.load(std::memory_order_relaxed));
+			}
+			recommendedStepNs_.store(recommended, std::memory_order_relaxed);
+			windowTicks_ = 0;
+			windowOverruns_ = 0;
+			windowMaxComputeNs_ = 0;
+		}
+
+		F & servo_;
+		VirtuoseTimingOptions const options_;
+		float period_;
+		/// The device start() registered the controller with.
+		void * device_;
+
+		std::atomic<int64_t> stepNs_;
+		std::atomic<int64_t> recommendedStepNs_;
+		std::atomic<int64_t> minStepNs_;
+		std::atomic<int64_t> maxStepNs_;
+
+		std::atomic<uint64_t> ticks_;
+		std::atomic<uint64_t> overruns_;
+		std::atomic<uint64_t> consecutiveOverruns_;
+		std::atomic<uint64_t> maxConsecutiveOverruns_;
+		std::atomic<uint64_t> lateTicks_;
+		std::atomic<uint64_t> missedUpdates_;
+		std::atomic<int64_t> lastComputeNs_;
+		std::atomic<int64_t> maxComputeNs_;
+		std::atomic<int64_t> totalComputeNs_;
+		std::atomic<uint64_t> rateChanges_;
+		std::atomic<uint64_t> rejectedSteps_;
+
+		// Servo thread only.
+		bool havePrevious_;
+		int64_t previousBeginNs_;
+		bool haveUpdate_;
+		unsigned int previousUpdate_;
+		unsigned int windowTicks_;
+		unsigned int windowOverruns_;
+		int64_t windowMaxComputeNs_;
+		unsigned int overloadedWindows_;
+		unsigned int underloadedWindows_;
+
+		/// @brief Copy constructor forbidden
+		VirtuoseTimingController(VirtuoseTimingController const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseTimingController & operator=(VirtuoseTimingController const&);
+};
+
+#endif // INCLUDED_vpp_timing_controller_h_GUID_4d7a2e90_b61c_4f38_a5d2_8c0e9b3f1a67
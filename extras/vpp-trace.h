@@ -0,0 +1,399 @@
+/**
+	@file
+	@brief Writes the wrapped VirtuoseAPI calls and periodic function
+	ticks, and the application's own events, to a Chrome Trace Event
+	JSON file, to look at the servo loop next to other threads in a trace
+	viewer (chrome://tracing, ui.perfetto.dev).
+
+	Needs VPP_TRACE defined for every file including vpp.h. Each thread
+	queues its events in its own lock-free ring; a background thread
+	drains the rings into the file.
+
+	Requires C++11 and POSIX.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_trace_h_GUID_3e9b7d52_c4a1_4f68_9d20_5b8e1f7a6c39
+#define INCLUDED_vpp_trace_h_GUID_3e9b7d52_c4a1_4f68_9d20_5b8e1f7a6c39
+
+// Internal Includes
+#include <vpp.h>
+#include "vpp-trajectory-recorder.h"
+
+// Library/third-party includes
+#include <unistd.h>
+
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef VPP_TRACE
+#	error "Define VPP_TRACE for every file including vpp.h to use vpp-trace.h"
+#endif
+
+/** @brief Events each thread can queue before the next flush; past
+	that, its events are dropped (and counted as such). Define before
+	including this header to change it.
+*/
+#ifndef VPP_TRACE_BUFFER_EVENTS
+#	define VPP_TRACE_BUFFER_EVENTS 8192
+#endif
+
+/// @brief One queued event: a span of time on the thread queuing it.
+struct VirtuoseTraceEvent {
+	/// Must outlive the VirtuoseTraceWriter: a string literal, say.
+	const char * name;
+	const char * category;
+	int64_t beginNs;
+	int64_t endNs;
+};
+
+/** @brief Writes a Chrome Trace Event JSON file of everything traced
+	while it's open: the wrapped calls (category "virtuose"), ticks of
+	periodic functions set through BasicVirtuose::setPeriodicFunction()
+	(named periodicTick), and the events other threads queue with
+	event() or VirtuoseTraceScope.
+
+	@code
+	VirtuoseTraceWriter trace("servo.json");
+	VirtuoseTraceWriter::nameThread("render");
+	while (rendering) {
+		VirtuoseTraceScope frame("frame");
+		draw();
+	}
+	@endcode
+
+	Queuing an event takes no lock and never blocks: it fails and counts
+	the event as dropped if the thread's ring is full. A thread's first
+	event allocates its ring, under a lock: call nameThread() first to
+	keep that out of a servo tick. A thread that exits hands its ring,
+	and its track in the trace, to the next thread to queue an event.
+
+	Only one writer may be open at a time.
+*/
+class VirtuoseTraceWriter {
+	public:
+		/** @brief Creates (or replaces) the file at @a path, starts the
+			background thread and starts tracing.
+
+			@param path File to write.
+			@param flushInterval Seconds between two flushes.
+			@throws std::runtime_error if the file can't be created or
+			another writer is open.
+		*/
+		explicit VirtuoseTraceWriter(std::string const& path, double flushInterval = 0.05);
+
+		/// @brief Stops tracing.
+		~VirtuoseTraceWriter() {
+			close();
+		}
+
+		/** @brief Stops tracing, writes the remaining events and the
+			threads' names, stops the background thread and closes the
+			file. Called by the destructor.
+		*/
+		void close();
+
+		/// @brief Events written to the file so far.
+		uint64_t written() const {
+			return written_.load(std::memory_order_acquire);
+		}
+
+		/// @brief Events dropped so far because a thread's ring was full.
+		static uint64_t dropped();
+
+		/// @brief Time to give event(), on the clock vpp_trace uses.
+		static int64_t nowNs() {
+			return ::vpp_trace::nowNs();
+		}
+
+		/// @brief Queues an event of the calling thread, if a writer is
+		/// open. @a name and @a category must outlive the writer.
+		static void event(const char * name, int64_t beginNs, int64_t endNs, const char * category = "app") {
+			if (_registry().active.load(std::memory_order_relaxed)) {
+				_push(name, category, beginNs, endNs);
+			}
+		}
+
+		/// @brief Names the calling thread's track in the trace (and
+		/// allocates its ring if needed). @a name is copied.
+		static void nameThread(std::string const& name);
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseTraceWriter(VirtuoseTraceWriter const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseTraceWriter & operator=(VirtuoseTraceWriter const&);
+
+		/// @brief A thread's ring, kept for the next thread when it exits.
+		struct Buffer {
+			explicit Buffer(int id) : ring(VPP_TRACE_BUFFER_EVENTS), dropped(0), owned(true), tid(id) {}
+			VirtuoseSampleRing<VirtuoseTraceEvent> ring;
+			std::atomic<uint64_t> dropped;
+			std::atomic<bool> owned;
+			int const tid;
+			/// Guarded by Registry::mutex.
+			std::string name;
+		};
+
+		/// @brief Every ring, and whether a writer is open.
+		struct Registry {
+			Registry() : active(false) {}
+			std::mutex mutex;
+			std::vector<Buffer *> buffers;
+			std::atomic<bool> active;
+		};
+
+		/// @brief Releases the thread's ring when the thread exits.
+		struct ThreadBuffer {
+			ThreadBuffer() : buffer(NULL) {}
+			~ThreadBuffer() {
+				if (buffer) {
+					buffer->owned.store(false, std::memory_order_release);
+				}
+			}
+			Buffer * buffer;
+		};
+
+		/// @brief Never freed, nor its rings: threads may still be
+		/// queuing events at exit.
+		static Registry & _registry() {
+			static Registry * r = new Registry;
+			return *r;
+		}
+
+		static Buffer * _acquire();
+
+		static Buffer * _threadBuffer() {
+			static thread_local ThreadBuffer mine;
+			if (!mine.buffer) {
+				mine.buffer = _acquire();
+			}
+			return mine.buffer;
+		}
+
+		static void _push(const char * name, const char * category, int64_t beginNs, int64_t endNs) {
+			Buffer * b = _threadBuffer();
+			VirtuoseTraceEvent e = {name, category, beginNs, endNs};
+			if (!b->ring.push(e)) {
+				b->dropped.store(b->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief The vpp_trace::Sink installed while a writer is open.
+		static void _sink(int method, int64_t beginNs, int64_t endNs) {
+			_push(::vpp_profile::methodName(method), "virtuose", beginNs, endNs);
+		}
+
+		static void _appendString(std::string & out, const char * s);
+		void _flush();
+		void _run();
+
+		std::FILE * file_;
+		int pid_;
+		int64_t startNs_;
+		std::chrono::nanoseconds interval_;
+		std::vector<VirtuoseTraceEvent> batch_;
+		std::string text_;
+		bool first_;
+		std::atomic<uint64_t> written_;
+		std::atomic<bool> running_;
+		std::thread thread_;
+};
+
+/** @brief Queues an event spanning its own lifetime, if a writer is open:
+
+	@code
+	{
+		VirtuoseTraceScope step("physics");
+		world.step(dt);
+	}
+	@endcode
+*/
+class VirtuoseTraceScope {
+	public:
+		/// @brief @a name and @a category must outlive the writer.
+		explicit VirtuoseTraceScope(const char * name, const char * category = "app")
+			: name_(name), category_(category), beginNs_(VirtuoseTraceWriter::nowNs()) {}
+
+		~VirtuoseTraceScope() {
+			VirtuoseTraceWriter::event(name_, beginNs_, VirtuoseTraceWriter::nowNs(), category_);
+		}
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseTraceScope(VirtuoseTraceScope const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseTraceScope & operator=(VirtuoseTraceScope const&);
+
+		const char * name_;
+		const char * category_;
+		int64_t beginNs_;
+};
+
+inline VirtuoseTraceWriter::VirtuoseTraceWriter(std::string const& path, double flushInterval)
+	: file_(NULL)
+	, pid_(static_cast<int>(getpid()))
+	, startNs_(0)
+	, interval_(static_cast<int64_t>(flushInterval * 1e9))
+	, batch_(VPP_TRACE_BUFFER_EVENTS)
+	, first_(true)
+	, written_(0)
+	, running_(true) {
+	if (_registry().active.exchange(true)) {
+		throw std::runtime_error("Could not trace to " + path + ": another VirtuoseTraceWriter is open");
+	}
+	file_ = std::fopen(path.c_str(), "w");
+	if (!file_) {
+		int err = errno;
+		_registry().active.store(false);
+		throw std::runtime_error("Could not create " + path + ": " + std::strerror(err));
+	}
+	std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file_);
+	// Drops what's left from an earlier writer: _flush() skips what's
+	// older than the start.
+	startNs_ = nowNs();
+	_flush();
+	::vpp_trace::sink().store(&VirtuoseTraceWriter::_sink, std::memory_order_release);
+	thread_ = std::thread(&VirtuoseTraceWriter::_run, this);
+}
+
+inline uint64_t VirtuoseTraceWriter::dropped() {
+	Registry & r = _registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	uint64_t total = 0;
+	for (std::size_t i = 0; i < r.buffers.size(); ++i) {
+		total += r.buffers[i]->dropped.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+inline void VirtuoseTraceWriter::nameThread(std::string const& name) {
+	Buffer * b = _threadBuffer();
+	std::lock_guard<std::mutex> lock(_registry().mutex);
+	b->name = name;
+}
+
+inline VirtuoseTraceWriter::Buffer * VirtuoseTraceWriter::_acquire() {
+	Registry & r = _registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	for (std::size_t i = 0; i < r.buffers.size(); ++i) {
+		bool owned = false;
+		if (r.buffers[i]->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+			r.buffers[i]->name.clear();
+			return r.buffers[i];
+		}
+	}
+	r.buffers.push_back(new Buffer(static_cast<int>(r.buffers.size()) + 1));
+	return r.buffers.back();
+}
+
+inline void VirtuoseTraceWriter::_appendString(std::string & out, const char * s) {
+	out += '"';
+	for (; *s; ++s) {
+		unsigned char c = static_cast<unsigned char>(*s);
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += *s;
+		} else if (c < 0x20) {
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+			out += escaped;
+		} else {
+			out += *s;
+		}
+	}
+	out += '"';
+}
+
+inline void VirtuoseTraceWriter::_flush() {
+	std::vector<Buffer *> buffers;
+	{
+		std::lock_guard<std::mutex> lock(_registry().mutex);
+		buffers = _registry().buffers;
+	}
+	uint64_t written = written_.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < buffers.size(); ++i) {
+		std::size_t n;
+		while ((n = buffers[i]->ring.pop(&batch_[0], batch_.size())) != 0) {
+			text_.clear();
+			for (std::size_t k = 0; k < n; ++k) {
+				VirtuoseTraceEvent const& e = batch_[k];
+				if (e.beginNs < startNs_) {
+					continue;
+				}
+				// Complete ("X") events, in microseconds since the start.
+				text_ += first_ ? "\n{\"name\":" : ",\n{\"name\":";
+				first_ = false;
+				_appendString(text_, e.name);
+				text_ += ",\"cat\":";
+				_appendString(text_, e.category);
+				char fields[128];
+				std::snprintf(fields, sizeof(fields), ",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				              pid_, buffers[i]->tid, (e.beginNs - startNs_) * 1e-3, (e.endNs - e.beginNs) * 1e-3);
+				text_ += fields;
+				++written;
+			}
+			std::fwrite(text_.data(), 1, text_.size(), file_);
+		}
+	}
+	std::fflush(file_);
+	written_.store(written, std::memory_order_release);
+}
+
+inline void VirtuoseTraceWriter::_run() {
+	while (running_.load(std::memory_order_acquire)) {
+		std::this_thread::sleep_for(interval_);
+		_flush();
+	}
+}
+
+inline void VirtuoseTraceWriter::close() {
+	if (!file_) {
+		return;
+	}
+	::vpp_trace::sink().store(NULL, std::memory_order_release);
+	_registry().active.store(false, std::memory_order_relaxed);
+	running_.store(false, std::memory_order_release);
+	thread_.join();
+	_flush();
+	std::string names;
+	{
+		Registry & r = _registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		for (std::size_t i = 0; i < r.buffers.size(); ++i) {
+			if (r.buffers[i]->name.empty()) {
+				continue;
+			}
+			char fields[96];
+			std::snprintf(fields, sizeof(fields), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+			              pid_, r.buffers[i]->tid);
+			names += first_ ? "\n" : ",\n";
+			first_ = false;
+			names += fields;
+			_appendString(names, r.buffers[i]->name.c_str());
+			names += "}}";
+		}
+	}
+	names += "\n]}\n";
+	std::fputs(names.c_str(), file_);
+	std::fclose(file_);
+	file_ = NULL;
+}
+
+#endif // INCLUDED_vpp_trace_h_GUID_3e9b7d52_c4a1_4f68_9d20_5b8e1f7a6c39
@@ -0,0 +1,166 @@
+/**
+	@file
+	@brief Prints a trajectory file written by VirtuoseTrajectoryRecorder:
+	its header and a check of the recording (ticks missing, intervals), or
+	its records as CSV, one column per channel element.
+
+	Only uses the channel layout stored in the file, so it also reads
+	files whose records differ from VirtuoseTrajectorySample.
+
+	Usage: vpp-trajectory-dump [--summary] FILE
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include "vpp-trajectory-recorder.h"
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace {
+	template<typename T>
+	T load(const char * p) {
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return value;
+	}
+
+	void printElement(VirtuoseTrajectoryChannel const& c, const char * record, uint32_t i) {
+		switch (c.type) {
+			case VirtuoseTrajectoryChannel::UInt32:
+				std::printf("%u", load<uint32_t>(record + c.offset + i * 4));
+				break;
+			case VirtuoseTrajectoryChannel::Int32:
+				std::printf("%d", load<int32_t>(record + c.offset + i * 4));
+				break;
+			case VirtuoseTrajectoryChannel::UInt64:
+				std::printf("%llu", static_cast<unsigned long long>(load<uint64_t>(record + c.offset + i * 8)));
+				break;
+			case VirtuoseTrajectoryChannel::Float32:
+				std::printf("%.9g", load<float>(record + c.offset + i * 4));
+				break;
+			case VirtuoseTrajectoryChannel::Float64:
+				std::printf("%.15g", load<double>(record + c.offset + i * 8));
+				break;
+			default:
+				std::printf("?");
+		}
+	}
+
+	/// @brief Index of the channel called @a name, or -1.
+	int findChannel(VirtuoseTrajectoryFileHeader const& h, const char * name, uint32_t type) {
+		for (uint32_t i = 0; i < h.channelCount; ++i) {
+			if (std::strncmp(h.channels[i].name, name, sizeof(h.channels[i].name)) == 0 && h.channels[i].type == type) {
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	void printSummary(VirtuoseTrajectoryReader const& reader) {
+		VirtuoseTrajectoryFileHeader const& h = reader.header();
+		std::time_t start = static_cast<std::time_t>(h.startTime);
+		char when[64];
+		std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", std::localtime(&start));
+		std::printf("VirtuoseAPI %d.%d, time step %g s, started %s\n", h.apiMajor, h.apiMinor, h.timeStep, when);
+		std::printf("%llu records of %u bytes (room for %llu), %llu overwritten, %llu dropped while recording\n",
+		            static_cast<unsigned long long>(reader.size()), h.recordSize,
+		            static_cast<unsigned long long>(h.capacity),
+		            static_cast<unsigned long long>(h.written - reader.size()),
+		            static_cast<unsigned long long>(h.dropped));
+		for (uint32_t i = 0; i < h.channelCount; ++i) {
+			VirtuoseTrajectoryChannel const& c = h.channels[i];
+			std::printf("  %-16.16s type %u, %u element(s) at offset %u\n", c.name, c.type, c.count, c.offset);
+		}
+
+		int tick = findChannel(h, "tick", VirtuoseTrajectoryChannel::UInt64);
+		int time = findChannel(h, "time", VirtuoseTrajectoryChannel::Float64);
+		if (tick < 0 || time < 0 || reader.size() == 0) {
+			return;
+		}
+		uint64_t missing = 0;
+		double maxInterval = 0;
+		uint64_t late = 0;
+		uint64_t prevTick = load<uint64_t>(reader.record(0) + h.channels[tick].offset);
+		double prevTime = load<double>(reader.record(0) + h.channels[time].offset);
+		double firstTime = prevTime;
+		for (uint64_t i = 1; i < reader.size(); ++i) {
+			uint64_t t = load<uint64_t>(reader.record(i) + h.channels[tick].offset);
+			double s = load<double>(reader.record(i) + h.channels[time].offset);
+			missing += t - prevTick - 1;
+			double interval = s - prevTime;
+			if (interval > maxInterval) {
+				maxInterval = interval;
+			}
+			if (h.timeStep > 0 && interval > 1.5 * h.timeStep) {
+				++late;
+			}
+			prevTick = t;
+			prevTime = s;
+		}
+		std::printf("%.3f s recorded, %llu ticks missing, max interval %.1f us",
+		            prevTime - firstTime, static_cast<unsigned long long>(missing), maxInterval * 1e6);
+		if (h.timeStep > 0) {
+			std::printf(", %llu intervals over 1.5 time steps", static_cast<unsigned long long>(late));
+		}
+		std::printf("\n");
+	}
+
+	void printCSV(VirtuoseTrajectoryReader const& reader) {
+		VirtuoseTrajectoryFileHeader const& h = reader.header();
+		const char * separator = "";
+		for (uint32_t i = 0; i < h.channelCount; ++i) {
+			VirtuoseTrajectoryChannel const& c = h.channels[i];
+			for (uint32_t e = 0; e < c.count; ++e) {
+				if (c.count == 1) {
+					std::printf("%s%.16s", separator, c.name);
+				} else {
+					std::printf("%s%.16s%u", separator, c.name, e);
+				}
+				separator = ",";
+			}
+		}
+		std::printf("\n");
+		for (uint64_t r = 0; r < reader.size(); ++r) {
+			const char * record = reader.record(r);
+			separator = "";
+			for (uint32_t i = 0; i < h.channelCount; ++i) {
+				for (uint32_t e = 0; e < h.channels[i].count; ++e) {
+					std::printf("%s", separator);
+					printElement(h.channels[i], record, e);
+					separator = ",";
+				}
+			}
+			std::printf("\n");
+		}
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	bool summary = argc == 3 && std::strcmp(argv[1], "--summary") == 0;
+	if (argc != 2 && !summary) {
+		std::fprintf(stderr, "Usage: %s [--summary] FILE\n", argv[0]);
+		return 2;
+	}
+	try {
+		VirtuoseTrajectoryReader reader(argv[argc - 1]);
+		if (summary) {
+			printSummary(reader);
+		} else {
+			printCSV(reader);
+		}
+	} catch (std::runtime_error & e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,607 @@
+/**
+	@file
+	@brief Records every servo tick (pose, speed, force, buttons) to a
+	memory-mapped binary file without slowing down the servo thread, and
+	reads such files back.
+
+	The periodic function hands each sample to a lock-free ring in
+	memory; a background thread drains the ring into a file of
+	fixed-size records, preceded by a header describing the API version,
+	time step and channel layout. See extras/vpp-trajectory-dump.cpp for
+	a tool printing these files.
+
+	Requires C++11 and POSIX (mmap).
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_trajectory_recorder_h_GUID_8c1d4e7a_2f5b_4a90_b6e3_71d0c9a5f248
+#define INCLUDED_vpp_trajectory_recorder_h_GUID_8c1d4e7a_2f5b_4a90_b6e3_71d0c9a5f248
+
+// Internal Includes
+#include <vpp.h>
+
+// Library/third-party includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/** @brief Bounded lock-free queue between exactly one producer thread
+	and one consumer thread.
+
+	push() and pop() never block or allocate: push() just fails when the
+	queue is full. The capacity is rounded up to a power of two.
+*/
+template<typename T>
+class VirtuoseSampleRing {
+		static_assert(std::is_trivially_copyable<T>::value, "VirtuoseSampleRing needs a trivially-copyable type");
+	public:
+		explicit VirtuoseSampleRing(std::size_t capacity) : mask_(0), head_(0), cachedTail_(0), tail_(0), cachedHead_(0) {
+			std::size_t size = 1;
+			while (size < capacity) {
+				size *= 2;
+			}
+			buffer_.resize(size);
+			mask_ = size - 1;
+		}
+
+		/// @brief Appends @a value, or returns false if the queue is full.
+		/// Producer thread only.
+		bool push(T const& value) {
+			std::size_t head = head_.load(std::memory_order_relaxed);
+			if (head - cachedTail_ > mask_) {
+				cachedTail_ = tail_.load(std::memory_order_acquire);
+				if (head - cachedTail_ > mask_) {
+					return false;
+				}
+			}
+			buffer_[head & mask_] = value;
+			head_.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// @brief Moves up to @a max values into @a out, oldest first,
+		/// and returns how many. Consumer thread only.
+		std::size_t pop(T * out, std::size_t max) {
+			std::size_t tail = tail_.load(std::memory_order_relaxed);
+			if (cachedHead_ == tail) {
+				cachedHead_ = head_.load(std::memory_order_acquire);
+			}
+			std::size_t n = cachedHead_ - tail;
+			if (n > max) {
+				n = max;
+			}
+			for (std::size_t i = 0; i < n; ++i) {
+				out[i] = buffer_[(tail + i) & mask_];
+			}
+			tail_.store(tail + n, std::memory_order_release);
+			return n;
+		}
+
+		std::size_t capacity() const {
+			return mask_ + 1;
+		}
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseSampleRing(VirtuoseSampleRing const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseSampleRing & operator=(VirtuoseSampleRing const&);
+
+		std::vector<T> buffer_;
+		std::size_t mask_;
+		// Each index on its own cache line, next to the producer's or the
+		// consumer's copy of the other index. Padded rather than aligned,
+		// so the ring (and the recorder) can be allocated with plain new.
+		char padHead_[64];
+		std::atomic<std::size_t> head_;
+		std::size_t cachedTail_;
+		char padTail_[64];
+		std::atomic<std::size_t> tail_;
+		std::size_t cachedHead_;
+		char padEnd_[64];
+};
+
+/** @brief One record of a trajectory file: the state read and the force
+	sent during one servo tick.
+*/
+struct VirtuoseTrajectorySample {
+	/// Number of the sample since recording started.
+	uint64_t tick;
+	/// Seconds since the recorder was opened.
+	double time;
+	VirtuoseDisplacement position;
+	VirtuoseTwist speed;
+	VirtuoseWrench force;
+	/// Bit i is set if button i is pressed.
+	uint32_t buttons;
+	int32_t deadMan;
+	int32_t emergencyStop;
+	int32_t powerOn;
+	uint32_t timeLastUpdate;
+};
+
+/// @brief Describes where one named channel lies within a record.
+struct VirtuoseTrajectoryChannel {
+	enum Type {
+		UInt32 = 1,
+		Int32 = 2,
+		UInt64 = 3,
+		Float32 = 4,
+		Float64 = 5
+	};
+
+	/// NUL-terminated.
+	char name[16];
+	/// A Type value.
+	uint32_t type;
+	/// Byte offset of the first element from the start of the record.
+	uint32_t offset;
+	/// Number of consecutive elements.
+	uint32_t count;
+	uint32_t reserved;
+
+	/// @brief Bytes per element of a channel of type @a type, or 0 if
+	/// the type is unknown.
+	static uint32_t elementSize(uint32_t type) {
+		switch (type) {
+			case UInt32:
+			case Int32:
+			case Float32:
+				return 4;
+			case UInt64:
+			case Float64:
+				return 8;
+			default:
+				return 0;
+		}
+	}
+};
+
+/** @brief Header at the start of a trajectory file. Records start at
+	@a dataOffset and are @a recordSize bytes each, in native byte
+	order (check @a byteOrder).
+
+	The file is a ring of @a capacity records: if more than that many
+	were written, the oldest were overwritten, and the oldest remaining
+	one is record number (written % capacity).
+*/
+struct VirtuoseTrajectoryFileHeader {
+	enum {
+		MaxChannels = 16,
+		FormatVersion = 1,
+		ByteOrderMark = 0x01020304
+	};
+
+	/// "VPPTRAJ" and a NUL.
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t formatVersion;
+	uint32_t dataOffset;
+	uint32_t recordSize;
+	/// Records the file has room for.
+	uint64_t capacity;
+	/// Records written in total. Updated while recording, after the
+	/// records themselves.
+	uint64_t written;
+	/// Samples lost because the in-memory ring was full.
+	uint64_t dropped;
+	/// Version reported by virtAPIVersion() of the recorded device,
+	/// 0.0 if not given.
+	int32_t apiMajor;
+	int32_t apiMinor;
+	/// Servo period in seconds, or 0 if unknown.
+	float timeStep;
+	uint32_t channelCount;
+	/// Wall-clock time the recording started, seconds since the epoch.
+	double startTime;
+	VirtuoseTrajectoryChannel channels[MaxChannels];
+
+	/// @brief Number of records in the file.
+	uint64_t recordCount() const {
+		return written < capacity ? written : capacity;
+	}
+
+	/// @brief Index of the oldest record in the file.
+	uint64_t firstRecord() const {
+		return written < capacity ? 0 : written % capacity;
+	}
+};
+
+/** @brief Writes a trajectory file from the periodic function.
+
+	record() only copies the sample into a lock-free ring, so it takes a
+	few tens of nanoseconds and never blocks, allocates or makes a
+	system call. A background thread moves the samples into the
+	memory-mapped file. The file's blocks are reserved when it is
+	opened, so running out of disk space fails there rather than during
+	the recording. If the ring fills up because the disk can't keep up,
+	samples are dropped and counted in the header.
+
+	A sample only reaches the disk after the page cache writes it back,
+	but it is in the file as soon as the background thread copied it,
+	even if the process then crashes.
+
+	@code
+	// An hour at 4 kHz
+	VirtuoseTrajectoryRecorder recorder("session.vtraj", 4000 * 3600, 0.00025f);
+	int major, minor;
+	Virtuose::APIVersion(&major, &minor);
+	recorder.setAPIVersion(major, minor);
+
+	void servoTick(VirtContext vc, void * arg) {
+		VirtuoseRef vpp(vc);
+		VirtuoseState state = vpp.readState();
+		VirtuoseWrench force = computeForce(state);
+		vpp.setForce(force.data);
+		static_cast<VirtuoseTrajectoryRecorder *>(arg)->record(state, force);
+	}
+	@endcode
+*/
+class VirtuoseTrajectoryRecorder {
+	public:
+		/** @brief Creates (or replaces) the file at @a path and starts the
+			background thread.
+
+			@param path File to write.
+			@param capacity Records the file holds; once full, the oldest
+			are overwritten. At 4 kHz, an hour is 14.4 million records of
+			sizeof(VirtuoseTrajectorySample) bytes.
+			@param timeStep Servo period in seconds, stored in the header.
+			@param ringCapacity Samples buffered in memory before record()
+			starts dropping them.
+			@throws std::runtime_error if the file can't be created.
+		*/
+		VirtuoseTrajectoryRecorder(std::string const& path, uint64_t capacity, float timeStep = 0.f, std::size_t ringCapacity = 16384);
+
+		/// @brief Stops recording.
+		~VirtuoseTrajectoryRecorder() {
+			close();
+		}
+
+		/// @brief Queues a sample. Wait-free; call from one thread only.
+		/// @returns false if the sample had to be dropped.
+		bool record(VirtuoseTrajectorySample const& sample) {
+			if (!tryRecord(sample)) {
+				dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				return false;
+			}
+			return true;
+		}
+
+		/// @brief Like record(), but doesn't count the sample as dropped,
+		/// for a producer that can wait and try again.
+		bool tryRecord(VirtuoseTrajectorySample const& sample) {
+			return ring_.push(sample);
+		}
+
+		/// @brief Queues a sample made of @a state and @a force, numbered
+		/// and stamped with the time since the recorder was opened.
+		bool record(VirtuoseState const& state, VirtuoseWrench const& force) {
+			VirtuoseTrajectorySample sample;
+			sample.tick = tick_++;
+			sample.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+			sample.position = state.position;
+			sample.speed = state.speed;
+			sample.force = force;
+			sample.buttons = state.buttons;
+			sample.deadMan = state.deadMan;
+			sample.emergencyStop = state.emergencyStop;
+			sample.powerOn = state.powerOn;
+			sample.timeLastUpdate = state.timeLastUpdate;
+			return record(sample);
+		}
+
+		/** @brief Writes the remaining samples, stops the background
+			thread and closes the file, trimming it to the records written.
+			Called by the destructor; don't call concurrently with record().
+		*/
+		void close();
+
+		/// @brief Stores the VirtuoseAPI version of the recorded device
+		/// in the header. Call before recording.
+		void setAPIVersion(int major, int minor) {
+			_header()->apiMajor = major;
+			_header()->apiMinor = minor;
+		}
+
+		/// @brief Samples dropped so far because the ring was full.
+		uint64_t dropped() const {
+			return dropped_.load(std::memory_order_relaxed);
+		}
+
+		/// @brief Samples written to the file so far.
+		uint64_t written() const {
+			return written_.load(std::memory_order_acquire);
+		}
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseTrajectoryRecorder(VirtuoseTrajectoryRecorder const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseTrajectoryRecorder & operator=(VirtuoseTrajectoryRecorder const&);
+
+		static void _fail(std::string const& what, std::string const& path) {
+			throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+		}
+
+		static void _addChannel(VirtuoseTrajectoryFileHeader & header, const char * name,
+		                        VirtuoseTrajectoryChannel::Type type, std::size_t offset, uint32_t count) {
+			VirtuoseTrajectoryChannel & c = header.channels[header.channelCount++];
+			std::strncpy(c.name, name, sizeof(c.name) - 1);
+			c.type = type;
+			c.offset = static_cast<uint32_t>(offset);
+			c.count = count;
+		}
+
+		VirtuoseTrajectoryFileHeader * _header() {
+			return static_cast<VirtuoseTrajectoryFileHeader *>(map_);
+		}
+
+		void _drain();
+		std::size_t _write();
+
+		int fd_;
+		void * map_;
+		std::size_t mapSize_;
+		uint64_t capacity_;
+		VirtuoseSampleRing<VirtuoseTrajectorySample> ring_;
+		std::vector<VirtuoseTrajectorySample> batch_;
+		std::atomic<uint64_t> written_;
+		std::atomic<uint64_t> dropped_;
+		std::atomic<bool> running_;
+		std::thread thread_;
+		uint64_t tick_;
+		std::chrono::steady_clock::time_point start_;
+};
+
+/** @brief Read-only view of a trajectory file, memory-mapped.
+
+	Records are numbered oldest first, whether or not the file wrapped.
+*/
+class VirtuoseTrajectoryReader {
+	public:
+		/// @throws std::runtime_error if the file can't be read or isn't
+		/// a trajectory file this version understands.
+		explicit VirtuoseTrajectoryReader(std::string const& path);
+
+		~VirtuoseTrajectoryReader() {
+			munmap(map_, mapSize_);
+		}
+
+		VirtuoseTrajectoryFileHeader const& header() const {
+			return *static_cast<VirtuoseTrajectoryFileHeader const *>(map_);
+		}
+
+		/// @brief Number of records.
+		uint64_t size() const {
+			return size_;
+		}
+
+		/// @brief The bytes of record @a i, laid out as described by the
+		/// header's channels.
+		const char * record(uint64_t i) const {
+			VirtuoseTrajectoryFileHeader const& h = header();
+			uint64_t slot = (h.firstRecord() + i) % h.capacity;
+			return static_cast<const char *>(map_) + h.dataOffset + slot * h.recordSize;
+		}
+
+		/// @brief Whether records are VirtuoseTrajectorySample, so sample() can be used.
+		bool hasSampleLayout() const {
+			return header().recordSize == sizeof(VirtuoseTrajectorySample);
+		}
+
+		/// @brief Record @a i as a sample; requires hasSampleLayout().
+		VirtuoseTrajectorySample sample(uint64_t i) const {
+			VirtuoseTrajectorySample ret;
+			std::memcpy(&ret, record(i), sizeof(ret));
+			return ret;
+		}
+
+	private:
+		/// @brief Copy constructor forbidden
+		VirtuoseTrajectoryReader(VirtuoseTrajectoryReader const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseTrajectoryReader & operator=(VirtuoseTrajectoryReader const&);
+
+		/// @brief Whether every channel has a known type and lies within a record.
+		static bool _channelsFit(VirtuoseTrajectoryFileHeader const& h) {
+			for (uint32_t i = 0; i < h.channelCount; ++i) {
+				VirtuoseTrajectoryChannel const& c = h.channels[i];
+				uint64_t size = VirtuoseTrajectoryChannel::elementSize(c.type);
+				if (size == 0 || c.offset + c.count * size > h.recordSize) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void * map_;
+		std::size_t mapSize_;
+		uint64_t size_;
+};
+
+inline VirtuoseTrajectoryRecorder::VirtuoseTrajectoryRecorder(std::string const& path, uint64_t capacity, float timeStep, std::size_t ringCapacity)
+	: fd_(-1)
+	, map_(NULL)
+	, mapSize_(0)
+	, capacity_(capacity ? capacity : 1)
+	, ring_(ringCapacity)
+	, batch_(256)
+	, written_(0)
+	, dropped_(0)
+	, running_(true)
+	, tick_(0)
+	, start_(std::chrono::steady_clock::now()) {
+	// Records start on a page boundary.
+	const std::size_t dataOffset = 4096;
+	static_assert(sizeof(VirtuoseTrajectoryFileHeader) <= dataOffset, "Trajectory file header too large");
+	mapSize_ = dataOffset + capacity_ * sizeof(VirtuoseTrajectorySample);
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd_ < 0) {
+		_fail("Could not create", path);
+	}
+	int err = posix_fallocate(fd_, 0, static_cast<off_t>(mapSize_));
+	if (err == EINVAL || err == EOPNOTSUPP) {
+		err = ftruncate(fd_, static_cast<off_t>(mapSize_)) == 0 ? 0 : errno;
+	}
+	if (err != 0) {
+		errno = err;
+		::close(fd_);
+		_fail("Could not reserve space for", path);
+	}
+	map_ = mmap(NULL, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (map_ == MAP_FAILED) {
+		::close(fd_);
+		_fail("Could not map", path);
+	}
+
+	VirtuoseTrajectoryFileHeader & h = *_header();
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, "VPPTRAJ", 8);
+	h.byteOrder = VirtuoseTrajectoryFileHeader::ByteOrderMark;
+	h.formatVersion = VirtuoseTrajectoryFileHeader::FormatVersion;
+	h.dataOffset = dataOffset;
+	h.recordSize = sizeof(VirtuoseTrajectorySample);
+	h.capacity = capacity_;
+	h.timeStep = timeStep;
+	h.startTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+	typedef VirtuoseTrajectorySample S;
+	typedef VirtuoseTrajectoryChannel C;
+	_addChannel(h, "tick", C::UInt64, offsetof(S, tick), 1);
+	_addChannel(h, "time", C::Float64, offsetof(S, time), 1);
+	_addChannel(h, "position", C::Float32, offsetof(S, position), VirtuoseDisplacement::size);
+	_addChannel(h, "speed", C::Float32, offsetof(S, speed), VirtuoseTwist::size);
+	_addChannel(h, "force", C::Float32, offsetof(S, force), VirtuoseWrench::size);
+	_addChannel(h, "buttons", C::UInt32, offsetof(S, buttons), 1);
+	_addChannel(h, "deadMan", C::Int32, offsetof(S, deadMan), 1);
+	_addChannel(h, "emergencyStop", C::Int32, offsetof(S, emergencyStop), 1);
+	_addChannel(h, "powerOn", C::Int32, offsetof(S, powerOn), 1);
+	_addChannel(h, "timeLastUpdate", C::UInt32, offsetof(S, timeLastUpdate), 1);
+
+	thread_ = std::thread(&VirtuoseTrajectoryRecorder::_drain, this);
+}
+
+inline std::size_t VirtuoseTrajectoryRecorder::_write() {
+	std::size_t n = ring_.pop(&batch_[0], batch_.size());
+	if (n == 0) {
+		return 0;
+	}
+	VirtuoseTrajectoryFileHeader & h = *_header();
+	char * records = static_cast<char *>(map_) + h.dataOffset;
+	uint64_t written = written_.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < n; ++i) {
+		std::memcpy(records + ((written + i) % capacity_) * sizeof(VirtuoseTrajectorySample), &batch_[i], sizeof(VirtuoseTrajectorySample));
+	}
+	written += n;
+	// The records before the count, for anyone reading the file meanwhile.
+	__atomic_store_n(&h.dropped, dropped(), __ATOMIC_RELAXED);
+	__atomic_store_n(&h.written, written, __ATOMIC_RELEASE);
+	written_.store(written, std::memory_order_release);
+	return n;
+}
+
+inline void VirtuoseTrajectoryRecorder::_drain() {
+	while (running_.load(std::memory_order_acquire)) {
+		if (_write() == 0) {
+			// A few ticks at servo rates: the ring holds seconds of them.
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	while (_write() != 0) {
+	}
+}
+
+inline void VirtuoseTrajectoryRecorder::close() {
+	if (!map_) {
+		return;
+	}
+	running_.store(false, std::memory_order_release);
+	thread_.join();
+	VirtuoseTrajectoryFileHeader & h = *_header();
+	h.dropped = dropped();
+	uint64_t written = h.written;
+	std::size_t used = mapSize_;
+	if (written < capacity_) {
+		used = h.dataOffset + written * sizeof(VirtuoseTrajectorySample);
+	}
+	msync(map_, used, MS_SYNC);
+	munmap(map_, mapSize_);
+	map_ = NULL;
+	if (used < mapSize_) {
+		// Leaves the header's capacity as is: it still says how much
+		// would have been kept.
+		int trimmed = ftruncate(fd_, static_cast<off_t>(used));
+		(void) trimmed;
+	}
+	::close(fd_);
+	fd_ = -1;
+}
+
+inline VirtuoseTrajectoryReader::VirtuoseTrajectoryReader(std::string const& path) : map_(NULL), mapSize_(0), size_(0) {
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(VirtuoseTrajectoryFileHeader)) {
+		::close(fd);
+		throw std::runtime_error(path + " is too short to be a trajectory file");
+	}
+	mapSize_ = static_cast<std::size_t>(st.st_size);
+	map_ = mmap(NULL, mapSize_, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (map_ == MAP_FAILED) {
+		throw std::runtime_error("Could not map " + path + ": " + std::strerror(errno));
+	}
+
+	VirtuoseTrajectoryFileHeader const& h = header();
+	const char * problem = NULL;
+	if (std::memcmp(h.magic, "VPPTRAJ", 8) != 0) {
+		problem = " is not a trajectory file";
+	} else if (h.byteOrder != VirtuoseTrajectoryFileHeader::ByteOrderMark) {
+		problem = " was written with a different byte order";
+	} else if (h.formatVersion != VirtuoseTrajectoryFileHeader::FormatVersion) {
+		problem = " has an unsupported format version";
+	} else if (h.capacity == 0 || h.recordSize == 0 || h.channelCount > VirtuoseTrajectoryFileHeader::MaxChannels
+	           || h.dataOffset < sizeof(VirtuoseTrajectoryFileHeader) || h.dataOffset > mapSize_
+	           || h.capacity > (~static_cast<uint64_t>(0) - h.dataOffset) / h.recordSize || !_channelsFit(h)) {
+		problem = " has a corrupt header";
+	}
+	if (!problem) {
+		// A file still being written, or trimmed, only holds what's been written.
+		uint64_t available = (mapSize_ - h.dataOffset) / h.recordSize;
+		size_ = __atomic_load_n(&h.written, __ATOMIC_ACQUIRE);
+		size_ = size_ < h.capacity ? size_ : h.capacity;
+		if (size_ > available) {
+			problem = " is truncated";
+		}
+	}
+	if (problem) {
+		munmap(map_, mapSize_);
+		throw std::runtime_error(path + problem);
+	}
+}
+
+#endif // INCLUDED_vpp_trajectory_recorder_h_GUID_8c1d4e7a_2f5b_4a90_b6e3_71d0c9a5f248
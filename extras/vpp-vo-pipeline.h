@@ -0,0 +1,288 @@
+/**
+	@file
+	@brief Hands virtual object (VO) targets from a slow physics thread to
+	the servo loop, which interpolates or extrapolates them to each tick
+	before sending them with setPosition()/setSpeed().
+
+	Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_vpp_vo_pipeline_h_GUID_9e4b1d73_2c8a_4f60_b5e7_3a1f0c6d8e29
+#define INCLUDED_vpp_vo_pipeline_h_GUID_9e4b1d73_2c8a_4f60_b5e7_3a1f0c6d8e29
+
+// Internal Includes
+#include <vpp.h>
+#include "vpp-pose-math.h"
+#include "vpp-state-publisher.h"
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+/** @brief Number of targets the servo side keeps to interpolate between.
+	Define before including this header to change it.
+*/
+#ifndef VPP_VO_HISTORY
+#	define VPP_VO_HISTORY 8
+#endif
+
+/// @brief Pose and speed the virtual object should have at a given time.
+struct VirtuoseVOTarget {
+	VirtuoseDisplacement position;
+	VirtuoseTwist speed;
+	/// When, in nanoseconds of std::chrono::steady_clock.
+	int64_t timeNs;
+	/// Number of targets published before this one.
+	uint64_t sequence;
+};
+
+/// @brief Counters kept by the servo side of a VirtuoseVOPipeline.
+struct VirtuoseVOPipelineStats {
+	/// Calls to sample() that produced a command.
+	uint64_t ticks;
+	/// Ticks between two targets.
+	uint64_t interpolated;
+	/// Ticks past the latest target, within the extrapolation limit.
+	uint64_t extrapolated;
+	/// Ticks past the extrapolation limit (the physics is late) or before
+	/// the oldest target kept (the delay is too long).
+	uint64_t held;
+	/// Targets the servo side picked up.
+	uint64_t received;
+	/// Targets replaced by a newer one before the servo side saw them,
+	/// or dropped for not being later than the newest one it kept.
+	uint64_t skipped;
+};
+
+/** @brief Two-rate pipeline for driving a virtual object (attachVO(),
+	attachQSVO()) from physics slower than the servo loop.
+
+	The physics thread calls publish() with each new target whenever it
+	has one; the periodic function calls command() every tick, which
+	computes the target's pose and speed for when the command takes
+	effect, one time step ahead, and sends them. Neither side ever waits
+	for the other: publish() is wait-free, and if a target is being
+	published while the servo side reads, the servo side keeps the
+	targets it has until the next tick. So however long collision
+	detection takes, the servo loop's tick stays short.
+
+	Between two targets, the pose is interpolated; past the latest one,
+	it's extrapolated at that target's speed for at most maxExtrapolation
+	seconds, then held, with a zero speed. A delay makes the servo side
+	play the targets back that much later, so it interpolates instead of
+	extrapolating, at the cost of that much latency: make it at least the
+	longest physics step plus one time step, and less than the last
+	VPP_VO_HISTORY targets span.
+
+	@code
+	float timeStep;
+	vpp.getTimeStep(&timeStep);
+	VirtuoseVOPipeline vo(timeStep);
+
+	// physics thread
+	for (;;) {
+		simulate();
+		vo.publish(objectPose, objectSpeed);
+	}
+
+	// periodic function
+	vo.command(vpp);
+	@endcode
+
+	Only one thread may call publish(), and only one sample()/command().
+*/
+class VirtuoseVOPipeline {
+	public:
+		/** @param timeStep The servo loop's period, from getTimeStep():
+			each command is for one time step later.
+			@param delay How long after their time targets are played back.
+			@param maxExtrapolation How long past the latest target the
+			pose is extrapolated before being held.
+		*/
+		explicit VirtuoseVOPipeline(double timeStep, double delay = 0., double maxExtrapolation = 0.02)
+			: lookaheadNs_(static_cast<int64_t>((timeStep - delay) * 1e9))
+			, maxExtrapolationNs_(static_cast<int64_t>(maxExtrapolation * 1e9))
+			, published_(0)
+			, seen_(0)
+			, count_(0)
+			, newest_(0) {
+			resetStats();
+		}
+
+		static int64_t nowNs() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/// @brief Publishes the target for the time @a timeNs. Physics thread only.
+		void publish(VirtuoseDisplacement const& position, VirtuoseTwist const& speed, int64_t timeNs) {
+			VirtuoseVOTarget target;
+			target.position = position;
+			target.speed = speed;
+			target.timeNs = timeNs;
+			target.sequence = published_++;
+			latest_.publish(target);
+		}
+
+		/// @overload for a target for now.
+		void publish(VirtuoseDisplacement const& position, VirtuoseTwist const& speed) {
+			publish(position, speed, nowNs());
+		}
+
+		/** @brief Computes the pose and speed to command at @a timeNs (for
+			one time step later). Servo thread only.
+
+			@returns false until the first target was published.
+		*/
+		bool sample(int64_t timeNs, VirtuoseDisplacement & position, VirtuoseTwist & speed) {
+			_receive();
+			if (count_ == 0) {
+				return false;
+			}
+			int64_t at = timeNs + lookaheadNs_;
+			VirtuoseVOTarget const& newest = _target(0);
+			std::atomic<uint64_t> * counter = &interpolated_;
+			if (at >= newest.timeNs) {
+				int64_t ahead = at - newest.timeNs;
+				bool held = ahead > maxExtrapolationNs_;
+				vpp_pose::integrate(newest.position.data, newest.speed.data, (held ? maxExtrapolationNs_ : ahead) * 1e-9f, position.data);
+				// A held pose doesn't move: a nonzero speed would have
+				// the impedance pull towards motion that isn't happening.
+				speed = held ? VirtuoseTwist() : newest.speed;
+				counter = held ? &held_ : &extrapolated_;
+			} else {
+				// Newest to oldest, for the first target at or before at.
+				std::size_t i = 1;
+				while (i < count_ && _target(i).timeNs > at) {
+					++i;
+				}
+				if (i == count_) {
+					position = _target(i - 1).position;
+					speed = VirtuoseTwist();
+					counter = &held_;
+				} else {
+					VirtuoseVOTarget const& before = _target(i);
+					VirtuoseVOTarget const& after = _target(i - 1);
+					float s = static_cast<float>(at - before.timeNs) / static_cast<float>(after.timeNs - before.timeNs);
+					vpp_pose::interpolate(before.position.data, after.position.data, s, position.data);
+					for (int k = 0; k < 6; ++k) {
+						speed[k] = before.speed[k] + s * (after.speed[k] - before.speed[k]);
+					}
+				}
+			}
+			_add(*counter, 1);
+			_add(ticks_, 1);
+			return true;
+		}
+
+		/** @brief Samples the target for now and sends it with
+			setPosition() and setSpeed(). Servo thread only.
+
+			@returns the result of the first failing call; does nothing
+			until the first target was published.
+		*/
+		template<typename Device>
+		VirtuoseResult command(Device & vpp) {
+			VirtuoseResult result = {0, VIRT_E_NO_ERROR};
+			VirtuoseDisplacement position;
+			VirtuoseTwist speed;
+			if (sample(nowNs(), position, speed)) {
+				result = vpp.trySetPosition(position.data);
+				if (result.ok()) {
+					result = vpp.trySetSpeed(speed.data);
+				}
+			}
+			return result;
+		}
+
+		/// @brief Counters of the servo side; callable from any thread.
+		VirtuoseVOPipelineStats stats() const {
+			VirtuoseVOPipelineStats ret;
+			ret.ticks = ticks_.load(std::memory_order_relaxed);
+			ret.interpolated = interpolated_.load(std::memory_order_relaxed);
+			ret.extrapolated = extrapolated_.load(std::memory_order_relaxed);
+			ret.held = held_.load(std::memory_order_relaxed);
+			ret.received = received_.load(std::memory_order_relaxed);
+			ret.skipped = skipped_.load(std::memory_order_relaxed);
+			return ret;
+		}
+
+		/// @brief Zeroes the counters. Not while the servo side runs.
+		void resetStats() {
+			ticks_.store(0, std::memory_order_relaxed);
+			interpolated_.store(0, std::memory_order_relaxed);
+			extrapolated_.store(0, std::memory_order_relaxed);
+			held_.store(0, std::memory_order_relaxed);
+			received_.store(0, std::memory_order_relaxed);
+			skipped_.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		/// @brief Picks up a newer target, if one was published and can be
+		/// read without waiting. Targets not later than the newest one
+		/// kept are dropped, once.
+		void _receive() {
+			VirtuoseVOTarget target;
+			if (!latest_.tryRead(target) || target.sequence < seen_) {
+				return;
+			}
+			_add(skipped_, target.sequence - seen_);
+			seen_ = target.sequence + 1;
+			if (count_ && target.timeNs <= _target(0).timeNs) {
+				_add(skipped_, 1);
+				return;
+			}
+			newest_ = (newest_ + 1) % VPP_VO_HISTORY;
+			history_[newest_] = target;
+			if (count_ < VPP_VO_HISTORY) {
+				++count_;
+			}
+			_add(received_, 1);
+		}
+
+		/// @brief The target received @a age targets before the newest one.
+		VirtuoseVOTarget const& _target(std::size_t age) const {
+			return history_[(newest_ + VPP_VO_HISTORY - age) % VPP_VO_HISTORY];
+		}
+
+		/// @brief Counters only have one writer: no read-modify-write needed.
+		static void _add(std::atomic<uint64_t> & counter, uint64_t n) {
+			counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+
+		int64_t const lookaheadNs_;
+		int64_t const maxExtrapolationNs_;
+
+		// Physics thread.
+		uint64_t published_;
+		VirtuoseStatePublisher<VirtuoseVOTarget> latest_;
+
+		// Servo thread.
+		/// Sequence number after the last target read, kept or not.
+		uint64_t seen_;
+		std::size_t count_;
+		std::size_t newest_;
+		VirtuoseVOTarget history_[VPP_VO_HISTORY];
+		std::atomic<uint64_t> ticks_;
+		std::atomic<uint64_t> interpolated_;
+		std::atomic<uint64_t> extrapolated_;
+		std::atomic<uint64_t> held_;
+		std::atomic<uint64_t> received_;
+		std::atomic<uint64_t> skipped_;
+
+		/// @brief Copy constructor forbidden
+		VirtuoseVOPipeline(VirtuoseVOPipeline const&);
+
+		/// @brief Assignment operator forbidden
+		VirtuoseVOPipeline & operator=(VirtuoseVOPipeline const&);
+};
+
+#endif // INCLUDED_vpp_vo_pipeline_h_GUID_9e4b1d73_2c8a_4f60_b5e7_3a1f0c6d8e29
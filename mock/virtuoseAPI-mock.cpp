@@ -0,0 +1,1081 @@
+/**
+	@file
+	@brief Simulated implementation of the VirtuoseAPI 3.80 entry points,
+	for benchmarking and exercising vpp.h without a Haption device.
+
+	See virtuoseAPI-mock.h for the simulation behavior and the extra
+	control functions.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// We are the "DLL": don't pull in the inline virt* wrappers.
+#define VIRTUOSEAPI_DLLEXPORTS
+
+// Internal Includes
+#include "virtuoseAPI-mock.h"
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#	include <time.h>
+#endif
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	const int functionCount = DEVICEID + 1;
+	const int buttonCount = 8;
+	const int jointCount = 6;
+
+	struct Device {
+		std::mutex mutex;
+		std::atomic<bool> open;
+		int error;
+
+		Clock::time_point openTime;
+		unsigned int timeLastUpdate;
+
+		bool positionOverridden;
+		float position[7];
+		float speed[6];
+		float force[6];
+		float physicalForce[6];
+		float baseFrame[7];
+		float observationFrame[7];
+		float observationFrameSpeed[6];
+		float catchFrame[7];
+		float vmBaseFrame[7];
+		float articularPosition[jointCount];
+		float articularSpeed[jointCount];
+		float articularForce[jointCount];
+		float additionalAxisPosition;
+		float additionalAxisSpeed;
+		float additionalAxisForce;
+		float textureForce[3];
+		float speedControlCenter[3];
+		float axisOfRotation[3];
+
+		int buttons[buttonCount];
+		int powerOn;
+		int forceFeedback;
+		int forceShiftButton;
+		int controlConnexionDisabled;
+		int robotMode;
+		int inSpeedControl;
+		int inRotationSpeedControl;
+		int voAttached;
+		int recording;
+		unsigned int outputs;
+		unsigned short debugFlags;
+
+		float timeStep;
+		float timeoutValue;
+		float forceFactor;
+		float speedFactor;
+		float limitTorque;
+		VirtCommandType commandType;
+		VirtGripperCommandType gripperCommandType;
+		VirtIndexingType indexingMode;
+		VirtVmType vmType;
+
+		VirtPeriodicFunction periodicFunction;
+		void * periodicArg;
+		float periodicStep;
+		std::atomic<bool> loopRunning;
+		std::thread loopThread;
+		std::atomic<unsigned long> ticks;
+	};
+
+	Device devices[VIRT_MOCK_MAX_DEVICES];
+
+	/// Error for calls without a valid context (notably a failed virtOpen).
+	std::atomic<int> globalError(VIRT_E_NO_ERROR);
+
+	std::atomic<unsigned int> callLatencyNs(0);
+	std::atomic<int> injectFunction(VIRT_MOCK_ALL_FUNCTIONS);
+	std::atomic<unsigned int> injectEvery(0);
+	std::atomic<int> injectCode(VIRT_E_COMMUNICATION_FAILURE);
+	std::atomic<unsigned long> injectCounter(0);
+	std::atomic<unsigned long> callCounts[functionCount];
+
+	/// Version reported by virtAPIVersion, major * 1000 + minor.
+	unsigned int apiVersion = 3080;
+
+	const char * const errorMessageText[] = {
+		"No error",
+		"Out of memory",
+		"Communication failure",
+		"Invalid context",
+		"File not found",
+		"Wrong format",
+		"Time out",
+		"Not implemented",
+		"Variable not available",
+		"Incorrect value",
+		"Syntax error",
+		"Hardware error",
+		"Position discontinuity",
+		"Virtuose DLL not found",
+		"Periodic function error",
+		"Performance counter error",
+		"Major/minor version mismatch",
+		"Wrong mode",
+		"Mode not supported",
+		"Call time exceeded",
+		"Incompatible version",
+		"Incorrect VM type",
+		"Unknown error"
+	};
+	const int errorMessageCount = sizeof(errorMessageText) / sizeof(errorMessageText[0]);
+
+	/// Error strings are returned through virtCallDLL's int return value,
+	/// so they have to live at an address that survives the round trip.
+	char * errorMessages[errorMessageCount];
+
+	void setupErrorMessages() {
+		std::size_t total = 0;
+		for (int i = 0; i < errorMessageCount; ++i) {
+			total += std::strlen(errorMessageText[i]) + 1;
+		}
+		char * arena = NULL;
+#if defined(__linux__) && defined(MAP_32BIT)
+		void * mem = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+		if (mem != MAP_FAILED) {
+			arena = static_cast<char *>(mem);
+		}
+#endif
+		if (!arena) {
+			arena = static_cast<char *>(std::malloc(total));
+		}
+		for (int i = 0; i < errorMessageCount; ++i) {
+			std::strcpy(arena, errorMessageText[i]);
+			errorMessages[i] = arena;
+			arena += std::strlen(errorMessageText[i]) + 1;
+		}
+	}
+
+	unsigned int readEnvironment(const char * name, unsigned int fallback) {
+		const char * val = std::getenv(name);
+		return val ? static_cast<unsigned int>(std::strtoul(val, NULL, 0)) : fallback;
+	}
+
+	struct LibraryInit {
+		LibraryInit() {
+			setupErrorMessages();
+			callLatencyNs = readEnvironment("VIRTUOSE_MOCK_LATENCY_NS", 0);
+			injectEvery = readEnvironment("VIRTUOSE_MOCK_ERROR_EVERY", 0);
+			injectCode = static_cast<int>(readEnvironment("VIRTUOSE_MOCK_ERROR_CODE", VIRT_E_COMMUNICATION_FAILURE));
+			apiVersion = readEnvironment("VIRTUOSE_MOCK_API_VERSION", apiVersion);
+		}
+	} libraryInit;
+
+	inline VirtContext handleFor(int index) {
+		return reinterpret_cast<VirtContext>(static_cast<std::intptr_t>(index + 1));
+	}
+
+	inline Device * lookup(VirtContext vc) {
+		std::intptr_t idx = reinterpret_cast<std::intptr_t>(vc) - 1;
+		if (idx < 0 || idx >= VIRT_MOCK_MAX_DEVICES || !devices[idx].open) {
+			return NULL;
+		}
+		return &devices[idx];
+	}
+
+	void spin(unsigned int ns) {
+		Clock::time_point end = Clock::now() + std::chrono::nanoseconds(ns);
+		while (Clock::now() < end) {
+		}
+	}
+
+	void setIdentityDisplacement(float * d) {
+		d[0] = d[1] = d[2] = 0.f;
+		d[3] = d[4] = d[5] = 0.f;
+		d[6] = 1.f;
+	}
+
+	void resetDevice(Device & dev) {
+		dev.error = VIRT_E_NO_ERROR;
+		dev.openTime = Clock::now();
+		dev.timeLastUpdate = 0;
+		dev.positionOverridden = false;
+		setIdentityDisplacement(dev.position);
+		setIdentityDisplacement(dev.baseFrame);
+		setIdentityDisplacement(dev.observationFrame);
+		setIdentityDisplacement(dev.catchFrame);
+		setIdentityDisplacement(dev.vmBaseFrame);
+		for (int i = 0; i < 6; ++i) {
+			dev.speed[i] = dev.force[i] = dev.physicalForce[i] = dev.observationFrameSpeed[i] = 0.f;
+		}
+		for (int i = 0; i < jointCount; ++i) {
+			dev.articularPosition[i] = dev.articularSpeed[i] = dev.articularForce[i] = 0.f;
+		}
+		dev.additionalAxisPosition = dev.additionalAxisSpeed = dev.additionalAxisForce = 0.f;
+		for (int i = 0; i < 3; ++i) {
+			dev.textureForce[i] = dev.speedControlCenter[i] = 0.f;
+			dev.axisOfRotation[i] = (i == 2) ? 1.f : 0.f;
+		}
+		for (int i = 0; i < buttonCount; ++i) {
+			dev.buttons[i] = 0;
+		}
+		dev.powerOn = 0;
+		dev.forceFeedback = 1;
+		dev.forceShiftButton = 0;
+		dev.controlConnexionDisabled = 0;
+		dev.robotMode = 0;
+		dev.inSpeedControl = 0;
+		dev.inRotationSpeedControl = 0;
+		dev.voAttached = 0;
+		dev.recording = 0;
+		dev.outputs = 0;
+		dev.debugFlags = 0;
+		dev.timeStep = 0.001f;
+		dev.timeoutValue = 1.f;
+		dev.forceFactor = 1.f;
+		dev.speedFactor = 1.f;
+		dev.limitTorque = 0.f;
+		dev.commandType = COMMAND_TYPE_NONE;
+		dev.gripperCommandType = GRIPPER_COMMAND_TYPE_NONE;
+		dev.indexingMode = INDEXING_ALL;
+		dev.vmType = VM_TYPE_CartMotion;
+		dev.periodicFunction = NULL;
+		dev.periodicArg = NULL;
+		dev.periodicStep = 0.f;
+		dev.ticks = 0;
+	}
+
+	/// Advance the simulated motion to "now". Caller holds dev.mutex.
+	void updateSimulation(Device & dev) {
+		double t = std::chrono::duration<double>(Clock::now() - dev.openTime).count();
+		dev.timeLastUpdate = static_cast<unsigned int>(t * 1e6);
+		if (dev.positionOverridden) {
+			return;
+		}
+		const double radius = 0.05;
+		const double omega = 2.0 * 3.14159265358979323846 * 0.25;
+		dev.position[0] = static_cast<float>(radius * std::cos(omega * t));
+		dev.position[1] = static_cast<float>(radius * std::sin(omega * t));
+		dev.position[2] = 0.f;
+		dev.speed[0] = static_cast<float>(-radius * omega * std::sin(omega * t));
+		dev.speed[1] = static_cast<float>(radius * omega * std::cos(omega * t));
+		dev.speed[2] = 0.f;
+		for (int i = 0; i < jointCount; ++i) {
+			dev.articularPosition[i] = static_cast<float>(0.1 * std::sin(omega * t + i));
+			dev.articularSpeed[i] = static_cast<float>(0.1 * omega * std::cos(omega * t + i));
+		}
+	}
+
+	void copyOut(float * dst, const float * src, int n) {
+		std::memcpy(dst, src, n * sizeof(float));
+	}
+
+	void copyIn(float * dst, const float * src, int n) {
+		std::memcpy(dst, src, n * sizeof(float));
+	}
+
+	/// d = (tx, ty, tz, qx, qy, qz, qw); m = row-major 4x4.
+	void displacementToMatrix(const float * d, float * m) {
+		float x = d[3], y = d[4], z = d[5], w = d[6];
+		m[0] = 1.f - 2.f * (y * y + z * z);
+		m[1] = 2.f * (x * y - z * w);
+		m[2] = 2.f * (x * z + y * w);
+		m[3] = d[0];
+		m[4] = 2.f * (x * y + z * w);
+		m[5] = 1.f - 2.f * (x * x + z * z);
+		m[6] = 2.f * (y * z - x * w);
+		m[7] = d[1];
+		m[8] = 2.f * (x * z - y * w);
+		m[9] = 2.f * (y * z + x * w);
+		m[10] = 1.f - 2.f * (x * x + y * y);
+		m[11] = d[2];
+		m[12] = m[13] = m[14] = 0.f;
+		m[15] = 1.f;
+	}
+
+	void matrixToDisplacement(const float * m, float * d) {
+		d[0] = m[3];
+		d[1] = m[7];
+		d[2] = m[11];
+		float trace = m[0] + m[5] + m[10];
+		if (trace > 0.f) {
+			float s = 0.5f / std::sqrt(trace + 1.f);
+			d[6] = 0.25f / s;
+			d[3] = (m[9] - m[6]) * s;
+			d[4] = (m[2] - m[8]) * s;
+			d[5] = (m[4] - m[1]) * s;
+		} else if (m[0] > m[5] && m[0] > m[10]) {
+			float s = 2.f * std::sqrt(1.f + m[0] - m[5] - m[10]);
+			d[6] = (m[9] - m[6]) / s;
+			d[3] = 0.25f * s;
+			d[4] = (m[1] + m[4]) / s;
+			d[5] = (m[2] + m[8]) / s;
+		} else if (m[5] > m[10]) {
+			float s = 2.f * std::sqrt(1.f + m[5] - m[0] - m[10]);
+			d[6] = (m[2] - m[8]) / s;
+			d[3] = (m[1] + m[4]) / s;
+			d[4] = 0.25f * s;
+			d[5] = (m[6] + m[9]) / s;
+		} else {
+			float s = 2.f * std::sqrt(1.f + m[10] - m[0] - m[5]);
+			d[6] = (m[4] - m[1]) / s;
+			d[3] = (m[2] + m[8]) / s;
+			d[4] = (m[6] + m[9]) / s;
+			d[5] = 0.25f * s;
+		}
+	}
+
+	void periodicLoop(Device * dev, VirtContext vc) {
+		Clock::time_point next = Clock::now();
+		while (dev->loopRunning) {
+			VirtPeriodicFunction fn;
+			void * arg;
+			float step;
+			{
+				std::lock_guard<std::mutex> lock(dev->mutex);
+				updateSimulation(*dev);
+				fn = dev->periodicFunction;
+				arg = dev->periodicArg;
+				step = dev->periodicStep > 0.f ? dev->periodicStep : dev->timeStep;
+			}
+			if (fn) {
+				fn(vc, arg);
+			}
+			++dev->ticks;
+			next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(step));
+#if defined(__linux__)
+			// steady_clock is CLOCK_MONOTONIC on Linux: sleep to an absolute deadline.
+			std::chrono::nanoseconds sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch());
+			timespec ts;
+			ts.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+			ts.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+			}
+#else
+			std::this_thread::sleep_until(next);
+#endif
+		}
+	}
+
+	void stopLoop(Device & dev) {
+		dev.loopRunning = false;
+		if (dev.loopThread.joinable()) {
+			if (dev.loopThread.get_id() == std::this_thread::get_id()) {
+				// Stopped from inside the periodic function: let it wind down.
+				dev.loopThread.detach();
+			} else {
+				dev.loopThread.join();
+			}
+		}
+	}
+
+	int openDevice() {
+		for (int i = 0; i < VIRT_MOCK_MAX_DEVICES; ++i) {
+			Device & dev = devices[i];
+			std::unique_lock<std::mutex> lock(dev.mutex);
+			if (!dev.open) {
+				resetDevice(dev);
+				dev.open = true;
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	bool shouldInjectError(int fn) {
+		unsigned int every = injectEvery.load(std::memory_order_relaxed);
+		if (every == 0) {
+			return false;
+		}
+		int target = injectFunction.load(std::memory_order_relaxed);
+		if (target != VIRT_MOCK_ALL_FUNCTIONS && target != fn) {
+			return false;
+		}
+		return (++injectCounter % every) == 0;
+	}
+
+	/* Bodies of the calls that also have a direct entry point (see
+	   virtGetEntryPoint), shared with virtCallDLL. Caller holds dev.mutex. */
+	int getPosition(Device & dev, float * pos) {
+		updateSimulation(dev);
+		copyOut(pos, dev.position, 7);
+		return 0;
+	}
+
+	int getSpeed(Device & dev, float * speed) {
+		updateSimulation(dev);
+		copyOut(speed, dev.speed, 6);
+		return 0;
+	}
+
+	int getForce(Device & dev, float * force) {
+		copyOut(force, dev.force, 6);
+		return 0;
+	}
+
+	int setPosition(Device & dev, float * pos) {
+		copyIn(dev.position, pos, 7);
+		dev.positionOverridden = true;
+		return 0;
+	}
+
+	int setSpeed(Device & dev, float * speed) {
+		copyIn(dev.speed, speed, 6);
+		return 0;
+	}
+
+	int setForce(Device & dev, float * force) {
+		copyIn(dev.force, force, 6);
+		return 0;
+	}
+
+	int getButton(Device & dev, int button, int * state) {
+		if (button < 0 || button >= buttonCount) {
+			dev.error = VIRT_E_INCORRECT_VALUE;
+			return -1;
+		}
+		*state = dev.buttons[button];
+		return 0;
+	}
+
+	int getDeadMan(Device &, int * deadMan) {
+		*deadMan = 1;
+		return 0;
+	}
+
+	int getEmergencyStop(Device &, int * emergencyStop) {
+		*emergencyStop = 0;
+		return 0;
+	}
+
+	int getPowerOn(Device & dev, int * power) {
+		*power = dev.powerOn;
+		return 0;
+	}
+
+	int getTimeLastUpdate(Device & dev, unsigned int * time) {
+		*time = dev.timeLastUpdate;
+		return 0;
+	}
+
+	/// Counting and latency, done for every call.
+	void beginCall(int fn) {
+		if (fn >= 0 && fn < functionCount) {
+			callCounts[fn].fetch_add(1, std::memory_order_relaxed);
+		}
+		unsigned int latency = callLatencyNs.load(std::memory_order_relaxed);
+		if (latency) {
+			spin(latency);
+		}
+	}
+
+	/// Resolves the device for a call taking a VirtContext, or returns
+	/// NULL with @a ret set if the call fails before reaching it.
+	Device * beginDeviceCall(int fn, VirtContext vc, int & ret) {
+		Device * dev = lookup(vc);
+		if (!dev) {
+			if (fn == GETERRORCODE) {
+				// Null context: report why the last virtOpen failed.
+				ret = vc ? VIRT_E_INVALID_CONTEXT : globalError.load();
+			} else {
+				globalError = VIRT_E_INVALID_CONTEXT;
+				ret = -1;
+			}
+			return NULL;
+		}
+		if (fn != GETERRORCODE && fn != GETERROR && shouldInjectError(fn)) {
+			std::lock_guard<std::mutex> lock(dev->mutex);
+			dev->error = injectCode.load();
+			ret = -1;
+			return NULL;
+		}
+		return dev;
+	}
+
+	/// Direct entry points: same behaviour as through virtCallDLL, without
+	/// the variadic call and the switch.
+	template<virtDLLFunction Fn, typename A, int (*Body)(Device &, A)>
+	int direct(VirtContext vc, A a) {
+		beginCall(Fn);
+		int ret;
+		Device * dev = beginDeviceCall(Fn, vc, ret);
+		if (!dev) {
+			return ret;
+		}
+		std::lock_guard<std::mutex> lock(dev->mutex);
+		return Body(*dev, a);
+	}
+
+	template<virtDLLFunction Fn, typename A, typename B, int (*Body)(Device &, A, B)>
+	int direct(VirtContext vc, A a, B b) {
+		beginCall(Fn);
+		int ret;
+		Device * dev = beginDeviceCall(Fn, vc, ret);
+		if (!dev) {
+			return ret;
+		}
+		std::lock_guard<std::mutex> lock(dev->mutex);
+		return Body(*dev, a, b);
+	}
+
+	template<typename F>
+	VirtMockEntryPoint entryPoint(F f) {
+		return reinterpret_cast<VirtMockEntryPoint>(f);
+	}
+
+	/// Calls that take a VirtContext as their first argument.
+	int deviceCall(virtDLLFunction fn, Device & dev, VirtContext vc, va_list args) {
+		std::unique_lock<std::mutex> lock(dev.mutex);
+		switch (fn) {
+			case CLOSE:
+				lock.unlock();
+				stopLoop(dev);
+				lock.lock();
+				dev.open = false;
+				return 0;
+
+			/* Pose and motion getters */
+			case GETPOSITION:
+			case PHYSICALPOSITION:
+			case AVATARPOSITION:
+				return getPosition(dev, va_arg(args, float *));
+			case GETSPEED:
+			case PHYSICALSPEED:
+				return getSpeed(dev, va_arg(args, float *));
+			case GETFORCE:
+				return getForce(dev, va_arg(args, float *));
+			case GETARTICULARPOSITION:
+				updateSimulation(dev);
+				copyOut(va_arg(args, float *), dev.articularPosition, jointCount);
+				return 0;
+			case GETARTICULARSPEED:
+				updateSimulation(dev);
+				copyOut(va_arg(args, float *), dev.articularSpeed, jointCount);
+				return 0;
+			case GETARTICULARPOSITIONOFADDITIONALAXE:
+				*va_arg(args, float *) = dev.additionalAxisPosition;
+				return 0;
+			case GETARTICULARSPEEDOFADDITIONALAXE:
+				*va_arg(args, float *) = dev.additionalAxisSpeed;
+				return 0;
+			case GETBASEFRAME:
+				copyOut(va_arg(args, float *), dev.baseFrame, 7);
+				return 0;
+			case GETOBSERVATIONFRAME:
+				copyOut(va_arg(args, float *), dev.observationFrame, 7);
+				return 0;
+			case GETCATCHFRAME:
+				copyOut(va_arg(args, float *), dev.catchFrame, 7);
+				return 0;
+			case VMGETBASEFRAME:
+				copyOut(va_arg(args, float *), dev.vmBaseFrame, 7);
+				return 0;
+			case CENTERSPEEDCONTROL:
+				copyOut(va_arg(args, float *), dev.speedControlCenter, 3);
+				return 0;
+			case AXEROTATION:
+				copyOut(va_arg(args, float *), dev.axisOfRotation, 3);
+				return 0;
+			case GETADC:
+				va_arg(args, int *);
+				*va_arg(args, float *) = 0.f;
+				return 0;
+
+			/* Pose and motion setters */
+			case SETPOSITION:
+				return setPosition(dev, va_arg(args, float *));
+			case SETSPEED:
+				return setSpeed(dev, va_arg(args, float *));
+			case SETFORCE:
+				return setForce(dev, va_arg(args, float *));
+			case ADDPHYSICALFORCE:
+				copyIn(dev.physicalForce, va_arg(args, float *), 6);
+				return 0;
+			case SETBASEFRAME:
+				copyIn(dev.baseFrame, va_arg(args, float *), 7);
+				return 0;
+			case SETOBSERVATIONFRAME:
+				copyIn(dev.observationFrame, va_arg(args, float *), 7);
+				return 0;
+			case SETOBSERVATIONFRAMESPEED:
+				copyIn(dev.observationFrameSpeed, va_arg(args, float *), 6);
+				return 0;
+			case SETCATCHFRAME:
+				copyIn(dev.catchFrame, va_arg(args, float *), 7);
+				return 0;
+			case VMSETBASEFRAME:
+				copyIn(dev.vmBaseFrame, va_arg(args, float *), 7);
+				return 0;
+			case VMSETBASEFRAMETOCURRENTFRAME:
+				updateSimulation(dev);
+				copyIn(dev.vmBaseFrame, dev.position, 7);
+				return 0;
+			case SETABSOLUTEPOSITION:
+				copyIn(dev.position, va_arg(args, float *), 7);
+				dev.positionOverridden = true;
+				return 0;
+			case SETARTICULARPOSITION:
+				copyIn(dev.articularPosition, va_arg(args, float *), jointCount);
+				return 0;
+			case SETARTICULARSPEED:
+				copyIn(dev.articularSpeed, va_arg(args, float *), jointCount);
+				return 0;
+			case SETARTICULARFORCE:
+				copyIn(dev.articularForce, va_arg(args, float *), jointCount);
+				return 0;
+			case SETARTICULARPOSITIONOFADDITIONALAXE:
+				dev.additionalAxisPosition = *va_arg(args, float *);
+				return 0;
+			case SETARTICULARSPEEDOFADDITIONALAXE:
+				dev.additionalAxisSpeed = *va_arg(args, float *);
+				return 0;
+			case SETARTICULARFORCEOFADDITIONALAXE:
+				dev.additionalAxisForce = *va_arg(args, float *);
+				return 0;
+			case SETTEXTURE:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				va_arg(args, int *);
+				return 0;
+			case SETTEXTUREFORCE:
+				copyIn(dev.textureForce, va_arg(args, float *), 3);
+				return 0;
+			case FRICTION:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				va_arg(args, float *);
+				return 0;
+
+			/* Scalar state */
+			case GETBUTTON: {
+				int button = *va_arg(args, int *);
+				return getButton(dev, button, va_arg(args, int *));
+			}
+			case GETDEADMAN:
+				return getDeadMan(dev, va_arg(args, int *));
+			case GETEMERGENCYSTOP:
+				return getEmergencyStop(dev, va_arg(args, int *));
+			case GETPOWERON:
+				return getPowerOn(dev, va_arg(args, int *));
+			case SETPOWERON:
+				dev.powerOn = *va_arg(args, int *);
+				return 0;
+			case GETTIMELASTUPDATE:
+				return getTimeLastUpdate(dev, va_arg(args, unsigned int *));
+			case GETERROR:
+				*va_arg(args, int *) = dev.error;
+				return 0;
+			case GETERRORCODE:
+				return dev.error;
+			case GETCOMMANDTYPE:
+				*va_arg(args, VirtCommandType *) = dev.commandType;
+				return 0;
+			case SETCOMMANDTYPE:
+				dev.commandType = *va_arg(args, VirtCommandType *);
+				return 0;
+			case SETGRIPPERCOMMANDTYPE:
+				dev.gripperCommandType = *va_arg(args, VirtGripperCommandType *);
+				return 0;
+			case GETINDEXINGMODE:
+				*va_arg(args, VirtIndexingType *) = dev.indexingMode;
+				return 0;
+			case SETINDEXINGMODE:
+				dev.indexingMode = *va_arg(args, VirtIndexingType *);
+				return 0;
+			case GETFORCEFACTOR:
+				*va_arg(args, float *) = dev.forceFactor;
+				return 0;
+			case SETFORCEFACTOR:
+				dev.forceFactor = *va_arg(args, float *);
+				return 0;
+			case GETSPEEDFACTOR:
+				*va_arg(args, float *) = dev.speedFactor;
+				return 0;
+			case SETSPEEDFACTOR:
+				dev.speedFactor = *va_arg(args, float *);
+				return 0;
+			case GETTIMEOUTVALUE:
+				*va_arg(args, float *) = dev.timeoutValue;
+				return 0;
+			case SETTIMEOUTVALUE:
+				dev.timeoutValue = *va_arg(args, float *);
+				return 0;
+			case GETTIMESTEP:
+				*va_arg(args, float *) = dev.timeStep;
+				return 0;
+			case SETTIMESTEP: {
+				float step = *va_arg(args, float *);
+				if (!(step > 0.f)) {
+					dev.error = VIRT_E_INCORRECT_VALUE;
+					return -1;
+				}
+				dev.timeStep = step;
+				return 0;
+			}
+			case GETLIMITTORQUE:
+				*va_arg(args, float *) = dev.limitTorque;
+				return 0;
+			case SETLIMITTORQUE:
+				dev.limitTorque = *va_arg(args, float *);
+				return 0;
+			case SATURATETORQUE:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				return 0;
+			case SETDEBUGFLAGS:
+				dev.debugFlags = *va_arg(args, unsigned short *);
+				return 0;
+			case ENABLEFORCEFEEDBACK:
+				dev.forceFeedback = *va_arg(args, int *);
+				return 0;
+			case FORCESHIFTBUTTON:
+				dev.forceShiftButton = *va_arg(args, int *);
+				return 0;
+			case DISABLECONTROLCONNEXION:
+				dev.controlConnexionDisabled = *va_arg(args, int *);
+				return 0;
+			case BEEPONLIMIT:
+				va_arg(args, int *);
+				return 0;
+			case OUTPUTSSETTING:
+				dev.outputs = *va_arg(args, unsigned int *);
+				return 0;
+			case ALARM:
+			case BREAKDOWN:
+			case BOUNDS:
+				*va_arg(args, unsigned int *) = 0;
+				return 0;
+			case SHIFTPOSITION:
+				*va_arg(args, int *) = 0;
+				return 0;
+			case ISINSPEEDCONTROL:
+				*va_arg(args, int *) = dev.inSpeedControl;
+				*va_arg(args, int *) = dev.inRotationSpeedControl;
+				return 0;
+			case MOUSE:
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				return 0;
+			case GETTRACKBALL:
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				return 0;
+			case GETTRACKBALLBUTTON:
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = 0;
+				return 0;
+			case CONTROLERVERSION:
+				*va_arg(args, int *) = 3;
+				*va_arg(args, int *) = 80;
+				return 0;
+			case DEVICEID:
+				*va_arg(args, int *) = 0;
+				*va_arg(args, int *) = static_cast<int>(&dev - devices);
+				return 0;
+
+			/* Speed control */
+			case ACTIVESPEEDCONTROL:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				dev.inSpeedControl = 1;
+				return 0;
+			case DESACTIVESPEEDCONTROL:
+				dev.inSpeedControl = 0;
+				return 0;
+			case ACTIVEROTATIONSPEEDCONTROL:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				dev.inRotationSpeedControl = 1;
+				return 0;
+			case DESACTIVEROTATIONSPEEDCONTROL:
+				dev.inRotationSpeedControl = 0;
+				return 0;
+			case FORCEINSPEEDCONTROL:
+			case TORQUEINSPEEDCONTROL:
+				va_arg(args, float *);
+				return 0;
+
+			/* Virtual objects */
+			case ATTACHVO:
+			case ATTACHVOAVATAR:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				dev.voAttached = 1;
+				return 0;
+			case ATTACHQSVO:
+				va_arg(args, float *);
+				va_arg(args, float *);
+				dev.voAttached = 1;
+				return 0;
+			case DETACHVO:
+			case DETACHVOAVATAR:
+				dev.voAttached = 0;
+				return 0;
+
+			/* Virtual mechanisms and trajectories */
+			case VMSETTYPE:
+				dev.vmType = *va_arg(args, VirtVmType *);
+				return 0;
+			case VMSETROBOTMODE:
+				dev.robotMode = *va_arg(args, int *);
+				return 0;
+			case VMSETMAXBOUNDS:
+			case VMSETMINBOUNDS:
+			case VMPARAMETERTYPE:
+				va_arg(args, void *);
+				return 0;
+			case VMACTIVATE:
+			case VMDEACTIVATE:
+			case VMSETCARTESIANPOSITION:
+			case VMSETTRANSPARENTMODE:
+			case VMUPPERBOUND:
+			case WAITFORSYNCH:
+			case DEBUGFILE:
+				return 0;
+			case VMSAVESPLINE:
+			case VMLOADSPLINE:
+			case VMDELETESPLINE:
+			case SETOUTPUTFILE:
+				va_arg(args, char *);
+				return 0;
+			case TRAJRECORDSTART:
+				dev.recording = 1;
+				return 0;
+			case TRAJRECORDSTOP:
+				dev.recording = 0;
+				return 0;
+			case TRAJTIMESTEP:
+				va_arg(args, float *);
+				*va_arg(args, unsigned int *) = 0;
+				return 0;
+			case STARTTRAJSAMPLING:
+				va_arg(args, unsigned int *);
+				return 0;
+			case TRAJSAMPLES:
+				va_arg(args, float *);
+				return 0;
+
+			/* Misc */
+			case DEPLTOMATRIX: {
+				float * d = va_arg(args, float *);
+				float * m = va_arg(args, float *);
+				displacementToMatrix(d, m);
+				return 0;
+			}
+			case MATRIXTODEPL: {
+				float * d = va_arg(args, float *);
+				float * m = va_arg(args, float *);
+				matrixToDisplacement(m, d);
+				return 0;
+			}
+			case RGBTOGRAYSCALE: {
+				float * rgb = va_arg(args, float *);
+				float * gray = va_arg(args, float *);
+				*gray = 0.299f * rgb[0] + 0.587f * rgb[1] + 0.114f * rgb[2];
+				return 0;
+			}
+			case DISPLAYHARDWARESTATUS: {
+				FILE * fh = va_arg(args, FILE *);
+				if (fh) {
+					std::fprintf(fh, "Simulated Virtuose (mock VirtuoseAPI 3.80): power %s, %lu ticks\n",
+					             dev.powerOn ? "on" : "off", dev.ticks.load());
+				}
+				return 0;
+			}
+			case WAITBUTTON: {
+				int button = *va_arg(args, int *);
+				if (button < 0 || button >= buttonCount) {
+					dev.error = VIRT_E_INCORRECT_VALUE;
+					return -1;
+				}
+				while (!dev.buttons[button]) {
+					lock.unlock();
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					lock.lock();
+				}
+				return 0;
+			}
+
+			/* Periodic function */
+			case SETPERIODICFUNCTION: {
+				dev.periodicFunction = va_arg(args, VirtPeriodicFunction);
+				float * period = va_arg(args, float *);
+				dev.periodicArg = va_arg(args, void *);
+				dev.periodicStep = period ? *period : 0.f;
+				return 0;
+			}
+			case STARTLOOP:
+				if (dev.loopRunning) {
+					return 0;
+				}
+				if (dev.loopThread.joinable()) {
+					dev.loopThread.join();
+				}
+				dev.loopRunning = true;
+				dev.loopThread = std::thread(periodicLoop, &dev, vc);
+				return 0;
+			case STOPLOOP:
+				lock.unlock();
+				stopLoop(dev);
+				return 0;
+
+			default:
+				dev.error = VIRT_E_NOT_IMPLEMENTED;
+				return -1;
+		}
+	}
+} // end of anonymous namespace
+
+extern "C" int virtCallDLL(virtDLLFunction fn, ...) {
+	beginCall(fn);
+
+	va_list args;
+	va_start(args, fn);
+	int ret = 0;
+	switch (fn) {
+		case APIVERSION:
+			*va_arg(args, int *) = static_cast<int>(apiVersion / 1000);
+			*va_arg(args, int *) = static_cast<int>(apiVersion % 1000);
+			break;
+		case GETERRORMESSAGE: {
+			int code = *va_arg(args, int *);
+			if (code < 0 || code >= errorMessageCount) {
+				code = errorMessageCount - 1;
+			}
+			ret = static_cast<int>(reinterpret_cast<std::intptr_t>(errorMessages[code]));
+			break;
+		}
+		case OPEN: {
+			va_arg(args, const char *);
+			int idx = -1;
+			if (shouldInjectError(fn)) {
+				globalError = injectCode.load();
+			} else {
+				idx = openDevice();
+				globalError = (idx < 0) ? VIRT_E_OUT_OF_MEMORY : VIRT_E_NO_ERROR;
+			}
+			ret = (idx < 0) ? 0 : static_cast<int>(reinterpret_cast<std::intptr_t>(handleFor(idx)));
+			break;
+		}
+		default: {
+			VirtContext vc = va_arg(args, VirtContext);
+			Device * dev = beginDeviceCall(fn, vc, ret);
+			if (dev) {
+				ret = deviceCall(fn, *dev, vc, args);
+			}
+			break;
+		}
+	}
+	va_end(args);
+	return ret;
+}
+
+extern "C" VirtMockEntryPoint virtGetEntryPoint(int function) {
+	switch (function) {
+		case GETPOSITION:
+			return entryPoint(&direct<GETPOSITION, float *, getPosition>);
+		case GETSPEED:
+			return entryPoint(&direct<GETSPEED, float *, getSpeed>);
+		case GETFORCE:
+			return entryPoint(&direct<GETFORCE, float *, getForce>);
+		case SETPOSITION:
+			return entryPoint(&direct<SETPOSITION, float *, setPosition>);
+		case SETSPEED:
+			return entryPoint(&direct<SETSPEED, float *, setSpeed>);
+		case SETFORCE:
+			return entryPoint(&direct<SETFORCE, float *, setForce>);
+		case GETBUTTON:
+			return entryPoint(&direct<GETBUTTON, int, int *, getButton>);
+		case GETDEADMAN:
+			return entryPoint(&direct<GETDEADMAN, int *, getDeadMan>);
+		case GETEMERGENCYSTOP:
+			return entryPoint(&direct<GETEMERGENCYSTOP, int *, getEmergencyStop>);
+		case GETPOWERON:
+			return entryPoint(&direct<GETPOWERON, int *, getPowerOn>);
+		case GETTIMELASTUPDATE:
+			return entryPoint(&direct<GETTIMELASTUPDATE, unsigned int *, getTimeLastUpdate>);
+		default:
+			return NULL;
+	}
+}
+
+extern "C" int virtLoadDLL(char *) {
+	// Nothing to load: we are the implementation.
+	return 0;
+}
+
+extern "C" void virtMockSetCallLatency(unsigned int nanoseconds) {
+	callLatencyNs = nanoseconds;
+}
+
+extern "C" void virtMockInjectError(int function, unsigned int every, int code) {
+	injectFunction = function;
+	injectCode = code;
+	injectCounter = 0;
+	injectEvery = every;
+}
+
+extern "C" unsigned long virtMockGetCallCount(int function) {
+	if (function == VIRT_MOCK_ALL_FUNCTIONS) {
+		unsigned long total = 0;
+		for (int i = 0; i < functionCount; ++i) {
+			total += callCounts[i].load();
+		}
+		return total;
+	}
+	if (function < 0 || function >= functionCount) {
+		return 0;
+	}
+	return callCounts[function].load();
+}
+
+extern "C" void virtMockResetCallCounts(void) {
+	for (int i = 0; i < functionCount; ++i) {
+		callCounts[i] = 0;
+	}
+}
+
+extern "C" int virtMockSetPosition(VirtContext VC, const float * pos) {
+	Device * dev = lookup(VC);
+	if (!dev) {
+		return -1;
+	}
+	std::lock_guard<std::mutex> lock(dev->mutex);
+	dev->positionOverridden = (pos != NULL);
+	if (pos) {
+		copyIn(dev->position, pos, 7);
+	}
+	return 0;
+}
+
+extern "C" int virtMockSetButton(VirtContext VC, int button_number, int state) {
+	Device * dev = lookup(VC);
+	if (!dev || button_number < 0 || button_number >= buttonCount) {
+		return -1;
+	}
+	std::lock_guard<std::mutex> lock(dev->mutex);
+	dev->buttons[button_number] = state;
+	return 0;
+}
+
+extern "C" unsigned long virtMockGetTickCount(VirtContext VC) {
+	Device * dev = lookup(VC);
+	return dev ? dev->ticks.load() : 0;
+}
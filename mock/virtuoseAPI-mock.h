@@ -0,0 +1,102 @@
+/**
+	@file
+	@brief Control interface for the simulated VirtuoseAPI backend
+	(libvirtuoseapi-mock).
+
+	The mock library exports virtCallDLL and virtLoadDLL, so a program
+	built against the 3.80 virtuoseAPI.h (directly or through vpp.h) runs
+	unchanged against it when linked with -lvirtuoseapi-mock instead of
+	the vendor library. The functions declared here are extras that only
+	the mock provides, for configuring latency and error injection and
+	for driving simulated inputs from a test or benchmark.
+
+	Simulation behavior:
+	- Each virtOpen returns a new simulated device (up to
+	  VIRT_MOCK_MAX_DEVICES at once); the name is ignored.
+	- The position follows a slow circle in the XY plane unless
+	  overridden with virtMockSetPosition; the speed is its derivative.
+	- Forces and other commanded values are stored and read back.
+	- virtStartLoop runs the periodic function on its own thread every
+	  time step (virtSetTimeStep, default 1 ms), using absolute deadlines.
+	- virtGetTimeLastUpdate reports microseconds since the device was
+	  opened, as of the most recent simulation update.
+
+	The same knobs can be set without code changes through environment
+	variables read when the library is loaded:
+	VIRTUOSE_MOCK_LATENCY_NS, VIRTUOSE_MOCK_ERROR_EVERY and
+	VIRTUOSE_MOCK_ERROR_CODE. VIRTUOSE_MOCK_API_VERSION (major * 1000 +
+	minor, default 3080) changes the version virtAPIVersion reports, to
+	exercise the runtime-loaded backend's handling of older versions.
+
+	Only the 3.80 function numbering is implemented. Since virtCallDLL
+	returns pointers (the VirtContext, error strings) through an int,
+	error strings are placed in the low 2GB of the address space on
+	x86-64 Linux, and VirtContext values are small integer handles.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_virtuoseAPI_mock_h_GUID_5b3c1e0a_8a4f_4d0e_9d2c_6e7f1a2b3c4d
+#define INCLUDED_virtuoseAPI_mock_h_GUID_5b3c1e0a_8a4f_4d0e_9d2c_6e7f1a2b3c4d
+
+// Internal Includes
+// none
+
+// Library/third-party includes
+#include <virtuoseAPI.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/** @brief Maximum number of simultaneously-open simulated devices. */
+#define VIRT_MOCK_MAX_DEVICES 16
+
+/** @brief Pass as a function to apply a setting to every function. */
+#define VIRT_MOCK_ALL_FUNCTIONS -1
+
+/** @brief Busy-wait this long inside every virtCallDLL call, to model
+	the cost of the vendor library and its communication. */
+void virtMockSetCallLatency(unsigned int nanoseconds);
+
+/** @brief Make every Nth call of the given function (or of any function,
+	with VIRT_MOCK_ALL_FUNCTIONS) fail with the given error code.
+	Pass every = 0 to disable injection again. */
+void virtMockInjectError(int function, unsigned int every, int code);
+
+/** @brief Number of virtCallDLL calls made for the given function (or
+	for all functions) since load or the last virtMockResetCallCounts. */
+unsigned long virtMockGetCallCount(int function);
+
+/** @brief Zero the counters reported by virtMockGetCallCount. */
+void virtMockResetCallCounts(void);
+
+/** @brief Override the simulated position (7 floats: translation and
+	quaternion x, y, z, w). Pass NULL to return to the built-in motion. */
+int virtMockSetPosition(VirtContext VC, const float *pos);
+
+/** @brief Set the state of a simulated button. */
+int virtMockSetButton(VirtContext VC, int button_number, int state);
+
+/** @brief Number of times the periodic function has been called. */
+unsigned long virtMockGetTickCount(VirtContext VC);
+
+/** @brief Generic function pointer type returned by virtGetEntryPoint. */
+typedef void (*VirtMockEntryPoint)(void);
+
+/** @brief Direct entry point for a function, with the signature of the
+	VirtuoseAPI's inline wrapper for it (e.g. virtGetPosition for
+	GETPOSITION), or NULL. Provided for the hot getters and setters; used
+	by vpp.h when VPP_DIRECT_DISPATCH is defined. Calls made this way are
+	counted, delayed and failed just like calls through virtCallDLL. */
+VirtMockEntryPoint virtGetEntryPoint(int function);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif // INCLUDED_virtuoseAPI_mock_h_GUID_5b3c1e0a_8a4f_4d0e_9d2c_6e7f1a2b3c4d
@@ -0,0 +1,900 @@
+/**
+	@file
+	@brief Runtime-loaded stand-in for the VirtuoseAPI header, so one
+	binary can run against any supported VirtuoseAPI version.
+
+	Generated from the VirtuoseAPI headers of versions
+	3.10 to 3.80.
+
+	It declares every function of all of those versions, with the names
+	and signatures of the vendor's inline functions, but they call the
+	virtCallDLL of a library loaded at runtime by VirtuoseRuntime::load(),
+	translated through a table for the version that library reports.
+	The version is checked once, at load: each call just looks up its
+	function number in the table, and functions the loaded version
+	doesn't have fail with VIRT_E_NOT_IMPLEMENTED without calling it.
+
+	The vpp.h next to this header wraps it just like the per-version
+	headers do. Types, enums and error codes are those of the newest
+	version, which are a superset of the older ones. Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
+#define INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
+
+#if __cplusplus < 201103L
+#	error "The runtime-loaded VirtuoseAPI backend requires C++11"
+#endif
+
+#ifdef VPP_DIRECT_DISPATCH
+#	error "VPP_DIRECT_DISPATCH is not supported with the runtime-loaded VirtuoseAPI backend"
+#endif
+
+/// @brief Defined when vpp.h wraps the runtime-loaded backend.
+#define VPP_RUNTIME_BACKEND
+
+// Internal Includes
+// none
+
+// Library/third-party includes
+
+// Types, enums and error codes only: the inline functions of this header
+// use its own function numbering, so they are left out.
+#ifndef VIRTUOSEAPI_DLLEXPORTS
+#	define VIRTUOSEAPI_DLLEXPORTS
+#	define VPP_RUNTIME_UNDEF_DLLEXPORTS
+#endif
+#include "../3.80/virtuoseAPI.h"
+#ifdef VPP_RUNTIME_UNDEF_DLLEXPORTS
+#	undef VIRTUOSEAPI_DLLEXPORTS
+#	undef VPP_RUNTIME_UNDEF_DLLEXPORTS
+#endif
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <dlfcn.h>
+#endif
+
+namespace vpp_runtime {
+	/// @brief Every virtDLLFunction used by any supported version.
+	enum Function {
+		APIVERSION,
+		ATTACHVO,
+		ATTACHQSVO,
+		ATTACHVOAVATAR,
+		CLOSE,
+		DETACHVO,
+		DETACHVOAVATAR,
+		DISPLAYHARDWARESTATUS,
+		GETCATCHFRAME,
+		GETBASEFRAME,
+		GETBUTTON,
+		GETCOMMANDTYPE,
+		GETDEADMAN,
+		GETEMERGENCYSTOP,
+		GETERROR,
+		GETERRORCODE,
+		GETERRORMESSAGE,
+		GETFORCE,
+		GETFORCEFACTOR,
+		GETINDEXINGMODE,
+		GETLIMITTORQUE,
+		GETOBSERVATIONFRAME,
+		GETPOSITION,
+		GETPOWERON,
+		GETSPEED,
+		GETSPEEDFACTOR,
+		GETTIMELASTUPDATE,
+		GETTIMEOUTVALUE,
+		OPEN,
+		SETCATCHFRAME,
+		SETBASEFRAME,
+		SETCOMMANDTYPE,
+		SETDEBUGFLAGS,
+		SETFORCE,
+		SETFORCEFACTOR,
+		SETINDEXINGMODE,
+		SETLIMITTORQUE,
+		SETOBSERVATIONFRAME,
+		SETOBSERVATIONFRAMESPEED,
+		SETOUTPUTFILE,
+		SETPERIODICFUNCTION,
+		SETPOSITION,
+		SETPOWERON,
+		SETSPEED,
+		SETSPEEDFACTOR,
+		SETTEXTURE,
+		SETTEXTUREFORCE,
+		SETTIMEOUTVALUE,
+		SETTIMESTEP,
+		STARTLOOP,
+		STOPLOOP,
+		WAITFORSYNCH,
+		TRAJRECORDSTART,
+		TRAJRECORDSTOP,
+		TRAJSAMPLES,
+		TRAJTIMESTEP,
+		VMSETTYPE,
+		VMACTIVATE,
+		VMDEACTIVATE,
+		VMSETMAXBOUNDS,
+		VMSETMINBOUNDS,
+		VMSETBASEFRAME,
+		STARTTRAJSAMPLING,
+		SATURATETORQUE,
+		PHYSICALPOSITION,
+		AVATARPOSITION,
+		VMSETTRANSPARENTMODE,
+		VMSETCARTESIANPOSITION,
+		VMSETBASEFRAMETOCURRENTFRAME,
+		RGBTOGRAYSCALE,
+		VMGETBASEFRAME,
+		WAITBUTTON,
+		GETTIMESTEP,
+		VMSETROBOTMODE,
+		VMSAVESPLINE,
+		VMLOADSPLINE,
+		VMDELETESPLINE,
+		VMUPPERBOUND,
+		DISABLECONTROLCONNEXION,
+		BOUNDS,
+		ALARM,
+		ACTIVESPEEDCONTROL,
+		DESACTIVESPEEDCONTROL,
+		SHIFTPOSITION,
+		FRICTION,
+		MOUSE,
+		DEBUGFILE,
+		CENTERSPEEDCONTROL,
+		DEPLTOMATRIX,
+		MATRIXTODEPL,
+		AXEROTATION,
+		GETADC,
+		GETTRACKBALL,
+		GETTRACKBALLBUTTON,
+		SETABSOLUTEPOSITION,
+		BEEPONLIMIT,
+		ENABLEFORCEFEEDBACK,
+		PHYSICALSPEED,
+		FORCESHIFTBUTTON,
+		ADDPHYSICALFORCE,
+		BREAKDOWN,
+		SETARTICULARPOSITIONOFADDITIONALAXE,
+		GETARTICULARPOSITIONOFADDITIONALAXE,
+		SETARTICULARSPEEDOFADDITIONALAXE,
+		GETARTICULARSPEEDOFADDITIONALAXE,
+		SETARTICULARFORCEOFADDITIONALAXE,
+		SETARTICULARPOSITION,
+		GETARTICULARPOSITION,
+		SETARTICULARSPEED,
+		GETARTICULARSPEED,
+		SETARTICULARFORCE,
+		ACTIVEROTATIONSPEEDCONTROL,
+		DESACTIVEROTATIONSPEEDCONTROL,
+		CONTROLERVERSION,
+		ISINSPEEDCONTROL,
+		FORCEINSPEEDCONTROL,
+		TORQUEINSPEEDCONTROL,
+		SETGRIPPERCOMMANDTYPE,
+		OUTPUTSSETTING,
+		DEVICEID,
+		FUNCTION_COUNT
+	};
+
+	/// @brief How one version numbers the functions it has.
+	struct VersionTable {
+		/// Major version multiplied by 1000, plus minor version.
+		int version;
+		/// True if that version's virtCallDLL returns size_t rather than int.
+		bool wideReturn;
+		/// That version's virtDLLFunction value for each Function, or -1.
+		short functions[FUNCTION_COUNT];
+	};
+
+	enum {
+		VERSION_TABLE_COUNT = 5
+	};
+
+	/// @brief The tables for all supported versions, oldest first.
+	inline VersionTable const * versionTables() {
+		static const VersionTable tables[VERSION_TABLE_COUNT] = {
+			{ 3010, false, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 } },
+			{ 3020, false, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 } },
+			{ 3060, true, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, -1, -1, -1 } },
+			{ 3070, false, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, -1 } },
+			{ 3080, false, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, -1, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, -1, 52, 53, 54, 55, 56, 58, 59, -1, -1, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 83, 84, 85, -1, 87, -1, 89, 90, 91, 92, 93, 94, 95, -1, -1, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121 } }
+		};
+		return tables;
+	}
+} // end of namespace vpp_runtime
+
+/** @brief Loads the VirtuoseAPI library at runtime, and performs the
+	calls of the functions declared in this header.
+
+	@code
+	if (!VirtuoseRuntime::load("libvirtuose.so")) {
+		std::cerr << VirtuoseRuntime::loadError() << std::endl;
+		return 1;
+	}
+	if (VirtuoseRuntime::has(vpp_runtime::GETARTICULARPOSITION)) { ... }
+	@endcode
+*/
+class VirtuoseRuntime {
+	public:
+		typedef int (*CallDLL)(int, ...);
+		typedef std::size_t (*WideCallDLL)(int, ...);
+		typedef int (*LoadDLL)(char *);
+
+		/** @brief Loads the library exporting virtCallDLL, asks it for its
+			version with virtAPIVersion() and picks the function table of
+			the newest supported version that is not newer.
+
+			Call once at startup, from one thread, before anything else
+			in this header: the table is not synchronized.
+
+			@param library Shared library to load (the vendor's, or the mock).
+			@param dll If not NULL, passed to the library's virtLoadDLL()
+			first, for libraries that in turn load the device DLL.
+			@returns true on success, otherwise see loadError().
+		*/
+		static bool load(const char * library, const char * dll = NULL);
+
+		static bool isLoaded() {
+			return _table().call != NULL;
+		}
+
+		/// @brief Version reported by the library, major * 1000 + minor, or 0.
+		static int apiVersion() {
+			return _table().apiVersion;
+		}
+
+		/// @brief Version whose function table is used, which is
+		/// apiVersion() unless that version is not known to this header.
+		static int tableVersion() {
+			return _table().tableVersion;
+		}
+
+		/// @brief Whether the loaded version has a function.
+		static bool has(vpp_runtime::Function fn) {
+			return _table().slots[fn] != 0;
+		}
+
+		/// @brief Why the last load() failed.
+		static std::string const& loadError() {
+			return _loadError();
+		}
+
+		/// @brief Calls a function returning int.
+		template<typename... Args>
+		static int call(vpp_runtime::Function fn, Args... args) {
+			Table const& t = _table();
+			int slot = t.slots[fn];
+			if (slot == 0 || (fn == vpp_runtime::GETERRORCODE && _pendingError() != VIRT_E_NO_ERROR)) {
+				return _absent(fn);
+			}
+			return t.call(slot - 1, args...);
+		}
+
+		/// @brief Calls a function returning a pointer through virtCallDLL.
+		template<typename... Args>
+		static void * callPointer(vpp_runtime::Function fn, Args... args) {
+			Table const& t = _table();
+			int slot = t.slots[fn];
+			if (slot == 0) {
+				_absent(fn);
+				return NULL;
+			}
+			if (t.wideCall) {
+				return reinterpret_cast<void *>(t.wideCall(slot - 1, args...));
+			}
+			return reinterpret_cast<void *>(static_cast<std::intptr_t>(t.call(slot - 1, args...)));
+		}
+
+	private:
+		struct Table {
+			CallDLL call;
+			/// The same function, if its return value is wide enough for
+			/// pointers, otherwise NULL.
+			WideCallDLL wideCall;
+			int apiVersion;
+			int tableVersion;
+			/// 0 if absent, else the version's virtDLLFunction value plus one,
+			/// so the zero-initialized table means "nothing loaded".
+			short slots[vpp_runtime::FUNCTION_COUNT];
+		};
+
+		static Table & _table() {
+			static Table table;
+			return table;
+		}
+
+		/// @brief Error of the last call this thread made to a missing
+		/// function, reported by the next virtGetErrorCode().
+		static int & _pendingError() {
+			static thread_local int error = VIRT_E_NO_ERROR;
+			return error;
+		}
+
+		static int _absent(vpp_runtime::Function fn) {
+			if (fn == vpp_runtime::GETERRORCODE) {
+				int error = _pendingError();
+				_pendingError() = VIRT_E_NO_ERROR;
+				if (error == VIRT_E_NO_ERROR && !isLoaded()) {
+					error = VIRT_E_VIRTUOSE_DLL_NOT_FOUND;
+				}
+				return error;
+			}
+			_pendingError() = isLoaded() ? VIRT_E_NOT_IMPLEMENTED : VIRT_E_VIRTUOSE_DLL_NOT_FOUND;
+			return -1;
+		}
+
+		static std::string & _loadError() {
+			static std::string error;
+			return error;
+		}
+
+		static bool _fail(std::string const& why) {
+			_loadError() = why;
+			return false;
+		}
+
+		template<typename F>
+		static F _symbol(void * library, const char * name) {
+#if defined(_WIN32)
+			return reinterpret_cast<F>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+			return reinterpret_cast<F>(dlsym(library, name));
+#endif
+		}
+};
+
+inline bool VirtuoseRuntime::load(const char * library, const char * dll) {
+#if defined(_WIN32)
+	void * handle = LoadLibraryA(library);
+	if (!handle) {
+		return _fail(std::string("Could not load ") + library);
+	}
+#else
+	void * handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+	if (!handle) {
+		return _fail(std::string("Could not load ") + library + ": " + dlerror());
+	}
+#endif
+	CallDLL callDLL = _symbol<CallDLL>(handle, "virtCallDLL");
+	if (!callDLL) {
+		return _fail(std::string(library) + " does not export virtCallDLL");
+	}
+	if (dll) {
+		LoadDLL loadDLL = _symbol<LoadDLL>(handle, "virtLoadDLL");
+		if (!loadDLL) {
+			return _fail(std::string(library) + " does not export virtLoadDLL");
+		}
+		if (loadDLL(const_cast<char *>(dll)) != 0) {
+			return _fail(std::string("virtLoadDLL failed for ") + dll);
+		}
+	}
+
+	// APIVERSION is function 0 in every supported version.
+	int major = 0;
+	int minor = 0;
+	if (callDLL(0, &major, &minor) != 0) {
+		return _fail("virtAPIVersion failed");
+	}
+	int version = major * 1000 + minor;
+
+	vpp_runtime::VersionTable const * match = NULL;
+	for (int i = 0; i < vpp_runtime::VERSION_TABLE_COUNT; ++i) {
+		if (vpp_runtime::versionTables()[i].version <= version) {
+			match = &vpp_runtime::versionTables()[i];
+		}
+	}
+	if (!match) {
+		std::ostringstream s;
+		s << "VirtuoseAPI " << major << "." << minor << " is older than any supported version";
+		return _fail(s.str());
+	}
+
+	Table & t = _table();
+	for (int i = 0; i < vpp_runtime::FUNCTION_COUNT; ++i) {
+		t.slots[i] = static_cast<short>(match->functions[i] + 1);
+	}
+	t.wideCall = match->wideReturn ? _symbol<WideCallDLL>(handle, "virtCallDLL") : NULL;
+	t.apiVersion = version;
+	t.tableVersion = match->version;
+	t.call = callDLL;
+	return true;
+}
+
+inline int virtAPIVersion(int *major, int *minor) {
+	return VirtuoseRuntime::call(vpp_runtime::APIVERSION, major, minor);
+}
+
+inline int virtActiveRotationSpeedControl(VirtContext VC, float angle, float speedFactor) {
+	return VirtuoseRuntime::call(vpp_runtime::ACTIVEROTATIONSPEEDCONTROL, VC, &angle, &speedFactor);
+}
+
+inline int virtActiveSpeedControl(VirtContext VC, float radius, float speedFactor) {
+	return VirtuoseRuntime::call(vpp_runtime::ACTIVESPEEDCONTROL, VC, &radius, &speedFactor);
+}
+
+inline int virtAddForce(VirtContext VC, float *force) {
+	return VirtuoseRuntime::call(vpp_runtime::ADDPHYSICALFORCE, VC, force);
+}
+
+inline int virtAttachQSVO(VirtContext VC, float *Ks, float *Bs) {
+	return VirtuoseRuntime::call(vpp_runtime::ATTACHQSVO, VC, Ks, Bs);
+}
+
+inline int virtAttachVO(VirtContext VC, float mass, float *mxmymz) {
+	return VirtuoseRuntime::call(vpp_runtime::ATTACHVO, VC, &mass, mxmymz);
+}
+
+inline int virtAttachVOAvatar(VirtContext VC, float mass, float *mxmymz) {
+	return VirtuoseRuntime::call(vpp_runtime::ATTACHVOAVATAR, VC, &mass, mxmymz);
+}
+
+inline int virtBeepOnLimit(VirtContext VC, int enable) {
+	return VirtuoseRuntime::call(vpp_runtime::BEEPONLIMIT, VC, &enable);
+}
+
+inline int virtClose(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::CLOSE, VC);
+}
+
+inline int virtConvertDeplToHomogeneMatrix(VirtContext VC, float *d, float *m) {
+	return VirtuoseRuntime::call(vpp_runtime::DEPLTOMATRIX, VC, d, m);
+}
+
+inline int virtConvertHomogeneMatrixToDepl(VirtContext VC, float *d, float *m) {
+	return VirtuoseRuntime::call(vpp_runtime::MATRIXTODEPL, VC, d, m);
+}
+
+inline int virtConvertRGBToGrayscale(VirtContext VC, float *rgb, float *gray) {
+	return VirtuoseRuntime::call(vpp_runtime::RGBTOGRAYSCALE, VC, rgb, gray);
+}
+
+inline int virtDeactiveRotationSpeedControl(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::DESACTIVEROTATIONSPEEDCONTROL, VC);
+}
+
+inline int virtDeactiveSpeedControl(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::DESACTIVESPEEDCONTROL, VC);
+}
+
+inline int virtDetachVO(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::DETACHVO, VC);
+}
+
+inline int virtDetachVOAvatar(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::DETACHVOAVATAR, VC);
+}
+
+inline int virtDisableControlConnexion(VirtContext VC, int disable) {
+	return VirtuoseRuntime::call(vpp_runtime::DISABLECONTROLCONNEXION, VC, &disable);
+}
+
+inline int virtDisplayHardwareStatus(VirtContext VC, FILE *fh) {
+	return VirtuoseRuntime::call(vpp_runtime::DISPLAYHARDWARESTATUS, VC, fh);
+}
+
+inline int virtEnableForceFeedback(VirtContext VC, int enable) {
+	return VirtuoseRuntime::call(vpp_runtime::ENABLEFORCEFEEDBACK, VC, &enable);
+}
+
+inline int virtForceShiftButton(VirtContext VC, int forceShiftButton) {
+	return VirtuoseRuntime::call(vpp_runtime::FORCESHIFTBUTTON, VC, &forceShiftButton);
+}
+
+inline int virtGenerateDebugFile(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::DEBUGFILE, VC);
+}
+
+inline int virtGetADC(VirtContext VC, int line, float *adc) {
+	return VirtuoseRuntime::call(vpp_runtime::GETADC, VC, &line, adc);
+}
+
+inline int virtGetAlarm(VirtContext VC, unsigned int *alarm) {
+	return VirtuoseRuntime::call(vpp_runtime::ALARM, VC, alarm);
+}
+
+inline int virtGetArticularPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::GETARTICULARPOSITION, VC, pos);
+}
+
+inline int virtGetArticularPositionOfAdditionalAxe(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::GETARTICULARPOSITIONOFADDITIONALAXE, VC, pos);
+}
+
+inline int virtGetArticularSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::GETARTICULARSPEED, VC, speed);
+}
+
+inline int virtGetArticularSpeedOfAdditionalAxe(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::GETARTICULARSPEEDOFADDITIONALAXE, VC, speed);
+}
+
+inline int virtGetAvatarPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::AVATARPOSITION, VC, pos);
+}
+
+inline int virtGetAxisOfRotation(VirtContext VC, float *axis) {
+	return VirtuoseRuntime::call(vpp_runtime::AXEROTATION, VC, axis);
+}
+
+inline int virtGetBaseFrame(VirtContext VC, float *base) {
+	return VirtuoseRuntime::call(vpp_runtime::GETBASEFRAME, VC, base);
+}
+
+inline int virtGetButton(VirtContext VC, int button_number, int *state) {
+	return VirtuoseRuntime::call(vpp_runtime::GETBUTTON, VC, &button_number, state);
+}
+
+inline int virtGetCatchFrame(VirtContext VC, float *frame) {
+	return VirtuoseRuntime::call(vpp_runtime::GETCATCHFRAME, VC, frame);
+}
+
+inline int virtGetCenterSphere(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::CENTERSPEEDCONTROL, VC, pos);
+}
+
+inline int virtGetCommandType(VirtContext VC, VirtCommandType *type) {
+	return VirtuoseRuntime::call(vpp_runtime::GETCOMMANDTYPE, VC, type);
+}
+
+inline int virtGetControlerVersion(VirtContext VC, int *major, int *minor) {
+	return VirtuoseRuntime::call(vpp_runtime::CONTROLERVERSION, VC, major, minor);
+}
+
+inline int virtGetDeadMan(VirtContext VC, int *dead_man) {
+	return VirtuoseRuntime::call(vpp_runtime::GETDEADMAN, VC, dead_man);
+}
+
+inline int virtGetDeviceID(VirtContext VC, int *device_type, int *serial_number) {
+	return VirtuoseRuntime::call(vpp_runtime::DEVICEID, VC, device_type, serial_number);
+}
+
+inline int virtGetEmergencyStop(VirtContext VC, int *emergency_stop) {
+	return VirtuoseRuntime::call(vpp_runtime::GETEMERGENCYSTOP, VC, emergency_stop);
+}
+
+inline int virtGetError(VirtContext VC, int *error) {
+	return VirtuoseRuntime::call(vpp_runtime::GETERROR, VC, error);
+}
+
+inline int virtGetErrorCode(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::GETERRORCODE, VC);
+}
+
+inline char * virtGetErrorMessage(int code) {
+	return (char *)VirtuoseRuntime::callPointer(vpp_runtime::GETERRORMESSAGE, &code);
+}
+
+inline int virtGetFailure(VirtContext VC, unsigned int *error) {
+	return VirtuoseRuntime::call(vpp_runtime::BREAKDOWN, VC, error);
+}
+
+inline int virtGetForce(VirtContext VC, float *force) {
+	return VirtuoseRuntime::call(vpp_runtime::GETFORCE, VC, force);
+}
+
+inline int virtGetForceFactor(VirtContext VC, float *force_factor) {
+	return VirtuoseRuntime::call(vpp_runtime::GETFORCEFACTOR, VC, force_factor);
+}
+
+inline int virtGetIndexingMode(VirtContext VC, VirtIndexingType *indexing_mode) {
+	return VirtuoseRuntime::call(vpp_runtime::GETINDEXINGMODE, VC, indexing_mode);
+}
+
+inline int virtGetLimitTorque(VirtContext VC, float *torque) {
+	return VirtuoseRuntime::call(vpp_runtime::GETLIMITTORQUE, VC, torque);
+}
+
+inline int virtGetMouseState(VirtContext VC, int *active, int *left_click, int *right_click) {
+	return VirtuoseRuntime::call(vpp_runtime::MOUSE, VC, active, left_click, right_click);
+}
+
+inline int virtGetObservationFrame(VirtContext VC, float *obs) {
+	return VirtuoseRuntime::call(vpp_runtime::GETOBSERVATIONFRAME, VC, obs);
+}
+
+inline int virtGetPhysicalPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::PHYSICALPOSITION, VC, pos);
+}
+
+inline int virtGetPhysicalSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::PHYSICALSPEED, VC, speed);
+}
+
+inline int virtGetPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::GETPOSITION, VC, pos);
+}
+
+inline int virtGetPowerOn(VirtContext VC, int *power) {
+	return VirtuoseRuntime::call(vpp_runtime::GETPOWERON, VC, power);
+}
+
+inline int virtGetSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::GETSPEED, VC, speed);
+}
+
+inline int virtGetSpeedFactor(VirtContext VC, float *speed_factor) {
+	return VirtuoseRuntime::call(vpp_runtime::GETSPEEDFACTOR, VC, speed_factor);
+}
+
+inline int virtGetTimeLastUpdate(VirtContext VC, unsigned int *time) {
+	return VirtuoseRuntime::call(vpp_runtime::GETTIMELASTUPDATE, VC, time);
+}
+
+inline int virtGetTimeStep(VirtContext VC, float *step) {
+	return VirtuoseRuntime::call(vpp_runtime::GETTIMESTEP, VC, step);
+}
+
+inline int virtGetTimeoutValue(VirtContext VC, float *time_value) {
+	return VirtuoseRuntime::call(vpp_runtime::GETTIMEOUTVALUE, VC, time_value);
+}
+
+inline int virtGetTrackball(VirtContext VC, int *x_move, int *y_move) {
+	return VirtuoseRuntime::call(vpp_runtime::GETTRACKBALL, VC, x_move, y_move);
+}
+
+inline int virtGetTrackballButton(VirtContext VC, int *active, int *left_btn, int *middle_btn, int *right_btn) {
+	return VirtuoseRuntime::call(vpp_runtime::GETTRACKBALLBUTTON, VC, active, left_btn, middle_btn, right_btn);
+}
+
+inline int virtIsInBounds(VirtContext VC, unsigned int *bounds) {
+	return VirtuoseRuntime::call(vpp_runtime::BOUNDS, VC, bounds);
+}
+
+inline int virtIsInShiftPosition(VirtContext VC, int *shift) {
+	return VirtuoseRuntime::call(vpp_runtime::SHIFTPOSITION, VC, shift);
+}
+
+inline int virtIsInSpeedControl(VirtContext VC, int *translation, int *rotation) {
+	return VirtuoseRuntime::call(vpp_runtime::ISINSPEEDCONTROL, VC, translation, rotation);
+}
+
+inline VirtContext virtOpen(const char *nom) {
+	return (VirtContext)VirtuoseRuntime::callPointer(vpp_runtime::OPEN, nom);
+}
+
+inline int virtOutputsSetting(VirtContext VC, unsigned int outputs) {
+	return VirtuoseRuntime::call(vpp_runtime::OUTPUTSSETTING, VC, &outputs);
+}
+
+inline int virtSaturateTorque(VirtContext VC, float forceThreshold, float momentThreshold) {
+	return VirtuoseRuntime::call(vpp_runtime::SATURATETORQUE, VC, &forceThreshold, &momentThreshold);
+}
+
+inline int virtSetAbsolutePosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::SETABSOLUTEPOSITION, VC, pos);
+}
+
+inline int virtSetArticularForce(VirtContext VC, float *force) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARFORCE, VC, force);
+}
+
+inline int virtSetArticularForceOfAdditionalAxe(VirtContext VC, float *effort) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARFORCEOFADDITIONALAXE, VC, effort);
+}
+
+inline int virtSetArticularPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARPOSITION, VC, pos);
+}
+
+inline int virtSetArticularPositionOfAdditionalAxe(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARPOSITIONOFADDITIONALAXE, VC, pos);
+}
+
+inline int virtSetArticularSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARSPEED, VC, speed);
+}
+
+inline int virtSetArticularSpeedOfAdditionalAxe(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::SETARTICULARSPEEDOFADDITIONALAXE, VC, speed);
+}
+
+inline int virtSetBaseFrame(VirtContext VC, float *base) {
+	return VirtuoseRuntime::call(vpp_runtime::SETBASEFRAME, VC, base);
+}
+
+inline int virtSetCatchFrame(VirtContext VC, float *frame) {
+	return VirtuoseRuntime::call(vpp_runtime::SETCATCHFRAME, VC, frame);
+}
+
+inline int virtSetCommandType(VirtContext VC, VirtCommandType type) {
+	return VirtuoseRuntime::call(vpp_runtime::SETCOMMANDTYPE, VC, &type);
+}
+
+inline int virtSetDebugFlags(VirtContext VC, unsigned short flag) {
+	return VirtuoseRuntime::call(vpp_runtime::SETDEBUGFLAGS, VC, &flag);
+}
+
+inline int virtSetForce(VirtContext VC, float *force) {
+	return VirtuoseRuntime::call(vpp_runtime::SETFORCE, VC, force);
+}
+
+inline int virtSetForceFactor(VirtContext VC, float force_factor) {
+	return VirtuoseRuntime::call(vpp_runtime::SETFORCEFACTOR, VC, &force_factor);
+}
+
+inline int virtSetForceInSpeedControl(VirtContext VC, float force) {
+	return VirtuoseRuntime::call(vpp_runtime::FORCEINSPEEDCONTROL, VC, &force);
+}
+
+inline int virtSetFrictionForce(VirtContext VC, float fx, float fy, float fz) {
+	return VirtuoseRuntime::call(vpp_runtime::FRICTION, VC, &fx, &fy, &fz);
+}
+
+inline int virtSetGripperCommandType(VirtContext VC, VirtGripperCommandType type) {
+	return VirtuoseRuntime::call(vpp_runtime::SETGRIPPERCOMMANDTYPE, VC, &type);
+}
+
+inline int virtSetIndexingMode(VirtContext VC, VirtIndexingType indexing_mode) {
+	return VirtuoseRuntime::call(vpp_runtime::SETINDEXINGMODE, VC, &indexing_mode);
+}
+
+inline int virtSetLimitTorque(VirtContext VC, float torque) {
+	return VirtuoseRuntime::call(vpp_runtime::SETLIMITTORQUE, VC, &torque);
+}
+
+inline int virtSetObservationFrame(VirtContext VC, float *obs) {
+	return VirtuoseRuntime::call(vpp_runtime::SETOBSERVATIONFRAME, VC, obs);
+}
+
+inline int virtSetObservationFrameSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::SETOBSERVATIONFRAMESPEED, VC, speed);
+}
+
+inline int virtSetOutputFile(VirtContext VC, char *name) {
+	return VirtuoseRuntime::call(vpp_runtime::SETOUTPUTFILE, VC, name);
+}
+
+inline int virtSetPeriodicFunction(VirtContext VC, void (*fn)(VirtContext, void *), float *period, void *arg) {
+	return VirtuoseRuntime::call(vpp_runtime::SETPERIODICFUNCTION, VC, fn, period, arg);
+}
+
+inline int virtSetPosition(VirtContext VC, float *pos) {
+	return VirtuoseRuntime::call(vpp_runtime::SETPOSITION, VC, pos);
+}
+
+inline int virtSetPowerOn(VirtContext VC, int power) {
+	return VirtuoseRuntime::call(vpp_runtime::SETPOWERON, VC, &power);
+}
+
+inline int virtSetSpeed(VirtContext VC, float *speed) {
+	return VirtuoseRuntime::call(vpp_runtime::SETSPEED, VC, speed);
+}
+
+inline int virtSetSpeedFactor(VirtContext VC, float speed_factor) {
+	return VirtuoseRuntime::call(vpp_runtime::SETSPEEDFACTOR, VC, &speed_factor);
+}
+
+inline int virtSetTexture(VirtContext VC, float *position, float *intensity, int reinit) {
+	return VirtuoseRuntime::call(vpp_runtime::SETTEXTURE, VC, position, intensity, &reinit);
+}
+
+inline int virtSetTextureForce(VirtContext VC, float *texture_force) {
+	return VirtuoseRuntime::call(vpp_runtime::SETTEXTUREFORCE, VC, texture_force);
+}
+
+inline int virtSetTimeStep(VirtContext VC, float step) {
+	return VirtuoseRuntime::call(vpp_runtime::SETTIMESTEP, VC, &step);
+}
+
+inline int virtSetTimeoutValue(VirtContext VC, float time_value) {
+	return VirtuoseRuntime::call(vpp_runtime::SETTIMEOUTVALUE, VC, &time_value);
+}
+
+inline int virtSetTorqueInSpeedControl(VirtContext VC, float torque) {
+	return VirtuoseRuntime::call(vpp_runtime::TORQUEINSPEEDCONTROL, VC, &torque);
+}
+
+inline int virtStartLoop(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::STARTLOOP, VC);
+}
+
+inline int virtStopLoop(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::STOPLOOP, VC);
+}
+
+inline int virtTrajRecordStart(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::TRAJRECORDSTART, VC);
+}
+
+inline int virtTrajRecordStop(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::TRAJRECORDSTOP, VC);
+}
+
+inline int virtTrajSetSamplingTimeStep(VirtContext VC, float timeStep, unsigned int *recordTime) {
+	return VirtuoseRuntime::call(vpp_runtime::TRAJTIMESTEP, VC, &timeStep, recordTime);
+}
+
+inline int virtVmActivate(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMACTIVATE, VC);
+}
+
+inline int virtVmDeactivate(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMDEACTIVATE, VC);
+}
+
+inline int virtVmDeleteSpline(VirtContext VC, char *file_name) {
+	return VirtuoseRuntime::call(vpp_runtime::VMDELETESPLINE, VC, file_name);
+}
+
+inline int virtVmGetBaseFrame(VirtContext VC, float *base) {
+	return VirtuoseRuntime::call(vpp_runtime::VMGETBASEFRAME, VC, base);
+}
+
+inline int virtVmGetTrajSamples(VirtContext VC, float *samples) {
+	return VirtuoseRuntime::call(vpp_runtime::TRAJSAMPLES, VC, samples);
+}
+
+inline int virtVmLoadSpline(VirtContext VC, char *file_name) {
+	return VirtuoseRuntime::call(vpp_runtime::VMLOADSPLINE, VC, file_name);
+}
+
+inline int virtVmSaveCurrentSpline(VirtContext VC, char *file_name) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSAVESPLINE, VC, file_name);
+}
+
+inline int virtVmSetBaseFrame(VirtContext VC, float *base) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETBASEFRAME, VC, base);
+}
+
+inline int virtVmSetBaseFrameToCurrentFrame(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETBASEFRAMETOCURRENTFRAME, VC);
+}
+
+inline int virtVmSetDefaultToCartesianPosition(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETCARTESIANPOSITION, VC);
+}
+
+inline int virtVmSetDefaultToTransparentMode(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETTRANSPARENTMODE, VC);
+}
+
+inline int virtVmSetMaxArtiBounds(VirtContext VC, float *bounds) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETMAXBOUNDS, VC, bounds);
+}
+
+inline int virtVmSetMinArtiBounds(VirtContext VC, float *bounds) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETMINBOUNDS, VC, bounds);
+}
+
+inline int virtVmSetRobotMode(VirtContext VC, int OnOff) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETROBOTMODE, VC, &OnOff);
+}
+
+inline int virtVmSetType(VirtContext VC, VirtVmType type) {
+	return VirtuoseRuntime::call(vpp_runtime::VMSETTYPE, VC, &type);
+}
+
+inline int virtVmStartTrajSampling(VirtContext VC, unsigned int nbSamples) {
+	return VirtuoseRuntime::call(vpp_runtime::STARTTRAJSAMPLING, VC, &nbSamples);
+}
+
+inline int virtVmWaitUpperBound(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::VMUPPERBOUND, VC);
+}
+
+inline int virtWaitForSynch(VirtContext VC) {
+	return VirtuoseRuntime::call(vpp_runtime::WAITFORSYNCH, VC);
+}
+
+inline int virtWaitPressButton(VirtContext VC, int button_number) {
+	return VirtuoseRuntime::call(vpp_runtime::WAITBUTTON, VC, &button_number);
+}
+
+#endif // INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
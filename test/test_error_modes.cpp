@@ -0,0 +1,148 @@
+/**
+	@file
+	@brief Checks, against the mock backend, that the wrapped methods make
+	their VirtuoseAPI call in whichever error mode this is built in
+	(default, VPP_DISABLE_ERROR_CHECK or VPP_RESULT_ERROR_CHECK, each with
+	or without VPP_DIRECT_DISPATCH): plain, try* and by-value getters,
+	setters, and virtClose() from the destructor, both when the call
+	succeeds and when it fails; and that a failed call is reported as
+	the mode says: a VirtuoseAPIError with the device's error code, a
+	nonzero return value, or a VirtuoseResult that isn't ok(). Built and
+	run by make test.
+
+	Exits with a nonzero status if a check fails.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp.h>
+#include "virtuoseAPI-mock.h"
+
+// Library/third-party includes
+// none
+
+// Standard includes
+#include <cstdio>
+
+namespace {
+	int failures = 0;
+
+#if defined(VPP_DISABLE_ERROR_CHECK) || defined(VPP_RESULT_ERROR_CHECK)
+	const bool throwing = false;
+#else
+	const bool throwing = true;
+#endif
+
+	void check(bool ok, const char * what) {
+		if (!ok) {
+			std::printf("FAILED: %s\n", what);
+			++failures;
+		}
+	}
+
+	/** @brief Runs @a call, which must make exactly one call to
+		@a function, and throw a VirtuoseAPIError with
+		VIRT_E_COMMUNICATION_FAILURE as its code if @a throws, or nothing
+		otherwise.
+	*/
+	template<typename F>
+	void expectCall(int function, const char * what, bool throws, F call) {
+		unsigned long before = virtMockGetCallCount(function);
+		int code = VIRT_E_NO_ERROR;
+		try {
+			call();
+		} catch (VirtuoseAPIError & e) {
+			code = e.code();
+		}
+		check(virtMockGetCallCount(function) == before + 1, what);
+		if (throws) {
+			check(code == VIRT_E_COMMUNICATION_FAILURE, what);
+		} else {
+			check(code == VIRT_E_NO_ERROR, what);
+		}
+	}
+
+	/// @brief Makes each call once; @a failing says whether the mock
+	/// fails them.
+	void run(Virtuose & vpp, const char * when, bool failing) {
+		std::printf("  %s\n", when);
+		float pos[7];
+		float force[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+		float step;
+		const bool throws = throwing && failing;
+		expectCall(GETPOSITION, "getPosition(float *)", throws, [&] {
+			vpp.getPosition(pos);
+		});
+		expectCall(GETPOSITION, "tryGetPosition(float *)", false, [&] {
+			vpp.tryGetPosition(pos);
+		});
+		expectCall(GETPOSITION, "getPosition()", throws, [&] {
+			vpp.getPosition();
+		});
+		expectCall(GETPOSITION, "tryGetPosition()", false, [&] {
+			vpp.tryGetPosition();
+		});
+		expectCall(SETFORCE, "setForce()", throws, [&] {
+			vpp.setForce(force);
+		});
+		expectCall(SETFORCE, "trySetForce()", false, [&] {
+			vpp.trySetForce(force);
+		});
+		expectCall(GETTIMESTEP, "getTimeStep(float *)", throws, [&] {
+			vpp.getTimeStep(&step);
+		});
+		expectCall(GETTIMESTEP, "tryGetTimeStep(float *)", false, [&] {
+			vpp.tryGetTimeStep(&step);
+		});
+	}
+} // end of anonymous namespace
+
+int main() {
+#if defined(VPP_DISABLE_ERROR_CHECK)
+	const char * mode = "VPP_DISABLE_ERROR_CHECK";
+#elif defined(VPP_RESULT_ERROR_CHECK)
+	const char * mode = "VPP_RESULT_ERROR_CHECK";
+#else
+	const char * mode = "default (throwing)";
+#endif
+#ifdef VPP_DIRECT_DISPATCH
+	std::printf("%s, VPP_DIRECT_DISPATCH\n", mode);
+#else
+	std::printf("%s\n", mode);
+#endif
+	{
+		Virtuose vpp("test");
+		run(vpp, "calls succeeding", false);
+
+		virtMockInjectError(VIRT_MOCK_ALL_FUNCTIONS, 1, VIRT_E_COMMUNICATION_FAILURE);
+		run(vpp, "calls failing", true);
+		float pos[7];
+		check(!vpp.tryGetPosition(pos).ok(), "tryGetPosition() reports a failed call");
+		check(vpp.tryGetPosition(pos).errorCode == VIRT_E_COMMUNICATION_FAILURE, "tryGetPosition() reports the error code");
+#if defined(VPP_DISABLE_ERROR_CHECK)
+		check(vpp.getPosition(pos) != 0, "getPosition(float *) returns nonzero from a failed call");
+#elif defined(VPP_RESULT_ERROR_CHECK)
+		check(!vpp.getPosition(pos).ok(), "getPosition(float *) reports a failed call");
+		check(!vpp.getPosition().ok(), "getPosition() reports a failed call");
+#endif
+		virtMockInjectError(VIRT_MOCK_ALL_FUNCTIONS, 0, 0);
+
+		// The destructor closes it, failing or not.
+		unsigned long closes = virtMockGetCallCount(CLOSE);
+		{
+			Virtuose closed("test");
+		}
+		check(virtMockGetCallCount(CLOSE) == closes + 1, "virtClose() from the destructor");
+		virtMockInjectError(CLOSE, 1, VIRT_E_COMMUNICATION_FAILURE);
+		{
+			Virtuose closed("test");
+		}
+		virtMockInjectError(CLOSE, 0, 0);
+		check(virtMockGetCallCount(CLOSE) == closes + 2, "failing virtClose() from the destructor");
+	}
+	std::printf("  %s\n", failures ? "FAILED" : "passed");
+	return failures ? 1 : 0;
+}
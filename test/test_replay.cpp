@@ -0,0 +1,138 @@
+/**
+	@file
+	@brief Checks VirtuoseReplaySession on a synthetic 50 s recording: that
+	stop() from another thread ends a run() on the caller's thread early,
+	that run() then plays the rest, that recordTo() keeps every tick of a
+	replay played as fast as possible, and that the periodic function can
+	stop the loop it runs on. Built and run by make test.
+
+	Exits with a nonzero status if a check fails.
+
+	Usage: test_replay [directory for the temporary files]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-replay-backend.h>
+
+// Library/third-party includes
+#include <unistd.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+	const int rate = 4000;
+	const uint64_t count = 50 * rate;
+	int failures = 0;
+
+	void check(bool ok, const char * what) {
+		if (!ok) {
+			std::printf("FAILED: %s\n", what);
+			++failures;
+		}
+	}
+
+	struct Servo {
+		void operator()(VirtuoseReplay & vpp) {
+			VirtuoseState state = vpp.readState();
+			VirtuoseWrench force;
+			for (int i = 0; i < 3; ++i) {
+				force[i] = -200.f * state.position[i];
+			}
+			vpp.setForce(force.data);
+		}
+	};
+
+	/// @brief Stops the loop from its own thread on its 5th tick.
+	struct StoppingServo {
+		StoppingServo() : ticks(0) {}
+		void operator()(VirtuoseReplay & vpp) {
+			if (++ticks == 5) {
+				vpp.stopLoop();
+			}
+		}
+		int ticks;
+	};
+
+	void synthesize(std::string const& path) {
+		VirtuoseTrajectoryRecorder recorder(path, count, 1.f / rate);
+		VirtuoseTrajectorySample s = VirtuoseTrajectorySample();
+		for (uint64_t i = 0; i < count; ++i) {
+			s.tick = i;
+			s.time = double(i) / rate;
+			s.position[0] = 0.001f * static_cast<float>(i % 100);
+			s.position[6] = 1.f;
+			s.timeLastUpdate = static_cast<uint32_t>(i);
+			while (!recorder.tryRecord(s)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	std::string dir = (argc > 1) ? argv[1] : "/tmp";
+	std::string base = dir + "/vpp_test_replay_" + std::to_string(getpid());
+	std::string input = base + ".vtraj";
+	std::string output = base + "_out.vtraj";
+	synthesize(input);
+	{
+		VirtuoseReplay vpp(input.c_str());
+		VirtuoseReplaySession & replay = VirtuoseReplayBackend::session(vpp.getVirtContext());
+		Servo servo;
+		float period = 1.f / rate;
+		vpp.setPeriodicFunction(servo, &period);
+
+		std::thread stopper([&] {
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			replay.stop();
+		});
+		Clock::time_point start = Clock::now();
+		uint64_t played = replay.run();
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		stopper.join();
+		std::printf("stopped at 0.2 s: %llu of %llu ticks in %.2f s\n", static_cast<unsigned long long>(played),
+		            static_cast<unsigned long long>(count), elapsed);
+		check(played < count && elapsed < 1.0, "stop() ends run() on the caller's thread early");
+
+		replay.setPacing(VirtuoseReplaySession::AsFastAsPossible);
+		uint64_t rest = replay.run();
+		check(played + rest == count && replay.finished(), "run() after stop() plays the rest");
+
+		replay.rewind();
+		replay.recordTo(output);
+		played = replay.run();
+		replay.stopRecording();
+		VirtuoseTrajectoryReader reader(output);
+		std::printf("recorded as fast as possible: %llu of %llu ticks, %llu dropped\n",
+		            static_cast<unsigned long long>(reader.size()), static_cast<unsigned long long>(played),
+		            static_cast<unsigned long long>(reader.header().dropped));
+		check(played == count && reader.size() == count && reader.header().dropped == 0, "recordTo() keeps every tick");
+	}
+	{
+		VirtuoseReplay vpp(input.c_str());
+		VirtuoseReplaySession & replay = VirtuoseReplayBackend::session(vpp.getVirtContext());
+		StoppingServo servo;
+		float period = 1.f / rate;
+		vpp.setPeriodicFunction(servo, &period);
+		replay.setPacing(VirtuoseReplaySession::AsFastAsPossible);
+		vpp.startLoop();
+		replay.wait();
+		std::printf("stopped by the periodic function: %llu ticks\n", static_cast<unsigned long long>(replay.ticks()));
+		check(replay.ticks() == 5, "stopLoop() from the periodic function stops after that tick");
+		vpp.stopLoop();
+	}
+	std::remove(input.c_str());
+	std::remove(output.c_str());
+	std::printf("%s\n", failures ? "FAILED" : "passed");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+/**
+	@file
+	@brief Checks that VirtuoseTrajectoryReader opens a recorded file and
+	rejects headers whose layout would have it (or vpp-trajectory-dump)
+	read outside the file: channels of unknown type or past the end of a
+	record, records overlapping the header, and a capacity whose size
+	overflows. Built and run by make test.
+
+	Exits with a nonzero status if a check fails.
+
+	Usage: test_trajectory_reader [directory for the temporary files]
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Internal Includes
+#include <vpp-trajectory-recorder.h>
+
+// Library/third-party includes
+#include <unistd.h>
+
+// Standard includes
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	int failures = 0;
+
+	void check(bool ok, std::string const& what) {
+		if (!ok) {
+			std::printf("FAILED: %s\n", what.c_str());
+			++failures;
+		}
+	}
+
+	std::vector<char> readFile(std::string const& path) {
+		std::ifstream in(path.c_str(), std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	void writeFile(std::string const& path, std::vector<char> const& bytes) {
+		std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+		out.write(&bytes[0], static_cast<std::streamsize>(bytes.size()));
+	}
+
+	/// @brief Writes @a good with @a value at byte @a offset to @a path,
+	/// and checks that the reader rejects it as corrupt.
+	template<typename T>
+	void expectCorrupt(std::string const& path, std::vector<char> good, std::size_t offset, T value, const char * what) {
+		std::memcpy(&good[offset], &value, sizeof(value));
+		writeFile(path, good);
+		std::string error;
+		try {
+			VirtuoseTrajectoryReader reader(path);
+		} catch (std::runtime_error & e) {
+			error = e.what();
+		}
+		check(error.find("has a corrupt header") != std::string::npos, std::string("rejects ") + what + " (got \"" + error + "\")");
+	}
+} // end of anonymous namespace
+
+int main(int argc, char * argv[]) {
+	std::string dir = (argc > 1) ? argv[1] : "/tmp";
+	std::string base = dir + "/vpp_test_trajectory_reader_" + std::to_string(getpid());
+	std::string good = base + ".vtraj";
+	std::string bad = base + "_bad.vtraj";
+	{
+		VirtuoseTrajectoryRecorder recorder(good, 100, 0.001f);
+		VirtuoseTrajectorySample s = VirtuoseTrajectorySample();
+		for (uint64_t i = 0; i < 10; ++i) {
+			s.tick = i;
+			recorder.record(s);
+		}
+	}
+	{
+		VirtuoseTrajectoryReader reader(good);
+		check(reader.size() == 10 && reader.hasSampleLayout() && reader.sample(9).tick == 9, "reads a recorded file");
+	}
+
+	typedef VirtuoseTrajectoryFileHeader H;
+	typedef VirtuoseTrajectoryChannel C;
+	std::vector<char> bytes = readFile(good);
+	const std::size_t channel = offsetof(H, channels) + 2 * sizeof(C);
+	expectCorrupt(bad, bytes, channel + offsetof(C, type), static_cast<uint32_t>(42), "an unknown channel type");
+	expectCorrupt(bad, bytes, channel + offsetof(C, offset), static_cast<uint32_t>(sizeof(VirtuoseTrajectorySample)), "a channel starting past the record");
+	expectCorrupt(bad, bytes, channel + offsetof(C, count), static_cast<uint32_t>(0xffffffffu), "a channel running past the record");
+	expectCorrupt(bad, bytes, offsetof(H, dataOffset), static_cast<uint32_t>(16), "records overlapping the header");
+	expectCorrupt(bad, bytes, offsetof(H, capacity), ~static_cast<uint64_t>(0) / 8, "a capacity whose size overflows");
+
+	std::remove(good.c_str());
+	std::remove(bad.c_str());
+	std::printf("trajectory reader: %s\n", failures ? "FAILED" : "passed");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,299 @@
+/**
+	@file
+	@brief Runtime-loaded stand-in for the VirtuoseAPI header, so one
+	binary can run against any supported VirtuoseAPI version.
+
+	Generated from the VirtuoseAPI headers of versions
+	UPSTREAM_VERSION_GOES_HERE.
+
+	It declares every function of all of those versions, with the names
+	and signatures of the vendor's inline functions, but they call the
+	virtCallDLL of a library loaded at runtime by VirtuoseRuntime::load(),
+	translated through a table for the version that library reports.
+	The version is checked once, at load: each call just looks up its
+	function number in the table, and functions the loaded version
+	doesn't have fail with VIRT_E_NOT_IMPLEMENTED without calling it.
+
+	The vpp.h next to this header wraps it just like the per-version
+	headers do. Types, enums and error codes are those of the newest
+	version, which are a superset of the older ones. Requires C++11.
+*/
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
+#define INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
+
+#if __cplusplus < 201103L
+#	error "The runtime-loaded VirtuoseAPI backend requires C++11"
+#endif
+
+#ifdef VPP_DIRECT_DISPATCH
+#	error "VPP_DIRECT_DISPATCH is not supported with the runtime-loaded VirtuoseAPI backend"
+#endif
+
+/// @brief Defined when vpp.h wraps the runtime-loaded backend.
+#define VPP_RUNTIME_BACKEND
+
+// Internal Includes
+// none
+
+// Library/third-party includes
+
+// Types, enums and error codes only: the inline functions of this header
+// use its own function numbering, so they are left out.
+#ifndef VIRTUOSEAPI_DLLEXPORTS
+#	define VIRTUOSEAPI_DLLEXPORTS
+#	define VPP_RUNTIME_UNDEF_DLLEXPORTS
+#endif
+#include "NEWEST_UPSTREAM_INCLUDE_GOES_HERE"
+#ifdef VPP_RUNTIME_UNDEF_DLLEXPORTS
+#	undef VIRTUOSEAPI_DLLEXPORTS
+#	undef VPP_RUNTIME_UNDEF_DLLEXPORTS
+#endif
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <dlfcn.h>
+#endif
+
+namespace vpp_runtime {
+	/// @brief Every virtDLLFunction used by any supported version.
+	enum Function {
+		/* FUNCTION ENUM GOES HERE */
+		FUNCTION_COUNT
+	};
+
+	/// @brief How one version numbers the functions it has.
+	struct VersionTable {
+		/// Major version multiplied by 1000, plus minor version.
+		int version;
+		/// True if that version's virtCallDLL returns size_t rather than int.
+		bool wideReturn;
+		/// That version's virtDLLFunction value for each Function, or -1.
+		short functions[FUNCTION_COUNT];
+	};
+
+	enum {
+		VERSION_TABLE_COUNT = VERSION_TABLE_COUNT_GOES_HERE
+	};
+
+	/// @brief The tables for all supported versions, oldest first.
+	inline VersionTable const * versionTables() {
+		static const VersionTable tables[VERSION_TABLE_COUNT] = {
+			/* VERSION TABLES GO HERE */
+		};
+		return tables;
+	}
+} // end of namespace vpp_runtime
+
+/** @brief Loads the VirtuoseAPI library at runtime, and performs the
+	calls of the functions declared in this header.
+
+	@code
+	if (!VirtuoseRuntime::load("libvirtuose.so")) {
+		std::cerr << VirtuoseRuntime::loadError() << std::endl;
+		return 1;
+	}
+	if (VirtuoseRuntime::has(vpp_runtime::GETARTICULARPOSITION)) { ... }
+	@endcode
+*/
+class VirtuoseRuntime {
+	public:
+		typedef int (*CallDLL)(int, ...);
+		typedef std::size_t (*WideCallDLL)(int, ...);
+		typedef int (*LoadDLL)(char *);
+
+		/** @brief Loads the library exporting virtCallDLL, asks it for its
+			version with virtAPIVersion() and picks the function table of
+			the newest supported version that is not newer.
+
+			Call once at startup, from one thread, before anything else
+			in this header: the table is not synchronized.
+
+			@param library Shared library to load (the vendor's, or the mock).
+			@param dll If not NULL, passed to the library's virtLoadDLL()
+			first, for libraries that in turn load the device DLL.
+			@returns true on success, otherwise see loadError().
+		*/
+		static bool load(const char * library, const char * dll = NULL);
+
+		static bool isLoaded() {
+			return _table().call != NULL;
+		}
+
+		/// @brief Version reported by the library, major * 1000 + minor, or 0.
+		static int apiVersion() {
+			return _table().apiVersion;
+		}
+
+		/// @brief Version whose function table is used, which is
+		/// apiVersion() unless that version is not known to this header.
+		static int tableVersion() {
+			return _table().tableVersion;
+		}
+
+		/// @brief Whether the loaded version has a function.
+		static bool has(vpp_runtime::Function fn) {
+			return _table().slots[fn] != 0;
+		}
+
+		/// @brief Why the last load() failed.
+		static std::string const& loadError() {
+			return _loadError();
+		}
+
+		/// @brief Calls a function returning int.
+		template<typename... Args>
+		static int call(vpp_runtime::Function fn, Args... args) {
+			Table const& t = _table();
+			int slot = t.slots[fn];
+			if (slot == 0 || (fn == vpp_runtime::GETERRORCODE && _pendingError() != VIRT_E_NO_ERROR)) {
+				return _absent(fn);
+			}
+			return t.call(slot - 1, args...);
+		}
+
+		/// @brief Calls a function returning a pointer through virtCallDLL.
+		template<typename... Args>
+		static void * callPointer(vpp_runtime::Function fn, Args... args) {
+			Table const& t = _table();
+			int slot = t.slots[fn];
+			if (slot == 0) {
+				_absent(fn);
+				return NULL;
+			}
+			if (t.wideCall) {
+				return reinterpret_cast<void *>(t.wideCall(slot - 1, args...));
+			}
+			return reinterpret_cast<void *>(static_cast<std::intptr_t>(t.call(slot - 1, args...)));
+		}
+
+	private:
+		struct Table {
+			CallDLL call;
+			/// The same function, if its return value is wide enough for
+			/// pointers, otherwise NULL.
+			WideCallDLL wideCall;
+			int apiVersion;
+			int tableVersion;
+			/// 0 if absent, else the version's virtDLLFunction value plus one,
+			/// so the zero-initialized table means "nothing loaded".
+			short slots[vpp_runtime::FUNCTION_COUNT];
+		};
+
+		static Table & _table() {
+			static Table table;
+			return table;
+		}
+
+		/// @brief Error of the last call this thread made to a missing
+		/// function, reported by the next virtGetErrorCode().
+		static int & _pendingError() {
+			static thread_local int error = VIRT_E_NO_ERROR;
+			return error;
+		}
+
+		static int _absent(vpp_runtime::Function fn) {
+			if (fn == vpp_runtime::GETERRORCODE) {
+				int error = _pendingError();
+				_pendingError() = VIRT_E_NO_ERROR;
+				if (error == VIRT_E_NO_ERROR && !isLoaded()) {
+					error = VIRT_E_VIRTUOSE_DLL_NOT_FOUND;
+				}
+				return error;
+			}
+			_pendingError() = isLoaded() ? VIRT_E_NOT_IMPLEMENTED : VIRT_E_VIRTUOSE_DLL_NOT_FOUND;
+			return -1;
+		}
+
+		static std::string & _loadError() {
+			static std::string error;
+			return error;
+		}
+
+		static bool _fail(std::string const& why) {
+			_loadError() = why;
+			return false;
+		}
+
+		template<typename F>
+		static F _symbol(void * library, const char * name) {
+#if defined(_WIN32)
+			return reinterpret_cast<F>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+			return reinterpret_cast<F>(dlsym(library, name));
+#endif
+		}
+};
+
+inline bool VirtuoseRuntime::load(const char * library, const char * dll) {
+#if defined(_WIN32)
+	void * handle = LoadLibraryA(library);
+	if (!handle) {
+		return _fail(std::string("Could not load ") + library);
+	}
+#else
+	void * handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+	if (!handle) {
+		return _fail(std::string("Could not load ") + library + ": " + dlerror());
+	}
+#endif
+	CallDLL callDLL = _symbol<CallDLL>(handle, "virtCallDLL");
+	if (!callDLL) {
+		return _fail(std::string(library) + " does not export virtCallDLL");
+	}
+	if (dll) {
+		LoadDLL loadDLL = _symbol<LoadDLL>(handle, "virtLoadDLL");
+		if (!loadDLL) {
+			return _fail(std::string(library) + " does not export virtLoadDLL");
+		}
+		if (loadDLL(const_cast<char *>(dll)) != 0) {
+			return _fail(std::string("virtLoadDLL failed for ") + dll);
+		}
+	}
+
+	// APIVERSION is function 0 in every supported version.
+	int major = 0;
+	int minor = 0;
+	if (callDLL(0, &major, &minor) != 0) {
+		return _fail("virtAPIVersion failed");
+	}
+	int version = major * 1000 + minor;
+
+	vpp_runtime::VersionTable const * match = NULL;
+	for (int i = 0; i < vpp_runtime::VERSION_TABLE_COUNT; ++i) {
+		if (vpp_runtime::versionTables()[i].version <= version) {
+			match = &vpp_runtime::versionTables()[i];
+		}
+	}
+	if (!match) {
+		std::ostringstream s;
+		s << "VirtuoseAPI " << major << "." << minor << " is older than any supported version";
+		return _fail(s.str());
+	}
+
+	Table & t = _table();
+	for (int i = 0; i < vpp_runtime::FUNCTION_COUNT; ++i) {
+		t.slots[i] = static_cast<short>(match->functions[i] + 1);
+	}
+	t.wideCall = match->wideReturn ? _symbol<WideCallDLL>(handle, "virtCallDLL") : NULL;
+	t.apiVersion = version;
+	t.tableVersion = match->version;
+	t.call = callDLL;
+	return true;
+}
+
+/* RUNTIME FUNCTIONS GO HERE */
+
+#endif // INCLUDED_virtuoseAPI_runtime_h_GUID_3e9a7c41_52d8_4b6f_a1c0_8d4e2f7b9a15
@@ -20,15 +20,31 @@ import sys
 import os
 import string
 import re
+import hashlib
+import tempfile
+import time
+import multiprocessing
+try:
+	import cPickle as pickle
+except ImportError:
+	import pickle
+import pycparser
 from pycparser import c_parser, c_ast, parse_file, c_generator
 
 defaultapifilenames = ['virtuoseAPI.h', 'VirtuoseAPI.h']
 
 structtype = ["VirtContext"]
-apicallqualifier = ""; #"_VAPI::"
+apicallqualifier = "Backend::"
 manuallywrapped = ("virtOpen", "virtClose", "virtGetErrorMessage")
 
-classname = "Virtuose"
+classname = "BasicVirtuoseMethods<Backend>"
+classtemplate = "template<typename Backend>"
+backendname = "VirtuoseAPIBackend"
+# Backend functions written by hand in the boilerplate.
+manualbackend = ("virtOpen",)
+# Methods written by hand in the boilerplate that VPP_PROFILE and VPP_TRACE
+# also time, and the ticks of periodic functions set by BasicVirtuose.
+manualprofiled = ("readState", "writeCommand", "periodicTick")
 argTrans = {	'fichier':		'fh',
 				'intensite':	'intensity',
 				'clic_gauche':'left_click',
@@ -51,10 +67,51 @@ methodTrans = { 'GetControlerVersion' : 'GetControllerVersion',
                 'SetArticularSpeedOfAdditionalAxe' : 'SetArticularSpeedOfAdditionalAxis',
 }
 
+# Getters taking a single unsized float* out-parameter that also get an
+# overload returning the corresponding fixed-size value type.
+valueGetters = { 'virtGetPosition' : 'VirtuoseDisplacement',
+                 'virtGetAvatarPosition' : 'VirtuoseDisplacement',
+                 'virtGetPhysicalPosition' : 'VirtuoseDisplacement',
+                 'virtGetBaseFrame' : 'VirtuoseDisplacement',
+                 'virtGetObservationFrame' : 'VirtuoseDisplacement',
+                 'virtGetCatchFrame' : 'VirtuoseDisplacement',
+                 'virtVmGetBaseFrame' : 'VirtuoseDisplacement',
+                 'virtGetSpeed' : 'VirtuoseTwist',
+                 'virtGetPhysicalSpeed' : 'VirtuoseTwist',
+                 'virtGetForce' : 'VirtuoseWrench',
+                 'virtGetArticularPosition' : 'VirtuoseArticularVector',
+                 'virtGetArticularSpeed' : 'VirtuoseArticularVector',
+}
+
+# Hot functions that VirtuoseAPIBackend dispatches to the library's
+# direct entry point when VPP_DIRECT_DISPATCH is defined and the library
+# provides one, instead of the variadic virtCallDLL.
+directDispatch = ( 'virtGetPosition',
+                   'virtGetSpeed',
+                   'virtGetForce',
+                   'virtSetPosition',
+                   'virtSetSpeed',
+                   'virtSetForce',
+                   'virtGetButton',
+                   'virtGetDeadMan',
+                   'virtGetEmergencyStop',
+                   'virtGetPowerOn',
+                   'virtGetTimeLastUpdate',
+)
+
 bpfilename = "vpp-boilerplate.h"
 classmarker = "/* CLASS BODY GOES HERE */"
+backendmarker = "/* BACKEND DECLARATIONS GO HERE */"
 implmarker = "/* IMPLEMENTATION BODY GOES HERE */"
+profilemarker = "/* PROFILE METHODS GO HERE */"
 includeplaceholder = "UPSTREAM_INCLUDE_FILENAME"
+runtimebpfilename = "vpp-runtime-boilerplate.h"
+runtimeincludefilename = "virtuoseAPI-runtime.h"
+runtimeenummarker = "/* FUNCTION ENUM GOES HERE */"
+runtimetablemarker = "/* VERSION TABLES GO HERE */"
+runtimefunctionmarker = "/* RUNTIME FUNCTIONS GO HERE */"
+newestincludeplaceholder = "NEWEST_UPSTREAM_INCLUDE_GOES_HERE"
+tablecountplaceholder = "VERSION_TABLE_COUNT_GOES_HERE"
 versionplaceholder = "UPSTREAM_VERSION_GOES_HERE"
 intversionplaceholder = "UPSTREAM_INTEGER_VERSION_GOES_HERE"
 
@@ -64,6 +121,13 @@ virtcontextmember = "vc_"
 defaultoutputfilename = 'vpp.h'
 verbose = False
 
+# Parsed API models are cached here, keyed by the content of the input
+# header and of this script, so unchanged headers aren't preprocessed and
+# parsed again. Set VPP_GENERATOR_CACHE to use another directory (e.g. one
+# a CI system persists), or to an empty string to disable the cache.
+cachedir = os.environ.get("VPP_GENERATOR_CACHE",
+	os.path.join(os.path.dirname(os.path.abspath(__file__)), "build", "generator-cache"))
+
 translateArg = lambda x: argTrans.get(x, x)
 translateMethod = lambda x: methodTrans.get(x, x)
 
@@ -77,6 +141,61 @@ def getVersionStringFromHeader(fn):
 	else:
 		return "Unknown"
 
+# One parser for every header parsed by this process: building it loads
+# the lexer and parser tables (pycparser/lextab.py and yacctab.py).
+sharedParser = None
+
+def getParser():
+	global sharedParser
+	if sharedParser is None:
+		sharedParser = c_parser.CParser()
+	return sharedParser
+
+def getModelCacheFilename(fn):
+	"""Returns where the parsed model of a header is cached, or None if
+	caching is disabled."""
+	if not cachedir:
+		return None
+	h = hashlib.sha1()
+	# Pickles refer to this script's classes by module name, which
+	# differs when it is imported (e.g. by list_functions.py).
+	h.update(sys.version + pycparser.__version__ + __name__)
+	for source in (fn, os.path.splitext(os.path.abspath(__file__))[0] + ".py"):
+		f = open(source, 'rb')
+		h.update(f.read())
+		f.close()
+	return os.path.join(cachedir, h.hexdigest() + ".pickle")
+
+def loadCachedModel(fn):
+	cachefile = getModelCacheFilename(fn)
+	if cachefile is None or not os.path.exists(cachefile):
+		return None
+	try:
+		f = open(cachefile, 'rb')
+		try:
+			return pickle.load(f)
+		finally:
+			f.close()
+	except Exception:
+		# Unreadable, or pickled by an incompatible entry point: parse again.
+		return None
+
+def storeCachedModel(fn, model):
+	cachefile = getModelCacheFilename(fn)
+	if cachefile is None:
+		return
+	try:
+		if not os.path.isdir(cachedir):
+			os.makedirs(cachedir)
+		# Write then rename, so a concurrent run never reads a partial file.
+		(fd, tmpname) = tempfile.mkstemp(dir = cachedir)
+		f = os.fdopen(fd, 'wb')
+		pickle.dump(model, f, 2)
+		f.close()
+		os.rename(tmpname, cachefile)
+	except (IOError, OSError):
+		pass
+
 def debugPrint(*args):
 	if verbose:
 		print(args)
@@ -232,6 +351,61 @@ class IsStaticVisitor(c_ast.NodeVisitor):
 		if node.names == structtype:
 			self.isStatic = False
 
+class DLLFunctionVisitor(c_ast.NodeVisitor):
+	"""Call on a FuncDef: finds the virtDLLFunction its body passes to virtCallDLL."""
+	def __init__(self, funcdef):
+		self.dllFunction = None
+		self.dllArgs = []
+		self.visit(funcdef.body)
+
+	def visit_FuncCall(self, node):
+		if isinstance(node.name, c_ast.ID) and node.name.name == "virtCallDLL":
+			first = node.args.exprs[0]
+			if isinstance(first, c_ast.ID):
+				self.dllFunction = first.name
+				# The remaining arguments, as passed, with the same
+				# argument name translations as the declaration.
+				generator = c_generator.CGenerator()
+				self.dllArgs = [re.sub(r'\b\w+\b', lambda m: translateArg(m.group(0)), generator.visit(x)) for x in node.args.exprs[1:]]
+		self.generic_visit(node)
+
+class TypeNamesVisitor(c_ast.NodeVisitor):
+	"""Collects the type names used in a declaration."""
+	def __init__(self, node):
+		self.names = set()
+		self.visit(node)
+
+	def visit_IdentifierType(self, node):
+		self.names.update(node.names)
+
+class DLLFunctionEnumVisitor(c_ast.NodeVisitor):
+	"""Call on a file AST: collects the (name, value) pairs of the
+	virtDLLFunction enum, the return type of virtCallDLL and the names
+	of all typedefs."""
+	def __init__(self, ast):
+		self.functions = []
+		self.callReturnType = None
+		self.typedefs = set()
+		self.visit(ast)
+
+	def visit_Typedef(self, node):
+		self.typedefs.add(node.name)
+		if node.name == "virtDLLFunction" and isinstance(node.type.type, c_ast.Enum):
+			value = -1
+			for enumerator in node.type.type.values.enumerators:
+				if enumerator.value is not None:
+					value = int(enumerator.value.value, 0)
+				else:
+					value += 1
+				self.functions.append((enumerator.name, value))
+
+	def visit_Decl(self, node):
+		if node.name == "virtCallDLL":
+			retType = TypeVisitor()
+			retType.visit(node.type.type)
+			self.callReturnType = retType.getTypeOnly()
+		self.generic_visit(node)
+
 class Method:
 	def __init__(self, node):
 		debugPrint("-------------------------")
@@ -245,13 +419,18 @@ class Method:
 		self.name = node.decl.name
 		self.methodName = renameFunctionToMethod(self.name)
 		self.location = node.decl.coord
+		self.typeNames = TypeNamesVisitor(node.decl.type).names
+		dllvisit = DLLFunctionVisitor(node)
+		self.dllFunction = dllvisit.dllFunction
+		self.dllArgs = dllvisit.dllArgs
 		self.args = []
 		for c_name, arg in node.decl.type.args.children():
 			self.args.append(TypeWrapper(arg))
 
+		self.contextName = None
 		if not self.static:
 			# Drop the VC parameter
-			self.args.pop(0)
+			self.contextName = self.args.pop(0).getNameOnly()
 
 		retType = TypeVisitor()
 		retType.visit(node.decl.type.type)
@@ -260,8 +439,11 @@ class Method:
 	def explain(self):
 		print('%s: %s returns %s, takes:' % (context.location, context.name, context.retType))
 
-	def callWrappedFunction(self):
-		forwardCall = apicallqualifier + self.name + "("
+	def hasDispatcher(self):
+		return self.name in directDispatch and self.dllFunction is not None and not self.static
+
+	def callWrappedFunction(self, qualifier = apicallqualifier):
+		forwardCall = qualifier + self.name + "("
 
 		callargs = []
 		if not self.static:
@@ -272,6 +454,10 @@ class Method:
 		forwardCall += ")"
 		return forwardCall
 
+	def callProfiledFunction(self):
+		"""The call, timed under this method's name when VPP_PROFILE is defined."""
+		return "VPP_PROFILE_CALL(" + self.methodName + ", " + self.callWrappedFunction() + ")"
+
 	def generateWrapper(self):
 		# Static designation if needed
 		if self.static:
@@ -298,18 +484,76 @@ class Method:
 		# Basic implementation - call original function
 
 		body = ""
-		if returntype == "int" and not self.static:
-			# Convert return codes into exceptions
+		if self.isChecked():
+			# Convert return codes into exceptions or VirtuoseResult,
+			# depending on the error mode. The call is made outside of
+			# any macro, so it happens in every mode.
+			returntype = "VirtuoseStatus"
 			body = """
-			int ret;
-			VPP_CHECKED_CALL(ret = """ + self.callWrappedFunction() + """);
-			return ret;"""
+			int ret = """ + self.callProfiledFunction() + """;
+			VPP_CHECK_RETURN(ret, \"""" + self.callWrappedFunction("") + """\");
+			return VPP_STATUS(ret);"""
 		else:
 			# Doesn't return a return code.
-			body = "return " + self.callWrappedFunction() + ";"
+			body = "return " + self.callProfiledFunction() + ";"
 
 		return (qualifiers, returntype, declaration, body)
 
+	def generateBackendFunction(self):
+		"""Returns VirtuoseAPIBackend's static function forwarding to this
+		function. For the hot functions, it calls the library's direct
+		entry point instead if there is one."""
+		params = [x.getFullType() for x in self.args]
+		argnames = [x.getNameOnly() for x in self.args]
+		if not self.static:
+			params.insert(0, "VirtContext " + self.contextName)
+			argnames.insert(0, self.contextName)
+		argnames = ", ".join(argnames)
+		declaration = self.name + "(" + ", ".join(params) + ")"
+		body = ""
+		if self.hasDispatcher():
+			body += "#ifdef VPP_DIRECT_DISPATCH\n"
+			body += "\ttypedef " + self.retType + " (*EntryPoint)(" + ", ".join(params) + ");\n"
+			body += "\tEntryPoint direct = reinterpret_cast<EntryPoint>(_entryPoints()[" + self.dllFunction + "]);\n"
+			body += "\tif (direct) {\n\t\treturn direct(" + argnames + ");\n\t}\n"
+			body += "#endif\n"
+		body += "\treturn ::" + self.name + "(" + argnames + ");"
+		return ("static", self.retType, declaration, body)
+
+	def isChecked(self):
+		"""True if the return value is an error code to check."""
+		return self.retType == "int" and not self.static
+
+	def tryMethodName(self):
+		return "try" + self.methodName[0].upper() + self.methodName[1:]
+
+	def generateTryWrapper(self):
+		"""Returns the variant that always reports errors through a
+		VirtuoseResult, whatever the error mode, or None if the method
+		has no error code to report."""
+		if not self.isChecked():
+			return None
+
+		declaration = self.tryMethodName() + "(" + ", ".join([x.getFullType() for x in self.args]) + ")"
+		body = "return _result(" + self.callProfiledFunction() + ");"
+		return ("", "VirtuoseResult", declaration, body)
+
+	def generateValueWrapper(self, tryVariant = False):
+		"""Returns the by-value overload of a getter, or None if there isn't one."""
+		valuetype = valueGetters.get(self.name)
+		if valuetype is None or self.static or len(self.args) != 1:
+			return None
+
+		if tryVariant:
+			name = self.tryMethodName()
+			returntype = "VirtuoseExpected<" + valuetype + ">"
+		else:
+			name = self.methodName
+			returntype = "VirtuoseValue<" + valuetype + ">::type"
+		declaration = name + "()"
+		body = returntype + " ret;\n\t_setStatus(ret, " + name + "(ret.data));\n\treturn ret;"
+		return ("", returntype, declaration, body)
+
 class AccumulateFuncDefsAsMethods(c_ast.NodeVisitor):
 	def __init__(self):
 		self.methods = []
@@ -324,6 +568,9 @@ class VirtuoseAPI:
 		self.filename = fn
 		self.apiVersion = getVersionStringFromHeader(self.filename)
 		self.methods = None
+		self.dllFunctions = None
+		self.callReturnType = None
+		self.typedefs = None
 		self.wrapped_methods = None
 
 	def getApiVersion(self):
@@ -335,39 +582,81 @@ class VirtuoseAPI:
 				[int(x) for x in self.getApiVersion().split(".")]
 			)
 
+	def getModel(self):
+		"""Returns everything parsed from the header, for caching or for
+		handing to another process."""
+		return (self.getMethods(), self.dllFunctions, self.callReturnType, self.typedefs)
+
+	def setModel(self, model):
+		(self.methods, self.dllFunctions, self.callReturnType, self.typedefs) = model
+
 	def parseFile(self):
-		ast = parse_file(self.filename, use_cpp=True, cpp_args=r'-Iutils/fake_libc_include')
+		"""Parses the header, or loads its model from the cache.
+		Returns True if it came from the cache."""
+		model = loadCachedModel(self.filename)
+		if model is not None:
+			self.setModel(model)
+			return True
+
+		ast = parse_file(self.filename, use_cpp=True, cpp_args=r'-Iutils/fake_libc_include', parser=getParser())
 
 		v = AccumulateFuncDefsAsMethods()
 		v.visit(ast)
 		self.methods = v.methods
 
+		enumvisit = DLLFunctionEnumVisitor(ast)
+		self.dllFunctions = enumvisit.functions
+		self.callReturnType = enumvisit.callReturnType
+		self.typedefs = enumvisit.typedefs
+
+		storeCachedModel(self.filename, self.getModel())
+		return False
+
 	def getMethods(self):
 		if self.methods is None:
 			self.parseFile()
 		return self.methods
 
+	def getTypedefs(self):
+		"""Returns the names of all types declared with typedef."""
+		if self.typedefs is None:
+			self.parseFile()
+		return self.typedefs
+
+	def getDLLFunctions(self):
+		"""Returns the (name, value) pairs of the virtDLLFunction enum."""
+		if self.dllFunctions is None:
+			self.parseFile()
+		return self.dllFunctions
+
+	def getCallReturnType(self):
+		"""Returns the declared return type of virtCallDLL."""
+		if self.callReturnType is None:
+			self.parseFile()
+		return self.callReturnType
+
+	def getBackendFunctions(self):
+		return [method.generateBackendFunction() for method in self.getMethods() if method.name not in manualbackend]
+
+	def getProfiledMethods(self):
+		"""The names VPP_PROFILE keeps counters under."""
+		return [method.methodName for method in self.getMethods() if method.name not in manuallywrapped] + list(manualprofiled)
+
 	def getWrappedMethods(self):
 		if self.wrapped_methods is None:
-			self.wrapped_methods = [ method.generateWrapper() for method in self.getMethods() if method.name not in manuallywrapped]
+			self.wrapped_methods = []
+			for method in self.getMethods():
+				if method.name in manuallywrapped:
+					continue
+				self.wrapped_methods.append(method.generateWrapper())
+				wrappers = [method.generateTryWrapper(),
+					method.generateValueWrapper(),
+					method.generateValueWrapper(tryVariant = True)]
+				self.wrapped_methods.extend([x for x in wrappers if x is not None])
 		return self.wrapped_methods
 
-def wrap_virtuose_api(filenames):
-		# Note that cpp is used. Provide a path to your own cpp or
-		# make sure one exists in PATH.
-		#
-		filename = None
-		for fn in filenames:
-			if os.path.exists(fn):
-				filename = fn
-				break
-		if filename is None:
-			print("Cannot continue: no valid input file found!")
-			os.exit()
-
-		API = VirtuoseAPI(filename)
-		apiVer = API.getApiVersion()
-
+def generate_wrapper(API, includefilename, versiontext):
+		"""Returns the wrapper header for an API, from the boilerplate."""
 		intVer = str(API.getApiVersionInteger())
 
 		# Combined declaration and definition.
@@ -381,28 +670,239 @@ def wrap_virtuose_api(filenames):
 		classlines.extend([ " ".join([qualifiers, returntype, declaration + ";"]) for (qualifiers, returntype, declaration, body) in API.getWrappedMethods() if not qualifiers == ""])
 
 		classbody = "\n\t\t".join(classlines)
-		impllines = ["/* Wrapper Implementation Details Follow */"]
-		impllines.extend([ " ".join(["inline", returntype, classname+"::"+declaration, "{\n\t" + body + "\n}"]) for (qualifiers, returntype, declaration, body) in API.getWrappedMethods()])
+		backendbody = "\n\t".join([ " ".join([qualifiers, returntype, declaration + ";"]) for (qualifiers, returntype, declaration, body) in API.getBackendFunctions()])
+		impllines = ["/* Backend Implementation Details Follow */"]
+		impllines.extend([ " ".join(["inline", returntype, backendname+"::"+declaration, "{\n" + body + "\n}"]) for (qualifiers, returntype, declaration, body) in API.getBackendFunctions()])
+		impllines.append("/* Wrapper Implementation Details Follow */")
+		impllines.extend([ classtemplate + "\n" + " ".join(["inline", returntype, classname+"::"+declaration, "{\n\t" + body + "\n}"]) for (qualifiers, returntype, declaration, body) in API.getWrappedMethods()])
 		implbody = "\n\n".join(impllines)
 
+		profiled = API.getProfiledMethods()
+		profilebody = "enum Method {\n\t\t" + ",\n\t\t".join(profiled + ["methodCount"]) + "\n\t};\n\n"
+		profilebody += "\tinline const char * methodName(int method) {\n\t\tstatic const char * const names[] = {\n\t\t\t"
+		profilebody += ",\n\t\t\t".join(['"' + name + '"' for name in profiled]) + "\n\t\t};\n\t\treturn names[method];\n\t}"
+
 		boilerplatefile = open(bpfilename, 'r')
-		boilerplate = boilerplatefile.read().replace(includeplaceholder, os.path.basename(filename)).replace(versionplaceholder, apiVer).replace(intversionplaceholder, intVer)
+		boilerplate = boilerplatefile.read().replace(includeplaceholder, includefilename).replace(versionplaceholder, versiontext).replace(intversionplaceholder, intVer)
 		boilerplatefile.close()
 
 
-		classidx = boilerplate.find(classmarker)
-		implidx = boilerplate.find(implmarker)
-
-		if classidx != -1 and implidx != -1:
-			fullfile = boilerplate[:classidx] + classbody + boilerplate[classidx+len(classmarker):implidx] + implbody + boilerplate[implidx+len(implmarker):]
+		if all([boilerplate.find(marker) != -1 for marker in (classmarker, backendmarker, implmarker, profilemarker)]):
+			fullfile = boilerplate.replace(classmarker, classbody).replace(backendmarker, backendbody).replace(implmarker, implbody).replace(profilemarker, profilebody)
 		else:
 			print("COULD NOT FIND PLACEHOLDER!")
 			fullfile = None
 
-		return fullfile, apiVer
+		return fullfile
+
+def wrap_virtuose_api(filenames):
+		# Note that cpp is used. Provide a path to your own cpp or
+		# make sure one exists in PATH.
+		#
+		filename = None
+		for fn in filenames:
+			if os.path.exists(fn):
+				filename = fn
+				break
+		if filename is None:
+			print("Cannot continue: no valid input file found!")
+			os.exit()
+
+		API = VirtuoseAPI(filename)
+		apiVer = API.getApiVersion()
+
+		return generate_wrapper(API, os.path.basename(filename), apiVer), apiVer
+
+class UnionVirtuoseAPI(VirtuoseAPI):
+	"""The functions of several VirtuoseAPI versions together, for the
+	runtime-loaded backend. Where a function exists in several versions,
+	the newest one's declaration is used. Functions using a type that the
+	newest version no longer declares are left out, since the runtime
+	backend only includes the newest header."""
+	def __init__(self, apis):
+		self.apis = sorted(apis, key = lambda api: api.getApiVersionInteger())
+		self.newest = self.apis[-1]
+		self.methods = None
+		self.wrapped_methods = None
+
+	def getApiVersion(self):
+		return self.newest.getApiVersion()
+
+	def getVersionRange(self):
+		return self.apis[0].getApiVersion() + " to " + self.newest.getApiVersion()
+
+	def getMethods(self):
+		if self.methods is None:
+			byName = {}
+			leftOut = {}
+			newestTypes = self.newest.getTypedefs()
+			for api in self.apis:
+				removedTypes = api.getTypedefs() - newestTypes
+				for method in api.getMethods():
+					if method.typeNames & removedTypes:
+						leftOut[method.name] = method.typeNames & removedTypes
+					else:
+						byName[method.name] = method
+			for name in sorted(leftOut.keys()):
+				if name not in byName:
+					print("Leaving out %s: %s is not declared by version %s" % (name, ", ".join(sorted(leftOut[name])), self.newest.getApiVersion()))
+			self.methods = [byName[name] for name in sorted(byName.keys())]
+		return self.methods
+
+	def getFunctionNames(self):
+		"""The virtDLLFunction names used by any version, in enum order."""
+		used = set([method.dllFunction for method in self.getMethods() if method.dllFunction is not None])
+		names = []
+		for api in self.apis:
+			for (name, value) in api.getDLLFunctions():
+				if name in used and name not in names:
+					names.append(name)
+		return names
+
+	def getVersionTable(self, api):
+		"""For each function name, the value of that version's
+		virtDLLFunction if the version has a function using it, or -1."""
+		values = dict(api.getDLLFunctions())
+		present = set([method.dllFunction for method in api.getMethods()])
+		return [values[name] if name in present else -1 for name in self.getFunctionNames()]
+
+def generate_runtime_compat_function(method):
+	"""Returns the runtime stand-in for one of the vendor's inline functions."""
+	params = [x.getFullType() for x in method.args]
+	if not method.static:
+		params.insert(0, "VirtContext " + method.contextName)
+	callargs = ", ".join(["vpp_runtime::" + method.dllFunction] + method.dllArgs)
+	if "*" in method.retType or method.retType in structtype:
+		call = "(" + method.retType + ")VirtuoseRuntime::callPointer(" + callargs + ")"
+	else:
+		call = "VirtuoseRuntime::call(" + callargs + ")"
+	return "inline " + method.retType + " " + method.name + "(" + ", ".join(params) + ") {\n\treturn " + call + ";\n}"
+
+def wrap_virtuose_api_runtime(filenames, outdir):
+		"""Generates the runtime-loaded backend header and its wrapper
+		from the headers of every supported version."""
+		return generate_runtime([VirtuoseAPI(fn) for fn in filenames], outdir)
+
+def generate_runtime(apis, outdir):
+		"""Returns the (filename, contents) of the runtime-loaded backend
+		header and its wrapper, from the APIs of every supported version."""
+		API = UnionVirtuoseAPI(apis)
+		for api in API.apis:
+			if dict(api.getDLLFunctions()).get("APIVERSION") != 0:
+				print("Cannot continue: APIVERSION must be 0 in every version to detect the version at load time")
+				sys.exit(1)
+
+		names = API.getFunctionNames()
+		enumbody = "\n\t\t".join([name + "," for name in names])
+
+		tablelines = []
+		for api in API.apis:
+			tablelines.append("{ %d, %s, { %s } }" % (api.getApiVersionInteger(),
+				"true" if api.getCallReturnType() != "int" else "false",
+				", ".join([str(x) for x in API.getVersionTable(api)])))
+		tablebody = ",\n\t\t\t".join(tablelines)
+
+		functionsbody = "\n\n".join([generate_runtime_compat_function(method) for method in API.getMethods() if method.dllFunction is not None])
+
+		newestinclude = os.path.relpath(API.newest.filename, outdir).replace(os.sep, "/")
+
+		boilerplatefile = open(runtimebpfilename, 'r')
+		boilerplate = boilerplatefile.read().replace(versionplaceholder, API.getVersionRange()).replace(newestincludeplaceholder, newestinclude).replace(tablecountplaceholder, str(len(API.apis)))
+		boilerplatefile.close()
+
+		if not all([boilerplate.find(marker) != -1 for marker in (runtimeenummarker, runtimetablemarker, runtimefunctionmarker)]):
+			print("COULD NOT FIND PLACEHOLDER!")
+			sys.exit(1)
+		compat = boilerplate.replace(runtimeenummarker, enumbody).replace(runtimetablemarker, tablebody).replace(runtimefunctionmarker, functionsbody)
+
+		wrapper = generate_wrapper(API, runtimeincludefilename, API.getVersionRange() + " (runtime-loaded)")
+		return [(os.path.join(outdir, runtimeincludefilename), compat), (os.path.join(outdir, defaultoutputfilename), wrapper)]
+
+def parse_header(fn):
+		"""Parses one header, for wrap_all's worker processes: returns the
+		model, whether it was cached, and the seconds taken."""
+		start = time.time()
+		API = VirtuoseAPI(fn)
+		cached = API.parseFile()
+		return (API.getModel(), cached, time.time() - start)
+
+def wrap_all(filenames, runtimedir = None, jobs = None):
+		"""Generates the vpp.h next to each header, and optionally the
+		runtime-loaded backend in runtimedir, in one process. Headers that
+		aren't cached are parsed concurrently, by forked workers sharing
+		an already-built parser. Returns the (filename, contents) to write."""
+		start = time.time()
+		misses = [fn for fn in filenames if not os.path.exists(getModelCacheFilename(fn) or "")]
+		if jobs is None:
+			jobs = multiprocessing.cpu_count()
+		jobs = max(1, min(jobs, len(misses)))
+		if misses:
+			getParser()
+		warmed = time.time()
+
+		if jobs > 1:
+			pool = multiprocessing.Pool(jobs)
+			results = pool.map(parse_header, filenames)
+			pool.close()
+			pool.join()
+		else:
+			results = [parse_header(fn) for fn in filenames]
+		parsed = time.time()
+
+		apis = []
+		for (fn, (model, cached, seconds)) in zip(filenames, results):
+			API = VirtuoseAPI(fn)
+			API.setModel(model)
+			apis.append(API)
+			print("%-24s %s in %.3f s" % (fn, "loaded from cache" if cached else "parsed", seconds))
+
+		outputs = []
+		for API in apis:
+			outputs.append((os.path.join(os.path.dirname(API.filename), defaultoutputfilename),
+				generate_wrapper(API, os.path.basename(API.filename), API.getApiVersion())))
+		if runtimedir is not None:
+			outputs.extend(generate_runtime(apis, runtimedir))
+		end = time.time()
+
+		print("Parser set-up %.3f s, parsing %.3f s (%.3f s of work, %d job%s), generating %.3f s, total %.3f s" % (
+			warmed - start, parsed - warmed, sum([r[2] for r in results]), jobs, "s" if jobs > 1 else "",
+			end - parsed, end - start))
+		return outputs
 
 
 if __name__ == "__main__":
+	if len(sys.argv) > 1 and sys.argv[1] == "--all":
+		# --all [-jN] [--runtime OUTDIR] HEADER...: vpp.h next to every
+		# header, and optionally the runtime-loaded backend, in one process
+		args = sys.argv[2:]
+		jobs = None
+		runtimedir = None
+		while args and args[0].startswith("-"):
+			if args[0].startswith("-j"):
+				jobs = int(args[0][2:])
+				args = args[1:]
+			elif args[0] == "--runtime" and len(args) > 1:
+				runtimedir = args[1]
+				args = args[2:]
+			else:
+				print("Unknown option", args[0])
+				sys.exit(1)
+		for (outfile, output) in wrap_all(args, runtimedir, jobs):
+			print("Writing to file ", outfile)
+			out = open(outfile, 'w')
+			out.write(output)
+			out.close()
+		sys.exit(0)
+
+	if len(sys.argv) > 2 and sys.argv[1] == "--runtime":
+		# --runtime OUTDIR HEADER...: the runtime-loaded backend, from every version
+		for (outfile, output) in wrap_virtuose_api_runtime(sys.argv[3:], sys.argv[2]):
+			print("Writing to file ", outfile)
+			out = open(outfile, 'w')
+			out.write(output)
+			out.close()
+		sys.exit(0)
+
 	if len(sys.argv) > 1:
 		filenames  = [sys.argv[1]]
 		if len(sys.argv) > 2: